@@ -0,0 +1,229 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      EventQueueBench.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    Measures the push/pop throughput of the event queues with
+//					a hold model, against a copy of the comparator that
+//					the heap used before the events had an ordering key.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Hold model benchmark of the event queues.
+//
+// ____________________________________________________________________________
+
+#include "CalendarQueue.h"
+#include "CpuAffinity.h"
+#include "EventQueue.h"
+#include "JobScheduler.h"
+#include "Thread.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+// The simulator keeps these in Main.cpp.
+Thread *threadZero = nullptr;
+Thread **threads = nullptr;
+
+JobScheduler scheduler;
+
+CpuAffinity affinity;
+
+namespace {
+
+// The event and the comparator of the heap before the ordering key, which
+// looked at the payload to break a tie.
+struct LegacyEvent {
+  EventType e_type;
+  double e_time;
+  void *e_data;
+};
+
+bool operator<(const LegacyEvent &event1, const LegacyEvent &event2) {
+  if (event1.e_time != event2.e_time) {
+    return event1.e_time > event2.e_time;
+  } else if (event1.e_type == event2.e_type) {
+    if (event1.e_type == CONNECTION_REQUEST) {
+      ConnectionRequestEvent *cre1 =
+          static_cast<ConnectionRequestEvent *>(event1.e_data);
+      ConnectionRequestEvent *cre2 =
+          static_cast<ConnectionRequestEvent *>(event2.e_data);
+
+      return cre1->session > cre2->session;
+    } else {
+      CreateConnectionProbeEvent *ccp1 =
+          static_cast<CreateConnectionProbeEvent *>(event1.e_data);
+      CreateConnectionProbeEvent *ccp2 =
+          static_cast<CreateConnectionProbeEvent *>(event2.e_data);
+
+      if (ccp1->session != ccp2->session)
+        return ccp1->session > ccp2->session;
+      else
+        return ccp1->sequence > ccp2->sequence;
+    }
+  } else {
+    return event1.e_type > event2.e_type;
+  }
+}
+
+// Wraps the legacy heap so that it runs the same hold model.
+class LegacyQueue {
+ public:
+  inline void addEvent(const Event &e) {
+    LegacyEvent l;
+    l.e_type = static_cast<EventType>(e.e_type);
+    l.e_time = e.e_time;
+    l.e_data = e.e_data.request;
+    pq.push(l);
+  }
+
+  inline Event getNextEvent() {
+    LegacyEvent l = pq.top();
+    pq.pop();
+
+    Event e;
+    e.e_type = l.e_type;
+    e.e_time = l.e_time;
+    e.e_data.request = static_cast<ConnectionRequestEvent *>(l.e_data);
+    e.e_key = 0;
+    return e;
+  }
+
+ private:
+  std::priority_queue<LegacyEvent> pq;
+};
+
+// Half of the events are connection requests and half are probes.
+struct Payloads {
+  std::vector<ConnectionRequestEvent> requests;
+  std::vector<CreateConnectionProbeEvent> probes;
+};
+
+// Every fourth event is scheduled at the time of the event that was just
+// handled, as the zero delay hops of the simulator are, when ties is set.
+template <class Queue>
+double hold(Queue &queue, Payloads &payloads, size_t pending,
+            size_t operations, bool ties) {
+  std::default_random_engine generator(12345);
+  std::exponential_distribution<double> delay(1.0);
+
+  size_t session = 0;
+
+  for (size_t n = 0; n < pending; ++n) {
+    Event e;
+
+    if (n % 2 == 0) {
+      e.e_type = CONNECTION_REQUEST;
+      e.e_data.request = &payloads.requests[n];
+      e.e_data.request->session = session++;
+    } else {
+      e.e_type = CREATE_CONNECTION_PROBE;
+      e.e_data.probe = &payloads.probes[n];
+      e.e_data.probe->session = session++;
+      e.e_data.probe->sequence = 0;
+    }
+
+    e.e_time = delay(generator);
+    e.e_key = 0;
+
+    queue.addEvent(e);
+  }
+
+  size_t checksum = 0;
+
+  // The processor time of the process, which leaves out the time the host
+  // spends running something else.
+  std::clock_t start = std::clock();
+
+  for (size_t n = 0; n < operations; ++n) {
+    Event e = queue.getNextEvent();
+
+    // The handlers always read the payload of the event.
+    if (e.e_type == CONNECTION_REQUEST) {
+      checksum += e.e_data.request->session;
+      e.e_data.request->session = session++;
+    } else {
+      checksum += e.e_data.probe->session;
+      e.e_data.probe->session = session++;
+      ++e.e_data.probe->sequence;
+    }
+
+    if (ties == false || n % 4 != 0) e.e_time += delay(generator);
+
+    queue.addEvent(e);
+  }
+
+  double elapsed = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+
+  if (checksum == 0) std::cout << "";
+
+  return static_cast<double>(operations) / elapsed / 1.0e6;
+}
+
+template <class Queue>
+double run(size_t pending, size_t operations, bool ties) {
+  Payloads payloads;
+  payloads.requests.resize(pending);
+  payloads.probes.resize(pending);
+
+  Queue *queue = new Queue();
+
+  double rate = hold(*queue, payloads, pending, operations, ties);
+
+  delete queue;
+
+  return rate;
+}
+
+}  // namespace
+
+int main(int argc, const char *argv[]) {
+  size_t pending = 50000;
+  size_t operations = 5000000;
+  size_t repeats = 5;
+
+  if (argc > 1) pending = static_cast<size_t>(atol(argv[1]));
+  if (argc > 2) operations = static_cast<size_t>(atol(argv[2]));
+  if (argc > 3) repeats = static_cast<size_t>(atol(argv[3]));
+
+  std::cout << pending << " pending events, " << operations
+            << " pop+push, best of " << repeats << std::endl;
+
+  const char *names[] = {"legacy", "heap", "calendar"};
+
+  for (int ties = 0; ties < 2; ++ties) {
+    double best[3] = {0.0, 0.0, 0.0};
+
+    // The queues take turns, so that a change in the load of the host does
+    // not favour one of them.
+    for (size_t r = 0; r < repeats; ++r) {
+      best[0] = std::max(best[0], run<LegacyQueue>(pending, operations,
+                                                   ties == 1));
+      best[1] = std::max(best[1], run<HeapEventQueue>(pending, operations,
+                                                      ties == 1));
+      best[2] = std::max(best[2], run<CalendarEventQueue>(pending, operations,
+                                                          ties == 1));
+    }
+
+    for (int q = 0; q < 3; ++q) {
+      std::cout << std::left << std::setw(10) << names[q] << std::setw(10)
+                << (ties == 1 ? "tied" : "distinct") << std::fixed
+                << std::setprecision(2) << best[q] << " M pop+push/s"
+                << std::endl;
+    }
+  }
+
+  return 0;
+}
@@ -51,12 +51,16 @@ enum WavelengthAlgorithm {
 
 enum ProbeStyle { SINGLE, SERIAL, PARALLEL, NUMBER_OF_PROBE_STYLES };
 
+class ReplicationSet;
+
 struct AlgorithmToRun {
   RoutingAlgorithm ra;
   WavelengthAlgorithm wa;
   ProbeStyle ps;
   bool qa;
   size_t workstations;
+  size_t replication;            // index of the replication, if any
+  ReplicationSet* replications;  // nullptr unless replications are enabled
 };
 
 #endif
@@ -0,0 +1,67 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      BatchMeans.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the BatchMeans, which
+//					monitors the blocking and Q-factor estimates of
+//					a run and decides when they have converged.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Batch means convergence of a run.
+//  10/18/2026  v2.1    Absolute precision for the metrics near zero.
+//
+// ____________________________________________________________________________
+
+#ifndef BATCH_MEANS_H
+#define BATCH_MEANS_H
+
+#include <cstddef>
+
+#include "Checkpoint.h"
+#include "Replications.h"
+
+// Splits a run into batches of a fixed number of connection requests and
+// treats the mean of each batch as an observation, so that the confidence
+// interval of the run can be estimated while it is still going.
+class BatchMeans {
+ public:
+  BatchMeans(size_t batchSize, size_t minBatches, double precision,
+             double absolutePrecision);
+
+  // Starts the batches from the given totals.
+  void reset(const GlobalStats& stats);
+
+  // Called after every connection request. Returns true once the relative
+  // precision of both the blocking and the Q-factor has been reached, or
+  // their half width is within the absolute precision.
+  bool update(const GlobalStats& stats);
+
+  inline size_t getNumberOfBatches() const { return blocking.getCount(); }
+
+  void saveCheckpoint(CheckpointWriter& out) const;
+  void loadCheckpoint(CheckpointReader& in);
+
+ private:
+  bool hasConverged(const RunningStat& metric) const;
+
+  size_t batchSize;
+  size_t minBatches;
+  double precision;
+  double absolutePrecision;
+
+  size_t lastRequests;
+  size_t lastSuccesses;
+  size_t lastFailures;
+  double lastQFactor;
+
+  RunningStat blocking;
+  RunningStat quality;
+};
+
+#endif
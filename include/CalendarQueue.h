@@ -0,0 +1,83 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      CalendarQueue.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the calendar queue
+//					(R. Brown, 1988) implementation of the
+//					EventQueue. Events are hashed by time into
+//					buckets of a fixed width, so that both adding
+//					and removing an event is amortised O(1).
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Calendar queue backend of the EventQueue.
+//  10/18/2026  v2.1    Next bucket kept between a peek and a pop.
+//
+// ____________________________________________________________________________
+
+#ifndef CALENDAR_QUEUE_H
+#define CALENDAR_QUEUE_H
+
+#include <vector>
+
+#include "EventQueue.h"
+
+class CalendarEventQueue : public EventQueue {
+ public:
+  CalendarEventQueue();
+  ~CalendarEventQueue();
+
+  Event getNextEvent();
+  const Event &peekNextEvent() const;
+
+  inline size_t getSize() const { return size + overflow.size(); }
+
+ protected:
+  void pushEvent(const Event &e);
+
+ private:
+  // Each bucket is kept sorted so that the next event to be handled is at
+  // the back of the vector.
+  typedef std::vector<Event> Bucket;
+
+  std::vector<Bucket> buckets;
+
+  // Events that can not be placed on the calendar (i.e. the deactivate event
+  // which is scheduled at infinity) are kept in a heap of their own.
+  std::priority_queue<Event, std::vector<Event>,
+                      std::less<std::vector<Event>::value_type> >
+      overflow;
+
+  size_t size;
+
+  double bucketWidth;
+
+  long long int currentBucket;
+
+  // The virtual bucket of the earliest event, which is kept between a peek
+  // and the pop that follows it. An insert can only move it earlier, a pop
+  // or a resize makes it unknown.
+  mutable long long int nextBucket;
+  mutable bool nextBucketKnown;
+
+  double lastTime;
+
+  inline long long int virtualBucket(double t) const {
+    return static_cast<long long int>(t / bucketWidth);
+  }
+
+  long long int findNextBucket() const;
+  void insert(const Event &e);
+  void resize(size_t newBucketCount);
+  double calculateBucketWidth(std::vector<Event> &events) const;
+
+  static const size_t MIN_BUCKETS;
+  static const size_t WIDTH_SAMPLES;
+};
+
+#endif
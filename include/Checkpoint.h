@@ -0,0 +1,86 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      Checkpoint.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the binary streams
+//					used to save the state of a run to a checkpoint
+//					file and to restore it again.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Binary checkpoint streams of a run.
+//
+// ____________________________________________________________________________
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Checkpoints are raw dumps of the in memory values, so they can only be
+// restored by the same build of the simulator on the same kind of machine.
+// The version is bumped whenever the layout of the file changes.
+class CheckpointWriter {
+ public:
+  explicit CheckpointWriter(const std::string& f);
+
+  inline bool isGood() const { return out.good(); }
+
+  template <typename T>
+  inline void write(const T& v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+  }
+
+  template <typename T>
+  inline void writeArray(const T* v, size_t n) {
+    out.write(reinterpret_cast<const char*>(v), sizeof(T) * n);
+  }
+
+  void writeString(const std::string& s);
+  void writeVector(const std::vector<double>& v);
+
+  void close();
+
+  static const char MAGIC[8];
+  static const unsigned int VERSION;
+
+ private:
+  std::ofstream out;
+};
+
+class CheckpointReader {
+ public:
+  explicit CheckpointReader(const std::string& f);
+
+  inline bool isGood() const { return in.good(); }
+
+  template <typename T>
+  inline void read(T& v) {
+    in.read(reinterpret_cast<char*>(&v), sizeof(T));
+  }
+
+  template <typename T>
+  inline void readArray(T* v, size_t n) {
+    in.read(reinterpret_cast<char*>(v), sizeof(T) * n);
+  }
+
+  std::string readString();
+  void readVector(std::vector<double>& v);
+
+  // Returns true if the file starts with the magic and version written by
+  // this build of the simulator.
+  bool checkHeader();
+
+ private:
+  std::ifstream in;
+};
+
+#endif
@@ -0,0 +1,78 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      CpuAffinity.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the CpuAffinity,
+//					which pins the simulation threads and the
+//					workers of their runs to their own cores.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Threads pinned to their own cores.
+//  10/18/2026  v2.1    Cores grouped by the cpulist of their NUMA node.
+//  10/18/2026  v2.1    Cores of the process kept for the scenarios of a sweep.
+//
+// ____________________________________________________________________________
+
+#ifndef CPU_AFFINITY_H
+#define CPU_AFFINITY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Each thread that is pinned is given a slot, and the slots are handed out
+// to the cores the process is allowed to run on, starting with the core the
+// program was started on. The cores are grouped by the NUMA node that sysfs
+// lists them under, since the cores of a node are not always numbered next
+// to each other, so the threads fill one node before moving to the next. The
+// memory of a thread is allocated by the thread itself once it is pinned, so
+// that the kernel places it on the node of the thread when it is first
+// touched. Pinning is only supported on Linux, elsewhere it does nothing.
+//
+// The cores of the process are read when the affinity is created, before any
+// thread is pinned, as the scenarios of a sweep file are run one after the
+// other on the main thread, which is pinned as thread zero.
+class CpuAffinity {
+ public:
+  CpuAffinity();
+
+  // Orders the cores the process is allowed to run on, called once the
+  // quality parameters have asked for the threads to be pinned.
+  void enable();
+
+  // Stops the threads of the next scenario from being pinned.
+  inline void disable() { cpus.clear(); }
+
+  // Parses a cpulist of sysfs, such as "0-3,8-11".
+  static std::vector<int> parseCpuList(const std::string& list);
+
+  // Orders the allowed cores by node, the node of the current core first and
+  // the other nodes in the order given, and each node from the current core
+  // on. The allowed cores that are not on any node come last.
+  static std::vector<int> orderCpus(const std::vector<int>& allowed,
+                                    const std::vector<std::vector<int> >& nodes,
+                                    int current);
+
+  inline bool isEnabled() const { return cpus.empty() == false; }
+
+  // Pins the calling thread to the core of the slot, returns false if the
+  // threads are not pinned.
+  bool pin(size_t slot) const;
+
+  // Lets the calling thread run on all of the cores of the process again.
+  void unpin() const;
+
+  long long int getCpu(size_t slot) const;
+
+ private:
+  std::vector<int> processCpus;
+  std::vector<int> cpus;
+};
+
+#endif
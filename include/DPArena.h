@@ -0,0 +1,106 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      DPArena.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the DPArena, which
+//					holds the search of the DP algorithm for a
+//					thread.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Per-thread arena of the DP search.
+//
+// ____________________________________________________________________________
+
+#ifndef DP_ARENA_H
+#define DP_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+class Edge;
+
+// The arena is reset for each request instead of being freed, so once it has
+// grown to the size of the searches a request does not allocate.
+//
+// Each item of the search only holds the last edge of its path and the item
+// it was expanded from, so the items share the prefixes of their paths. The
+// free wavelengths of an item are a bitset, which is the one of the item it
+// was expanded from and-ed with the free wavelengths of its last edge.
+class DPArena {
+ public:
+  static const size_t NO_ITEM;
+
+  struct Item {
+    size_t parent;
+    Edge* edge;
+    size_t pathLength;
+    size_t pathSpans;
+  };
+
+  // One of the k best paths to a router, in order of their weight.
+  struct Slot {
+    size_t item;
+    size_t pathSpans;
+    double optimalWave;
+    double pathQuality;
+    double pathWeight;
+  };
+
+  DPArena(size_t routers, size_t edges, size_t wavelengths);
+
+  // Starts the search of a new request, keeping k paths at each router.
+  void reset(size_t k);
+
+  // Adds the item for the path of the parent followed by the edge, which has
+  // the given index in the topology, to the end of the queue. The item is not
+  // added if none of the wavelengths are free along the path.
+  void addItem(size_t parent, Edge* edge, size_t edgeIndex);
+
+  inline bool hasNextItem() const { return nextItem < items.size(); }
+  inline size_t popNextItem() { return nextItem++; }
+
+  inline const Item& getItem(size_t i) const { return items[i]; }
+
+  inline bool isAvailable(size_t i, size_t w) const {
+    return (availability[i * words + w / 64] >> (w % 64) & 1ULL) != 0;
+  }
+
+  // Copies the edges of the path of the item, from the source, and returns
+  // the length of the path.
+  size_t getPath(size_t i, Edge** path) const;
+
+  // A buffer that can hold any path.
+  inline Edge** getPathBuffer(size_t b) { return &pathBuffers[b][0]; }
+
+  inline Slot* getSlots(size_t router) { return &slots[router * k]; }
+
+ private:
+  const unsigned long long* getFreeWavelengths(Edge* edge, size_t edgeIndex);
+
+  size_t routers;
+  size_t wavelengths;
+  size_t words;
+  size_t k;
+
+  std::vector<Item> items;
+  std::vector<unsigned long long> availability;
+  size_t nextItem;
+
+  std::vector<Slot> slots;
+
+  // The free wavelengths of the edges, which are only worked out for the
+  // edges that the search of the current request reaches.
+  std::vector<unsigned long long> edgeFree;
+  std::vector<size_t> edgeRequest;
+  size_t request;
+
+  std::vector<Edge*> pathBuffers[2];
+};
+
+#endif
@@ -33,10 +33,14 @@
 
 enum EdgeStatus { EDGE_FREE, EDGE_USED };
 
+class CheckpointReader;
+class CheckpointWriter;
+
 class Edge {
  public:
   Edge();
-  Edge(size_t src, size_t dest, size_t spans);
+  Edge(size_t src, size_t dest, size_t spans, EdgeStatus* st,
+       long long int* sessions, double* deg, EdgeStats* es);
 
   ~Edge();
 
@@ -94,6 +98,12 @@ class Edge {
     establishedConnections.push_back(ec_void);
   };
   void removeEstablishedConnection(void* dcpe_void);
+  inline const std::list<void*>& getEstablishedConnections() const {
+    return establishedConnections;
+  }
+
+  void saveCheckpoint(CheckpointWriter& out) const;
+  void loadCheckpoint(CheckpointReader& in);
 
  private:
   size_t sourceIndex;
@@ -125,6 +135,8 @@ class Edge {
   ALLEGRO_BITMAP* edgeBmps[14];
   ALLEGRO_BITMAP* edgeBmp;
 #endif
+  // The per wavelength state and the stats are owned by the thread, which
+  // keeps them for all of its edges in one block.
   EdgeStats* stats;
 
   double pheremone;
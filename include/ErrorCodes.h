@@ -49,7 +49,10 @@ enum ErrorCodes {
   ERROR_NO_FLUSH = -26,
   ERROR_GUI = -27,
   ERROR_THREAD_CREATION = -28,
-  ERROR_OCTAVE = -29
+  ERROR_OCTAVE = -29,
+  ERROR_EVENT_QUEUE = -30,
+  ERROR_CHECKPOINT = -31,
+  ERROR_SWEEP_FILE = -32
 };
 
 #endif
@@ -15,6 +15,8 @@
 //  05/20/2009	v1.0	Initial Version.
 //  06/02/2009	v1.02	Minor optimizations and bug fixes.
 //  04/14/2019  v2.0    Reworked version based upon cmake and octave
+//  10/18/2026  v2.1    Ordering key packed with the event type
+//  10/18/2026  v2.1    Unsigned event type bit-field for MSVC
 //
 // ____________________________________________________________________________
 
@@ -27,7 +29,9 @@
 
 #include <vector>
 
-enum EventType {
+// The type is stored in a 4 bit field of the Event, so the enum is kept
+// unsigned for the compilers that treat a plain enum bit-field as signed.
+enum EventType : unsigned char {
   ACTIVATE_WORKSTATIONS,
   DEACTIVATE_WORKSTATIONS,
   UPDATE_USAGE,
@@ -40,12 +44,38 @@ enum EventType {
   NUMBER_OF_EVENTS
 };
 
+struct ConnectionRequestEvent;
+struct CreateConnectionProbeEvent;
+struct CreateConnectionConfirmationEvent;
+struct CollisionNotificationEvent;
+struct DestroyConnectionProbeEvent;
+
+// The payload that goes with an event, the member that is valid is
+// determined by the e_type of the event.
+union EventData {
+  ConnectionRequestEvent *request;
+  CreateConnectionProbeEvent *probe;
+  CreateConnectionConfirmationEvent *confirmation;
+  CollisionNotificationEvent *collision;
+  DestroyConnectionProbeEvent *destroy;
+};
+
+// Events are ordered by e_time, then e_type, then e_key. The e_key packs the
+// session and sequence of the event and is built by the EventQueue when the
+// event is added, so the queues never have to look at the payload to break a
+// tie. The type and the key share one word, which keeps an event at 24 bytes
+// (the size it had before the key) for the heap to move around. Both fields
+// have the same type, as MSVC only packs bit-fields of the same type into one
+// unit.
 struct Event {
-  EventType e_type;
   double e_time;
-  void *e_data;
+  EventData e_data;
+  unsigned long long int e_key : 60;
+  unsigned long long int e_type : 4;
 };
 
+static_assert(NUMBER_OF_EVENTS <= 16, "EventType does not fit in e_type");
+
 struct ConnectionRequestEvent {
   size_t sourceRouterIndex;
   size_t destinationRouterIndex;
@@ -0,0 +1,175 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      EventPool.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the EventPool, which
+//					recycles the payloads carried by the events so that
+//					the simulation does not go through the heap for every
+//					hop of every probe.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Typed payload pools of the events.
+//
+// ____________________________________________________________________________
+
+#ifndef EVENT_POOL_H
+#define EVENT_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "Event.h"
+
+struct PayloadPoolStats {
+  size_t acquired;
+  size_t released;
+  size_t reused;
+  size_t outstanding;
+  size_t peakOutstanding;
+  size_t slabs;
+};
+
+// Free list allocator for a single payload type. Payloads are carved out of
+// slabs of SLAB_SIZE entries and threaded onto the free list when released,
+// so after the first few seconds of simulated time no more heap allocations
+// are required. Not thread safe, each Thread owns its own pool.
+template <class T>
+class PayloadPool {
+ public:
+  PayloadPool() : freeList(nullptr), stats() {}
+
+  ~PayloadPool() {
+    for (size_t s = 0; s < slabs.size(); ++s) delete[] slabs[s];
+  }
+
+  inline T* acquire() {
+    if (freeList == nullptr)
+      grow();
+    else
+      ++stats.reused;
+
+    Node* node = freeList;
+    freeList = node->next;
+
+    ++stats.acquired;
+
+    if (++stats.outstanding > stats.peakOutstanding)
+      stats.peakOutstanding = stats.outstanding;
+
+    return new (&node->payload) T();
+  }
+
+  inline void release(T* p) {
+    Node* node = reinterpret_cast<Node*>(p);
+
+    node->next = freeList;
+    freeList = node;
+
+    ++stats.released;
+    --stats.outstanding;
+  }
+
+  inline const PayloadPoolStats& getStats() const { return stats; }
+
+  // The outstanding count is kept so that payloads still in flight from the
+  // previous run are not reported as leaks in the next one.
+  inline void resetStats() {
+    stats.acquired = 0;
+    stats.released = 0;
+    stats.reused = 0;
+    stats.peakOutstanding = stats.outstanding;
+  }
+
+ private:
+  union Node {
+    Node* next;
+    T payload;
+  };
+
+  static const size_t SLAB_SIZE = 256;
+
+  void grow() {
+    Node* slab = new Node[SLAB_SIZE];
+
+    for (size_t n = 0; n < SLAB_SIZE - 1; ++n) slab[n].next = &slab[n + 1];
+
+    slab[SLAB_SIZE - 1].next = freeList;
+    freeList = slab;
+
+    slabs.push_back(slab);
+    stats.slabs = slabs.size();
+  }
+
+  Node* freeList;
+  std::vector<Node*> slabs;
+
+  PayloadPoolStats stats;
+};
+
+class EventPool {
+ public:
+  inline ConnectionRequestEvent* acquireRequest() {
+    return requests.acquire();
+  }
+  inline CreateConnectionProbeEvent* acquireProbe() { return probes.acquire(); }
+  inline CreateConnectionConfirmationEvent* acquireConfirmation() {
+    return confirmations.acquire();
+  }
+  inline CollisionNotificationEvent* acquireCollision() {
+    return collisions.acquire();
+  }
+  inline DestroyConnectionProbeEvent* acquireDestroy() {
+    return destroys.acquire();
+  }
+
+  inline void release(ConnectionRequestEvent* p) { requests.release(p); }
+  inline void release(CreateConnectionProbeEvent* p) { probes.release(p); }
+  inline void release(CreateConnectionConfirmationEvent* p) {
+    confirmations.release(p);
+  }
+  inline void release(CollisionNotificationEvent* p) { collisions.release(p); }
+  inline void release(DestroyConnectionProbeEvent* p) { destroys.release(p); }
+
+  // Returns the statistics of the pool that backs the payload of the given
+  // event type, or nullptr if that event type does not carry a payload.
+  inline const PayloadPoolStats* getStats(EventType type) const {
+    switch (type) {
+      case CONNECTION_REQUEST:
+        return &requests.getStats();
+      case CREATE_CONNECTION_PROBE:
+        return &probes.getStats();
+      case CREATE_CONNECTION_CONFIRMATION:
+        return &confirmations.getStats();
+      case COLLISION_NOTIFICATION:
+        return &collisions.getStats();
+      case DESTROY_CONNECTION_PROBE:
+        return &destroys.getStats();
+      default:
+        return nullptr;
+    }
+  }
+
+  inline void resetStats() {
+    requests.resetStats();
+    probes.resetStats();
+    confirmations.resetStats();
+    collisions.resetStats();
+    destroys.resetStats();
+  }
+
+ private:
+  PayloadPool<ConnectionRequestEvent> requests;
+  PayloadPool<CreateConnectionProbeEvent> probes;
+  PayloadPool<CreateConnectionConfirmationEvent> confirmations;
+  PayloadPool<CollisionNotificationEvent> collisions;
+  PayloadPool<DestroyConnectionProbeEvent> destroys;
+};
+
+#endif
@@ -0,0 +1,100 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      EventProfiler.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the EventProfiler,
+//					which counts the events handled by a run and
+//					measures how long each type of event takes to
+//					handle. It is only used when the simulator is
+//					built with PROFILE_EVENTS defined.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Counts and times of the events of a run.
+//
+// ____________________________________________________________________________
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Event.h"
+
+class EventProfiler {
+ public:
+  typedef std::chrono::steady_clock Clock;
+
+  EventProfiler();
+
+  void reset(double time);
+
+  // Adds an event of the given type that was started at the given wall
+  // clock time, along with the number of events that were still pending
+  // once it was handled.
+  inline void record(EventType type, Clock::time_point start, size_t depth,
+                     double time) {
+    long long int ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           Clock::now() - start)
+                           .count();
+
+    add(type, ns < 0 ? 0 : static_cast<unsigned long long int>(ns));
+
+    depthTotal += depth;
+    ++depthCount;
+
+    if (depth > depthPeak) {
+      depthPeak = depth;
+      depthPeakTime = time;
+    }
+
+    // The deactivate event is handled at infinity, which is past the last
+    // sample of the run.
+    while (time >= nextSample && std::isfinite(time) == true) {
+      samples.push_back(std::make_pair(nextSample, depth));
+      nextSample += SAMPLE_INTERVAL;
+    }
+  }
+
+  void print(size_t ci) const;
+
+ private:
+  // Handler times are kept in buckets that double in width, bucket b holds
+  // the times from 2^b up to 2^(b+1) nanoseconds.
+  static const size_t BUCKETS = 48;
+
+  // The simulated time between two samples of the queue depth.
+  static const double SAMPLE_INTERVAL;
+
+  struct TypeProfile {
+    unsigned long long int count;
+    unsigned long long int totalNs;
+    unsigned long long int maxNs;
+    unsigned long long int histogram[BUCKETS];
+  };
+
+  void add(EventType type, unsigned long long int ns);
+
+  double getPercentile(const TypeProfile& p, double q) const;
+
+  TypeProfile profiles[NUMBER_OF_EVENTS];
+
+  unsigned long long int depthTotal;
+  unsigned long long int depthCount;
+  size_t depthPeak;
+  double depthPeakTime;
+
+  double nextSample;
+  std::vector<std::pair<double, size_t> > samples;
+};
+
+#endif
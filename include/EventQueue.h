@@ -15,6 +15,7 @@
 //
 //  05/20/2009	v1.0	Initial Version.
 //  04/14/2019  v2.0    Reworked version based upon cmake and octave
+//  10/18/2026  v2.1    Pluggable queue backends (heap, calendar, verify)
 //
 // ____________________________________________________________________________
 
@@ -27,72 +28,132 @@
 
 #include "ErrorCodes.h"
 #include "Event.h"
+#include "QualityParameters.h"
 
+// Interface shared by all of the event queue implementations. Every
+// implementation must hand the events back in the order defined by the
+// operator< below, so that the backends can be swapped without changing the
+// results of a simulation.
 class EventQueue {
  public:
-  EventQueue();
-  ~EventQueue();
+  virtual ~EventQueue() {}
 
-  Event getNextEvent();
+  virtual Event getNextEvent() = 0;
+  virtual const Event &peekNextEvent() const = 0;
+
+  inline void addEvent(const Event &e) {
+    Event keyed = e;
+    setOrderKey(keyed);
+    pushEvent(keyed);
+  }
+
+  virtual size_t getSize() const = 0;
+
+  static EventQueue *createEventQueue(EventQueueType type);
+
+  // Packs the session and sequence of the event into its ordering key so
+  // that the queues never have to look at the payload.
+  static inline void setOrderKey(Event &e) {
+    unsigned long long int session = 0;
+    unsigned long long int sequence = 0;
+
+    switch (e.e_type) {
+      case CONNECTION_REQUEST:
+        session = e.e_data.request->session;
+        break;
+      case CREATE_CONNECTION_PROBE:
+        session = e.e_data.probe->session;
+        sequence =
+            static_cast<unsigned long long int>(e.e_data.probe->sequence);
+        break;
+      case CREATE_CONNECTION_CONFIRMATION:
+        session = e.e_data.confirmation->session;
+        break;
+      case COLLISION_NOTIFICATION:
+        session = e.e_data.collision->session;
+        break;
+      case DESTROY_CONNECTION_PROBE:
+        session = e.e_data.destroy->session;
+        break;
+      default:
+        break;
+    }
+
+    if (session > KEY_SESSION_MASK || sequence > KEY_SEQUENCE_MASK)
+      reportKeyOverflow(session, sequence);
+
+    e.e_key = (session << KEY_SESSION_SHIFT) | sequence;
+  }
+
+ protected:
+  virtual void pushEvent(const Event &e) = 0;
+
+ private:
+  // Layout of the e_key of the ordering key, from the most significant bit:
+  // 44 bits of session, 16 bits of sequence.
+  static const unsigned int KEY_SESSION_SHIFT = 16;
+  static const unsigned long long int KEY_SESSION_MASK = (1ULL << 44) - 1;
+  static const unsigned long long int KEY_SEQUENCE_MASK = (1ULL << 16) - 1;
+
+  static void reportKeyOverflow(unsigned long long int session,
+                                unsigned long long int sequence);
+};
+
+class HeapEventQueue final : public EventQueue {
+ public:
+  HeapEventQueue();
+  ~HeapEventQueue();
 
-  inline void addEvent(const Event &e) { pq.push(e); };
+  inline Event getNextEvent() {
+    Event retVal = pq.top();
+
+    pq.pop();
+
+    return retVal;
+  }
+
+  inline const Event &peekNextEvent() const { return pq.top(); }
 
   inline size_t getSize() const { return pq.size(); }
 
+ protected:
+  inline void pushEvent(const Event &e) { pq.push(e); };
+
  private:
   std::priority_queue<Event, std::vector<Event>,
                       std::less<std::vector<Event>::value_type> >
       pq;
 };
 
-static bool operator<(const Event &event1, const Event &event2) {
-  if (event1.e_time != event2.e_time) {
+// Runs the heap and the calendar queue side by side and terminates the
+// simulation as soon as the two of them disagree on the next event.
+class VerifyEventQueue : public EventQueue {
+ public:
+  VerifyEventQueue();
+  ~VerifyEventQueue();
+
+  Event getNextEvent();
+  inline const Event &peekNextEvent() const { return heap->peekNextEvent(); }
+
+  inline size_t getSize() const { return heap->getSize(); }
+
+ protected:
+  void pushEvent(const Event &e);
+
+ private:
+  EventQueue *heap;
+  EventQueue *calendar;
+
+  size_t eventsCompared;
+};
+
+static inline bool operator<(const Event &event1, const Event &event2) {
+  if (event1.e_time != event2.e_time)
     return event1.e_time > event2.e_time;
-  } else if (event1.e_type == event2.e_type) {
-    if (event1.e_type == CONNECTION_REQUEST) {
-      ConnectionRequestEvent *cre1 =
-          static_cast<ConnectionRequestEvent *>(event1.e_data);
-      ConnectionRequestEvent *cre2 =
-          static_cast<ConnectionRequestEvent *>(event2.e_data);
-
-      return cre1->session > cre2->session;
-    } else if (event1.e_type == CREATE_CONNECTION_PROBE) {
-      CreateConnectionProbeEvent *ccp1 =
-          static_cast<CreateConnectionProbeEvent *>(event1.e_data);
-      CreateConnectionProbeEvent *ccp2 =
-          static_cast<CreateConnectionProbeEvent *>(event2.e_data);
-
-      if (ccp1->session != ccp2->session)
-        return ccp1->session > ccp1->session;
-      else
-        return ccp1->sequence > ccp2->sequence;
-    } else if (event1.e_type == CREATE_CONNECTION_CONFIRMATION) {
-      CreateConnectionConfirmationEvent *ccc1 =
-          static_cast<CreateConnectionConfirmationEvent *>(event1.e_data);
-      CreateConnectionConfirmationEvent *ccc2 =
-          static_cast<CreateConnectionConfirmationEvent *>(event2.e_data);
-
-      return ccc1->session > ccc2->session;
-    } else if (event1.e_type == COLLISION_NOTIFICATION) {
-      CollisionNotificationEvent *cn1 =
-          static_cast<CollisionNotificationEvent *>(event1.e_data);
-      CollisionNotificationEvent *cn2 =
-          static_cast<CollisionNotificationEvent *>(event2.e_data);
-
-      return cn1->session > cn2->session;
-    } else if (event1.e_type == DESTROY_CONNECTION_PROBE) {
-      DestroyConnectionProbeEvent *dcp1 =
-          static_cast<DestroyConnectionProbeEvent *>(event1.e_data);
-      DestroyConnectionProbeEvent *dcp2 =
-          static_cast<DestroyConnectionProbeEvent *>(event2.e_data);
-
-      return dcp1->session > dcp2->session;
-    } else {
-      exit(ERROR_PRIORITY_QUEUE);
-    }
-  } else {
+  else if (event1.e_type != event2.e_type)
     return event1.e_type > event2.e_type;
-  }
+  else
+    return event1.e_key > event2.e_key;
 }
 
 #endif
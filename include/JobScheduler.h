@@ -0,0 +1,133 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      JobScheduler.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the JobScheduler,
+//					which hands out the runs of the algorithm sweep
+//					to the threads, longest first, and lets a thread
+//					that has run out of work steal from the others.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Longest job first sweep with work stealing.
+//  10/18/2026  v2.1    Replications claimed as one job of a shared sweep.
+//
+// ____________________________________________________________________________
+
+#ifndef JOB_SCHEDULER_H
+#define JOB_SCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "AlgorithmParameters.h"
+#include "SharedSweep.h"
+#include "pthread.h"
+
+class JobScheduler {
+ public:
+  JobScheduler();
+  ~JobScheduler();
+
+  // Deletes all of the jobs and results, ready for the next scenario.
+  void reset();
+
+  // Adds a job to the sweep. Before the sweep has started the jobs are only
+  // collected, afterwards the job goes to the front of the queue of the
+  // given worker (i.e. the next replication of the run it just finished).
+  void addJob(AlgorithmToRun* job, size_t worker);
+
+  // Estimates the cost of every job and deals them out to the workers.
+  void start(size_t workers, size_t wavelengths);
+
+  // Returns the next job for the worker, stealing one from another worker
+  // if its own queue is empty, or nullptr once there are no jobs left.
+  AlgorithmToRun* getNextJob(size_t worker);
+
+  // Records how long a job that was handed out took to run.
+  void completeJob(size_t worker, double seconds);
+
+  // Shares the sweep with the other processes that use the same prefix, the
+  // jobs are then only run if this process is the first to claim them.
+  void share(const std::string& prefix);
+
+  inline bool isShared() const { return sweep != nullptr; }
+
+  // Adds the results printed by the last job that was handed out to the
+  // worker, which are saved once the job and its replications are done.
+  void recordResults(size_t worker, const std::string& results);
+
+  // Merges the results of the shared sweep, once every job has been run.
+  void mergeResults() const;
+
+  void printReport() const;
+
+  size_t getNumberOfJobs() const;
+
+  static double estimateCost(const AlgorithmToRun& job, size_t wavelengths);
+
+ private:
+  struct Job {
+    AlgorithmToRun* job;
+    AlgorithmToRun config;
+    double estimate;
+    size_t index;  // position in the sweep of the job, or of the job it is a
+                   // replication of
+  };
+
+  // The results of a job of a shared sweep and the number of its runs (the
+  // job itself and its replications) that are still queued or running.
+  struct SharedJob {
+    std::string results;
+    size_t outstanding;
+  };
+
+  static bool isMoreExpensive(const Job& a, const Job& b);
+
+  size_t countQueued(size_t index) const;
+  void dropQueued(size_t index);
+
+  struct CompletedJob {
+    AlgorithmToRun config;
+    double estimate;
+    double seconds;
+    size_t worker;
+    bool stolen;
+  };
+
+  // Each worker has its own queue, kept with the most expensive job at the
+  // front. Stealing takes the front of the queue with the most work left.
+  struct WorkerQueue {
+    std::deque<Job> jobs;
+    double remaining;
+    Job current;
+    bool currentStolen;
+  };
+
+  size_t wavelengths;
+
+  std::chrono::steady_clock::time_point startTime;
+
+  std::vector<Job> pending;
+  std::vector<WorkerQueue> queues;
+  std::vector<CompletedJob> completed;
+
+  SharedSweep* sweep;
+  size_t sweepJobs;
+  std::map<size_t, SharedJob> sharedJobs;
+
+  // The jobs take seconds to minutes each, so a single lock for all of the
+  // queues is not contended.
+  mutable pthread_mutex_t mutex;
+};
+
+#endif
@@ -27,6 +27,7 @@
 #include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 class MessageLogger {
@@ -43,12 +44,22 @@ class MessageLogger {
 
   inline void UnlockResultsMutex() { pthread_mutex_unlock(&ResultsMutex); };
 
+  // Keeps a copy of the messages that are printed for the thread, without
+  // their timestamps, until the capture is stopped. Only one thread captures
+  // at a time, as it holds the results mutex while it does.
+  void startCapture(size_t ci);
+  std::string stopCapture();
+
  private:
   std::ofstream eventLogger;
 
   pthread_mutex_t LogMutex;
   pthread_mutex_t PrintMutex;
   pthread_mutex_t ResultsMutex;
+
+  bool capturing;
+  size_t captureIndex;
+  std::ostringstream capture;
 };
 
 #endif
@@ -0,0 +1,75 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      PathCache.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the PathCache,
+//					which keeps the k shortest paths between the
+//					routers for the static cost models, so that
+//					they are only calculated once for the sweep.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Shortest paths shared across the sweep.
+//
+// ____________________________________________________________________________
+
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "KShortestPathStructs.h"
+#include "pthread.h"
+
+// The cost of an edge when the paths are calculated. Only the costs that do
+// not change during a run can be cached.
+enum PathCostModel { HOP_COUNT, SPAN_COUNT, NUMBER_OF_PATH_COST_MODELS };
+
+// The cache is shared by all of the threads and lives for the whole sweep.
+// Once a path is in the cache it is never changed or freed until the cache
+// is destroyed, so the callers must not delete the paths they are given.
+// Lookups only take a read lock, the lock is only taken for writing when a
+// new path is added.
+class PathCache {
+ public:
+  explicit PathCache(size_t routers);
+  ~PathCache();
+
+  // Returns the cached paths, or nullptr if they have not been calculated.
+  kShortestPathReturn* find(size_t src, size_t dest, size_t k,
+                            PathCostModel model) const;
+
+  // Adds the paths to the cache and returns the cached copy. If another
+  // thread added the same paths first, the given paths are deleted and the
+  // ones that are already in the cache are returned instead.
+  kShortestPathReturn* insert(size_t src, size_t dest, size_t k,
+                              PathCostModel model, kShortestPathReturn* paths);
+
+ private:
+  struct Entry {
+    size_t k;
+    PathCostModel model;
+    kShortestPathReturn* paths;
+  };
+
+  kShortestPathReturn* lookup(size_t src, size_t dest, size_t k,
+                              PathCostModel model) const;
+
+  static void deletePaths(kShortestPathReturn* paths);
+
+  size_t routers;
+
+  // The entries of every pair of routers, there are only ever a handful for
+  // each pair (one for each value of k and cost model that is used).
+  std::vector<std::vector<Entry> > entries;
+
+  mutable pthread_rwlock_t lock;
+};
+
+#endif
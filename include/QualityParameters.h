@@ -27,6 +27,12 @@ enum DestinationDistribution {
   INVERSE_DISTANCE = 3
 };
 
+enum EventQueueType {
+  HEAP_QUEUE = 1,
+  CALENDAR_QUEUE = 2,
+  VERIFY_QUEUE = 3
+};
+
 struct QualityParameters {
   double arrival_interval;       // the inter arrival time on each workstation
   double duration;               // the duration time of one connection
@@ -65,6 +71,34 @@ struct QualityParameters {
   double MM_ACO_gamma;  // the min-max pheromone ratio for MM ACO
   size_t MM_ACO_N_iter;  // the number of iterations for stagnation for MM ACO
   size_t MM_ACO_N_reset;  // the number of reinitialization times for MM ACO
+  EventQueueType event_queue;  // event queue implementation to use
+  bool hop_fast_forward;       // only schedule the decision bearing hops of
+                               // probes and teardowns (1=yes,0=no)
+  size_t run_workers;          // number of cores used within a single run
+  size_t max_replications;     // max independent replications per run
+  size_t min_replications;     // replications run before checking the CI
+  double ci_half_width;        // target 95% CI half width of the blocking
+  double batch_precision;      // relative precision that ends a run early
+                               // (0=run for the full ten hours)
+  double batch_abs_precision;  // half width that is always precise enough,
+                               // for the metrics with a mean near zero
+  size_t batch_size;           // connection requests per batch
+  size_t min_batches;          // batches before convergence is checked
+  bool warmup_detection;       // remove the warm-up of each run (1=yes,0=no)
+  size_t warmup_interval;      // connection requests per warm-up sample
+  double checkpoint_interval;  // simulated seconds between checkpoints
+                               // (0=no checkpoints)
+  bool checkpoint_restore;     // resume each run from its checkpoint if one
+                               // exists (1=yes,0=no)
+  bool request_trace;          // replay the requests from a recorded trace
+                               // (1=yes,0=no)
+  bool thread_affinity;        // pin each thread to its own core
+                               // (1=yes,0=no)
+  bool shared_sweep;           // share the sweep with the other processes
+                               // started with the same arguments (1=yes,0=no)
+  size_t candidate_paths;      // candidate paths kept for each pair of
+                               // routers for LORA, PABR, QM and AQoS
+                               // (0=search for the paths of each request)
 };
 
 #endif
@@ -0,0 +1,88 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      Replications.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the ReplicationSet,
+//					which gathers the results of the independent
+//					replications of a single configuration and decides
+//					when enough of them have been run.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Independent replications with confidence intervals.
+//
+// ____________________________________________________________________________
+
+#ifndef REPLICATIONS_H
+#define REPLICATIONS_H
+
+#include <cstddef>
+
+#include "AlgorithmParameters.h"
+#include "pthread.h"
+
+struct GlobalStats;
+
+// Running mean and variance of a single metric (Welford's method), so that
+// the replications can be folded in as soon as they complete.
+class RunningStat {
+ public:
+  RunningStat() : count(0), mean(0.0), m2(0.0) {}
+
+  void add(double x);
+
+  inline size_t getCount() const { return count; }
+  inline double getMean() const { return mean; }
+  double getVariance() const;
+  double getHalfWidth() const;
+
+ private:
+  size_t count;
+  double mean;
+  double m2;
+};
+
+class ReplicationSet {
+ public:
+  ReplicationSet(const AlgorithmToRun& config, size_t minReplications,
+                 size_t maxReplications, double targetHalfWidth);
+  ~ReplicationSet();
+
+  AlgorithmToRun* createReplication();
+
+  // Folds in the results of a completed replication. Returns the next
+  // replication to run if the confidence interval is still too wide, and
+  // sets finished once the last outstanding replication has completed.
+  AlgorithmToRun* addReplication(const GlobalStats& stats, size_t ci,
+                                 bool* finished);
+
+  static unsigned int getReplicationSeed(size_t baseSeed, size_t replication);
+
+ private:
+  void printSummary(size_t ci) const;
+
+  AlgorithmToRun config;
+
+  size_t minReplications;
+  size_t maxReplications;
+  double targetHalfWidth;
+
+  size_t launched;
+  size_t completed;
+
+  RunningStat blocking;
+  RunningStat collisions;
+  RunningStat quality;
+  RunningStat resources;
+  RunningStat probes;
+  RunningStat delay;
+
+  pthread_mutex_t mutex;
+};
+
+#endif
@@ -0,0 +1,111 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      RequestTrace.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the RequestTrace,
+//					a binary file holding the complete stream of
+//					connection requests of a run, so that every
+//					algorithm can be fed exactly the same workload.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Binary trace of the request stream.
+//
+// ____________________________________________________________________________
+
+#ifndef REQUEST_TRACE_H
+#define REQUEST_TRACE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class Thread;
+
+// A single connection request of a workstation.
+struct TraceRecord {
+  double arrivalTime;
+  double duration;
+  unsigned long long destination;
+};
+
+// The file starts with this header, followed by the activation order of all
+// of the workstations, the offset of the stream of each workstation (plus
+// one for the end of the last stream) and then the records. Everything is
+// stored as it is laid out in memory, so that the file can be mapped in and
+// used as is.
+struct TraceHeader {
+  char magic[8];
+  unsigned long long version;
+  unsigned long long seed;
+  unsigned long long routers;
+  unsigned long long workstations;
+  unsigned long long activeWorkstations;
+  unsigned long long destDist;
+  unsigned long long records;
+  double arrivalInterval;
+  double duration;
+  double minDuration;
+  double stopTime;
+};
+
+class RequestTrace {
+ public:
+  ~RequestTrace();
+
+  // Maps in the trace stored in the file, recording it first if the file is
+  // missing or was recorded with different settings.
+  static RequestTrace* open(const std::string& file, const Thread* t,
+                            unsigned int seed, size_t activeWorkstations,
+                            double stopTime);
+
+  inline const std::string& getFile() const { return file; }
+
+  inline size_t getActiveWorkstations() const {
+    return header->activeWorkstations;
+  }
+
+  inline size_t getWorkstationAt(size_t i) const { return order[i]; }
+
+  // Returns the request with the given index in the stream of the
+  // workstation, or nullptr once the stream has run out.
+  inline const TraceRecord* getRecord(size_t workstation, size_t r) const {
+    size_t index = offsets[workstation] + r;
+
+    if (index >= offsets[workstation + 1]) return nullptr;
+
+    return &records[index];
+  }
+
+  static const char MAGIC[8];
+  static const unsigned long long VERSION;
+
+ private:
+  RequestTrace(const std::string& f);
+
+  bool map();
+  void unmap();
+  bool matches(const TraceHeader& h) const;
+
+  void record(const Thread* t, const TraceHeader& h);
+
+  std::string file;
+
+  // The trace is either mapped in from the file, or held in the buffer if
+  // it was just recorded (or the platform does not support mapping files).
+  void* mapping;
+  size_t length;
+  std::vector<char> buffer;
+
+  const TraceHeader* header;
+  const unsigned long long* order;
+  const unsigned long long* offsets;
+  const TraceRecord* records;
+};
+
+#endif
@@ -26,25 +26,26 @@
 #define RESOURCE_MANAGER_H
 
 #include <queue>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "AlgorithmParameters.h"
 #include "Edge.h"
 #include "Event.h"
+#include "PathCache.h"
 #include "Router.h"
 
-struct DP_item {
-  Edge** path;
-  size_t pathLength;
-  size_t pathSpans;
-  bool* waveAvailability;
-};
+// The dynamic cost of an edge when the candidate paths are ranked.
+enum CandidateCostModel { USAGE_COST, QM_COST };
 
 class ResourceManager {
  public:
   ResourceManager();
   ~ResourceManager();
 
+  static void clearPhysicsCache();
+
   kShortestPathReturn* calculate_SP_path(size_t src_index, size_t dest_index,
                                          size_t k, size_t ci);
   kShortestPathReturn* calculate_LORA_path(size_t src_index, size_t dest_index,
@@ -70,15 +71,19 @@ class ResourceManager {
   double estimate_Q(long long int lambda, Edge** Path, size_t pathLen,
                     double* xpm, double* fwm, double* ase, size_t ci) const;
 
-  void initSPMatrix();
-  void freeSPMatrix();
-
   void print_connection_info(CreateConnectionProbeEvent* ccpe, double Q_factor,
                              double ase, double fwm, double xpm, size_t ci) const;
 
   size_t* span_distance;
 
  private:
+  void estimate_Q_available(CreateConnectionProbeEvent* ccpe, size_t ci,
+                            bool* wave_available, double* q, double* xpm,
+                            double* fwm, double* ase) const;
+  void estimate_Q_list(Edge** Path, size_t pathLen, const size_t* waves,
+                       size_t count, size_t ci, double* q, double* xpm,
+                       double* fwm, double* ase) const;
+
   double path_ase_noise(long long int lambda, Edge** Path, size_t pathLen,
                         size_t ci) const;
 
@@ -94,6 +99,13 @@ class ResourceManager {
 
   size_t calculate_span_distance(size_t src_index, size_t dest_index);
 
+  // Ranks the candidate paths of the pair of routers by their current cost,
+  // returns nullptr if there are not enough of them for k paths.
+  kShortestPathReturn* rank_candidate_paths(size_t src_index,
+                                            size_t dest_index, size_t k,
+                                            size_t ci,
+                                            CandidateCostModel model);
+
   long long int build_FWM_fs(double* inter_fs, long long int* inter_indecies, size_t lambda);
   long long int wave_combines(double fc, double* fs, long long int fs_num,
                     std::vector<long long int>& fs_coms);
@@ -114,20 +126,9 @@ class ResourceManager {
   long long int most_used(CreateConnectionProbeEvent* ccpe, size_t ci,
                           bool* wave_available);
 
-  long long int quality_first_fit(CreateConnectionProbeEvent* ccpe, size_t ci,
-                                  bool* wave_available,
-                                  size_t numberAvailableWaves);
-  long long int quality_first_fit_with_ordering(
-      CreateConnectionProbeEvent* ccpe, size_t ci, bool* wave_available,
-      size_t numberAvailableWaves);
-
-  long long int quality_random_fit(CreateConnectionProbeEvent* ccpe, size_t ci,
-                                   bool* wave_available,
-                                   size_t numberAvailableWaves);
-
-  long long int quality_most_used(CreateConnectionProbeEvent* ccpe, size_t ci,
-                                  bool* wave_available,
-                                  size_t numberAvailableWaves);
+  long long int quality_fit(CreateConnectionProbeEvent* ccpe, size_t ci,
+                            bool* wave_available, size_t numberAvailableWaves,
+                            WavelengthAlgorithm algorithm);
 
   long long int least_quality_fit(CreateConnectionProbeEvent* ccpe, size_t ci,
                                   bool* wave_available);
@@ -137,10 +138,13 @@ class ResourceManager {
   void precompute_fwm_fs(std::vector<long long int>& fwm_nums);
   void precompute_fwm_combinations();
 
+  void loadPhysicsTables();
+
   std::vector<double*>* fwm_fs;
   std::vector<long long int*>* inter_indecies;
 
-  kShortestPathReturn** SP_paths;
+  // The shortest paths of the SP algorithm, shared by all of the threads.
+  PathCache* pathCache;
 
   void build_KSP_EdgeList();
 
@@ -148,6 +152,22 @@ class ResourceManager {
 
   void calc_min_spans();
 
+  // Calculates the shortest path by the cost model from every router to all
+  // of the others, one search for each router, and adds them to the path
+  // cache.
+  void calc_span_trees(PathCostModel model);
+
+  // The shortest paths by span count and by hop count are kept in a file
+  // between runs, which is only used if it was written for the same topology
+  // file.
+  std::string get_span_file() const;
+  bool read_span_file(const std::string& file);
+  void write_span_file(const std::string& file) const;
+
+  // Calculates the candidate paths of every pair of routers by span count,
+  // they are kept in the path cache for the whole sweep.
+  void build_candidate_pool();
+
   long long int* wave_ordering;
 
   void generateWaveOrdering();
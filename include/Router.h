@@ -35,16 +35,6 @@ extern int realTopoHeightPx;
 
 #include <vector>
 
-struct DP_node {
-  Edge** paths;
-  bool* waveAvailability;
-  size_t* pathLength;
-  size_t* pathSpans;
-  double* optimalWave;
-  double* pathQuality;
-  double* pathWeight;
-};
-
 class Router {
  public:
   Router();
@@ -75,6 +65,9 @@ class Router {
 
   void addEdge(Edge* e);
 
+  // Uses the adjacency list of the topology, which is shared by the threads.
+  inline void setAdjacency(const long long int* a) { adjacencyList = a; }
+
   inline long long int isAdjacentTo(size_t r) const { return adjacencyList[r]; }
 
   inline Edge* getEdgeByIndex(size_t e) const { return edgeList[e]; }
@@ -87,6 +80,9 @@ class Router {
   void resetQMDegredation();
   void resetFailures();
 
+  void saveCheckpoint(CheckpointWriter& out) const;
+  void loadCheckpoint(CheckpointReader& in);
+
   inline size_t getQualityFailures() const { return qualityFailures; }
   inline size_t getWaveFailures() const { return waveFailures; }
 
@@ -155,15 +151,14 @@ class Router {
   void selectScreen();
 
 #endif
-  DP_node* dp_node;
-
  private:
   size_t routerIndex;
 
   size_t qualityFailures;
   size_t waveFailures;
 
-  long long int* adjacencyList;
+  const long long int* adjacencyList;
+  long long int* ownAdjacency;
 
 #ifndef NO_ALLEGRO
   size_t connAttemptsFromThis;
@@ -0,0 +1,61 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      SharedSweep.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the SharedSweep,
+//					which lets several processes work through the
+//					same algorithm sweep, each taking the runs that
+//					no other process has taken yet.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Sweep shared between processes.
+//
+// ____________________________________________________________________________
+
+#ifndef SHARED_SWEEP_H
+#define SHARED_SWEEP_H
+
+#include <cstddef>
+#include <string>
+
+// The processes only share the output directory, which may be on a network
+// filesystem. A process takes a job of the sweep by creating its claim file,
+// which only one process can do as the file is created exclusively. The
+// results of each job are saved to their own file, and whichever process
+// finds all of them saved merges them into the summary of the sweep.
+//
+// All of the processes must be started with the same arguments and input
+// files, as the jobs are known by their position in the sweep. To run the
+// sweep again, the files starting with the prefix must be removed.
+class SharedSweep {
+ public:
+  explicit SharedSweep(const std::string& prefix);
+
+  // Returns true if this process is the one to run the job.
+  bool claim(size_t job) const;
+
+  void save(size_t job, const std::string& results) const;
+
+  // Merges the results of the jobs into the summary, if they have all been
+  // saved and no other process has merged them. Returns true if it did.
+  bool merge(size_t jobs) const;
+
+  inline const std::string& getPrefix() const { return prefix; }
+
+ private:
+  std::string getJobFile(size_t job, const char* extension) const;
+
+  static bool createExclusive(const std::string& file,
+                              const std::string& contents);
+  static bool write(const std::string& file, const std::string& contents);
+
+  std::string prefix;
+};
+
+#endif
@@ -25,8 +25,6 @@
 
 #include <cstdio>
 
-#include "Edge.h"
-
 struct GlobalStats {
   size_t ConnectionRequests;
   size_t ConnectionSuccesses;
@@ -40,8 +38,11 @@ struct GlobalStats {
   double aseNoiseTotal;
   double xpmNoiseTotal;
   double fwmNoiseTotal;
+  double qFactorTotal;
   double totalSetupDelay;
   double raRunTime;
+  size_t candidateSearches;
+  size_t candidateFallbacks;
 };
 
 struct EdgeStats {
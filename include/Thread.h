@@ -27,6 +27,7 @@
 
 #include <cmath>
 #include <cstdio>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <limits>
@@ -36,14 +37,28 @@
 #include <vector>
 
 #include "AlgorithmParameters.h"
+#include "BatchMeans.h"
+#include "Checkpoint.h"
+#include "DPArena.h"
 #include "ErrorCodes.h"
 #include "EstablishedConnections.h"
+#ifdef PROFILE_EVENTS
+#include "EventProfiler.h"
+#endif
+#include "EventPool.h"
 #include "EventQueue.h"
+#include "JobScheduler.h"
 #include "MessageLogger.h"
 #include "QualityParameters.h"
+#include "Replications.h"
+#include "RequestTrace.h"
 #include "ResourceManager.h"
 #include "Router.h"
 #include "Stats.h"
+#include "Topology.h"
+#include "UsagePathCache.h"
+#include "WarmupDetector.h"
+#include "WorkerPool.h"
 #include "Workstation.h"
 
 class Thread {
@@ -60,6 +75,7 @@ class Thread {
   inline void addWorkstation(Workstation* w) { workstations.push_back(w); }\
   inline void setGlobalTime(double t) { globalTime = t; }
   inline void setControllerIndex(size_t ci) { controllerIndex = ci; }
+  inline size_t getControllerIndex() const { return controllerIndex; }
 
   inline GlobalStats& getGlobalStats() { return stats; }
   inline QualityParameters& getQualityParams() { return qualityParams; }
@@ -78,6 +94,7 @@ class Thread {
   inline size_t getNumberOfRouters() const { return numberOfRouters; }
   inline size_t getNumberOfWorkstations() const { return numberOfWorkstations; }
   inline size_t getNumberOfEdges() const { return numberOfEdges; }
+  inline const Topology* getNetwork() const { return network; }
   inline size_t getNumberOfWavelengths() const { return numOfWavelengths; }
   inline size_t getRandomSeed() const { return randomSeed; }
 
@@ -199,12 +216,30 @@ class Thread {
 
   inline MessageLogger* getLogger() { return logger; };
 
+  inline WorkerPool* getWorkers() { return workers; };
+
+  inline UsagePathCache* getUsagePaths() { return usagePaths; };
+
+  inline DPArena* getDPArena() { return dpArena; };
+
+  static std::vector<std::string> split(const std::string& s, char delimiter);
+
  private:
   std::vector<Router*> routers;
   std::vector<Workstation*> workstations;
 
-  void setTopologyParameters(const std::string& f);
-  void setWorkstationParameters(const std::string& f);
+  // The topology is read in once by thread zero and shared by all of the
+  // threads, each thread only keeps the state of the network that changes
+  // during a run.
+  const Topology* network;
+  void buildNetwork();
+
+  // The state of every wavelength of every edge, in one block per thread
+  // with the wavelengths of each edge next to each other.
+  EdgeStatus* edgeStatus;
+  long long int* edgeSessions;
+  double* edgeDegredation;
+  EdgeStats* edgeStats;
 
   std::default_random_engine generator;
 
@@ -215,6 +250,75 @@ class Thread {
   std::exponential_distribution<double> generateArrivalInterval;
 
   EventQueue* queue;
+  EventPool* pool;
+
+  // Teardown hops that were scheduled in one batch by the hop fast forward
+  // mode. They are merged with the event queue in runThread.
+  std::priority_queue<Event> teardownLane;
+
+  // Events for the current time (i.e. the zero delay hops of IA and DP) that
+  // are handled in order without going through the event queue.
+  std::deque<Event> immediateLane;
+
+  void scheduleEvent(const Event& e);
+
+  WorkerPool* workers;
+
+  // The LORA and PABR paths of the thread, which are valid until the link
+  // usage is next updated.
+  UsagePathCache* usagePaths;
+
+  // The search of the DP algorithm, which is reused for each request.
+  DPArena* dpArena;
+
+  ReplicationSet* currentReplications;
+  size_t currentReplication;
+
+  // Ends the traffic of a run early once its estimates have converged, in
+  // which case stopTime is moved back from the ten hour mark.
+  BatchMeans* convergence;
+  double stopTime;
+
+  // Removes the initial transient of a run from the stats once the network
+  // has reached its steady state.
+  WarmupDetector* warmup;
+
+  double calculateUtilisation() const;
+
+  // Probes, confirmations and collisions that have been scheduled but not
+  // handled yet. Checkpoints are only taken when there are none, so that
+  // every event left on the queue can be saved on its own.
+  size_t transientEvents;
+  double nextCheckpoint;
+
+  inline bool isQuiescent() const {
+    return transientEvents == 0 && immediateLane.empty() == true &&
+           teardownLane.empty() == true;
+  }
+
+  std::string getCheckpointFile() const;
+  std::vector<size_t> getCheckpointConfig() const;
+  void saveCheckpoint();
+  bool restoreCheckpoint();
+
+  void prepareRun();
+
+  // Feeds the connection requests from a recorded trace instead of drawing
+  // them from the generator, so that every algorithm sees the same workload.
+  // The cursor holds the next request of each workstation.
+  RequestTrace* trace;
+  std::vector<size_t> traceCursor;
+
+  std::string getTraceFile() const;
+
+#ifdef PROFILE_EVENTS
+  // Counts and times the events handled by the run.
+  EventProfiler profiler;
+
+  inline size_t getPendingEvents() const {
+    return queue->getSize() + immediateLane.size() + teardownLane.size();
+  }
+#endif
 
   double globalTime;
 
@@ -243,6 +347,9 @@ class Thread {
   void destroy_connection_probe(DestroyConnectionProbeEvent* dcpe);
   void collision_notification(CollisionNotificationEvent* cne);
 
+  void forwardProbe(CreateConnectionProbeEvent* ccpe);
+  void forwardTeardown(DestroyConnectionProbeEvent* dcpe);
+
   GlobalStats stats;
 
   bool isLoadPrevious;
@@ -294,6 +401,11 @@ class Thread {
 
   QualityParameters qualityParams;
   void setQualityParameters(const std::string& f);
+  template <typename T>
+  void setQualityOption(const std::string& name, const std::string& value,
+                        int minimum, int maximum, T fallback, T& option);
+  void setQualityOption(const std::string& name, const std::string& value,
+                        double& option);
 
   size_t randomSeed;
 
@@ -334,8 +446,6 @@ class Thread {
                   long long int probesToSend, long long int probeStart,
                   long long int probesSkipped);
 
-  std::vector<std::string> split(const std::string& s, char delimiter);
-
   int runCount;
   int maxRunCount;
 
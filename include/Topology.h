@@ -0,0 +1,99 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      Topology.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the Topology, the
+//					static description of the network that is read
+//					in once and then shared by all of the threads.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Static topology shared between the threads.
+//
+// ____________________________________________________________________________
+
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// The routers, edges and workstations of the network. It is never changed
+// once it has been read in, so the threads can share it without locking, and
+// it is kept until the program ends so that every scenario of a sweep on the
+// same network reads the files only once.
+// The edges are kept in compressed sparse row form: the edges leaving router
+// r are the ones from getFirstEdge(r) up to getFirstEdge(r + 1), in the
+// order in which they are listed in the topology file.
+class Topology {
+ public:
+  // Returns the topology read in from the files, reading them the first
+  // time they are asked for. Only called by thread zero.
+  static const Topology* load(const std::string& topologyFile,
+                              const std::string& workstationFile);
+
+  // Deletes all of the topologies that have been read in.
+  static void clearCache();
+
+  inline size_t getNumberOfRouters() const { return numberOfRouters; }
+  inline size_t getNumberOfEdges() const { return edgeDestination.size(); }
+  inline size_t getNumberOfWorkstations() const { return parentRouter.size(); }
+
+  inline size_t getFirstEdge(size_t r) const { return firstEdge[r]; }
+  inline size_t getEdgeDestination(size_t e) const {
+    return edgeDestination[e];
+  }
+  inline size_t getEdgeSpans(size_t e) const { return edgeSpans[e]; }
+
+  // Row of the adjacency matrix of the router, holding the position of the
+  // edge to each router among the edges of the router, or -1 if the routers
+  // are not adjacent.
+  inline const long long int* getAdjacency(size_t r) const {
+    return &adjacency[r * numberOfRouters];
+  }
+
+  inline size_t getParentRouter(size_t w) const { return parentRouter[w]; }
+
+  // Hash of the contents of the topology file, for the files that are
+  // worked out from the topology and kept between runs.
+  inline unsigned long long getHash() const { return hash; }
+
+#ifndef NO_ALLEGRO
+  inline int getXPercent(size_t r) const { return xPercent[r]; }
+  inline int getYPercent(size_t r) const { return yPercent[r]; }
+#endif
+
+ private:
+  Topology(const std::string& topologyFile, const std::string& workstationFile);
+
+  void readTopology(const std::string& f);
+  void readWorkstations(const std::string& f);
+
+  std::string topologyFile;
+  std::string workstationFile;
+
+  size_t numberOfRouters;
+
+  unsigned long long hash;
+
+  std::vector<size_t> firstEdge;
+  std::vector<size_t> edgeDestination;
+  std::vector<size_t> edgeSpans;
+
+  std::vector<long long int> adjacency;
+
+  std::vector<size_t> parentRouter;
+
+#ifndef NO_ALLEGRO
+  std::vector<int> xPercent;
+  std::vector<int> yPercent;
+#endif
+};
+
+#endif
@@ -0,0 +1,94 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      UsagePathCache.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the UsagePathCache,
+//					which keeps the k shortest paths of the LORA
+//					and PABR algorithms between the updates of the
+//					link usage of a thread.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    LORA and PABR paths cached between usage updates.
+//  10/18/2026  v2.1    Searches kept to be continued for a larger k.
+//
+// ____________________________________________________________________________
+
+#ifndef USAGE_PATH_CACHE_H
+#define USAGE_PATH_CACHE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "KShortestPathStructs.h"
+
+class KShortestPaths;
+
+// The cost of an edge for LORA and PABR only depends on its usage, which only
+// changes when the usage is updated. Each update starts a new epoch, and the
+// paths cached in an earlier epoch are treated as missing, so invalidating
+// the cache does not need to touch the entries.
+//
+// The callers change and delete the paths they are given, so the cache keeps
+// its own copy. Each thread has its own cache, so there is no locking.
+//
+// PABR asks for more paths on each of its iterations. The search of the k
+// shortest paths of a pair is kept for the epoch as well, so that a larger k
+// continues the search from its candidates instead of starting it again.
+class UsagePathCache {
+ public:
+  explicit UsagePathCache(size_t routers);
+  ~UsagePathCache();
+
+  inline void invalidate() { ++epoch; }
+
+  // Returns a copy of the first k paths, or nullptr if they have not been
+  // calculated since the usage was last updated.
+  kShortestPathReturn* find(size_t src, size_t dest, size_t k) const;
+
+  // Keeps a copy of the k shortest paths.
+  void insert(size_t src, size_t dest, size_t k,
+              const kShortestPathReturn* paths);
+
+  // Returns the search of the pair, or nullptr if it has not been started
+  // since the usage was last updated.
+  KShortestPaths* findSearch(size_t src, size_t dest) const;
+
+  // Keeps the search of the pair, the cache deletes it.
+  void insertSearch(size_t src, size_t dest, KShortestPaths* search);
+
+ private:
+  struct Entry {
+    size_t k;
+    size_t found;
+    kShortestPathReturn* paths;
+  };
+
+  struct Pair {
+    size_t epoch;
+    std::vector<Entry> entries;
+    KShortestPaths* search;
+  };
+
+  // Deletes the paths and the search of an earlier epoch.
+  void renew(Pair& pair);
+
+  kShortestPathReturn* copyPaths(const kShortestPathReturn* paths,
+                                 size_t k) const;
+
+  static void deletePaths(kShortestPathReturn* paths);
+
+  size_t routers;
+  size_t epoch;
+
+  // The paths of every pair of routers, there are only ever a handful for
+  // each pair (one for each value of k that is used in the epoch).
+  std::vector<Pair> pairs;
+};
+
+#endif
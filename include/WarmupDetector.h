@@ -0,0 +1,80 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      WarmupDetector.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the WarmupDetector,
+//					which finds the end of the initial transient of a
+//					run with the MSER-5 rule (K. White, 1997).
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    MSER-5 detection of the warm-up of a run.
+//
+// ____________________________________________________________________________
+
+#ifndef WARMUP_DETECTOR_H
+#define WARMUP_DETECTOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Checkpoint.h"
+#include "Stats.h"
+
+// Samples the blocking and link utilisation every sampleInterval connection
+// requests. The samples are averaged in batches of five, and the truncation
+// point is the number of batches whose deletion minimises the standard
+// error of the remaining ones. A snapshot of the stats is kept for every
+// sample, so that the transient can be removed from the totals exactly.
+class WarmupDetector {
+ public:
+  explicit WarmupDetector(size_t sampleInterval);
+
+  void reset(const GlobalStats& stats, double time);
+
+  inline bool isSampleDue(const GlobalStats& stats) const {
+    return stats.ConnectionRequests - snapshots.back().ConnectionRequests >=
+           sampleInterval;
+  }
+
+  // Returns true if the end of the warm-up was found with this sample.
+  bool sample(const GlobalStats& stats, double utilisation, double time);
+
+  void removeTransient(GlobalStats& stats) const;
+
+  void saveCheckpoint(CheckpointWriter& out) const;
+  void loadCheckpoint(CheckpointReader& in);
+
+  inline bool isComplete() const { return complete; }
+  inline double getWarmupTime() const { return times[truncation]; }
+  inline size_t getDeletedRequests() const {
+    return snapshots[truncation].ConnectionSuccesses +
+           snapshots[truncation].CollisionFailures +
+           snapshots[truncation].QualityFailures +
+           snapshots[truncation].NoPathFailures;
+  }
+
+ private:
+  static size_t truncationPoint(const std::vector<double>& samples);
+
+  size_t sampleInterval;
+
+  bool complete;
+  size_t truncation;
+
+  std::vector<GlobalStats> snapshots;
+  std::vector<double> times;
+
+  std::vector<double> blocking;
+  std::vector<double> utilisation;
+
+  static const size_t BATCH;
+  static const size_t MIN_BATCHES;
+};
+
+#endif
@@ -0,0 +1,73 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      WorkerPool.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the declaration of the WorkerPool, which
+//					splits the independent iterations of a loop inside
+//					of a single simulation run across several cores.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Workers sharing the work of a single run.
+//
+// ____________________________________________________________________________
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <cstddef>
+#include <vector>
+
+#include "pthread.h"
+
+// Runs the iterations of a loop on a fixed set of pthreads, with the calling
+// thread taking a share of the iterations as well. Each iteration must only
+// write to its own outputs, so that the results of the simulation do not
+// depend on the number of workers.
+class WorkerPool {
+ public:
+  typedef void (*Task)(size_t index, void* arg);
+
+  // The workers are pinned to the cores of the affinity slots that follow
+  // the given one, the first slot belongs to the calling thread.
+  WorkerPool(size_t workers, size_t firstSlot);
+  ~WorkerPool();
+
+  void run(size_t count, Task task, void* arg);
+
+  inline size_t getNumberOfWorkers() const { return workers.size() + 1; }
+
+ private:
+  struct WorkerArgs {
+    WorkerPool* pool;
+    size_t id;
+  };
+
+  static void* workerMain(void* p);
+
+  void runShare(size_t id);
+
+  std::vector<pthread_t> workers;
+  std::vector<WorkerArgs> workerArgs;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t start;
+  pthread_cond_t done;
+
+  size_t firstSlot;
+
+  Task task;
+  void* arg;
+  size_t count;
+
+  size_t generation;
+  size_t pending;
+  bool shutdown;
+};
+
+#endif
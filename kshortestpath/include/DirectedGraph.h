@@ -88,6 +88,11 @@ class DirectedGraph {
     (*m_pDirectedEdges)[ConfigCenter::SizeT_Pair(i, j)] = val;
   }
 
+  // The edges in order of their source and then their target.
+  const ConfigCenter::SizeT_Pair_Double_Map& GetEdges() const {
+    return *m_pDirectedEdges;
+  }
+
  private:
   ConfigCenter::SizeT_Pair_Double_Map* m_pDirectedEdges;
 
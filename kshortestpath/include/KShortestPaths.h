@@ -13,6 +13,8 @@
 //
 //  11/23/2006   Yan   Initial Version
 //  04/19/2019   Hahn  Modern OS/Compiler Changes
+//  10/18/2026   Hahn  Masks of removed edges instead of graph copies
+//  10/18/2026   Hahn  Searches that can be continued for a larger k
 //
 //  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //  Copyright Notice:
@@ -34,18 +36,39 @@
 
 #include "DirectedGraph.h"
 #include "DirectedPath.h"
+#include "KShortestPathStructs.h"
 #include "ShortestPath.h"
 
+// ____________________________________________________________________________
+//
+// Class:       KShortestPaths
+//
+// Purpose:     KShortestPaths finds the k shortest loopless paths by deviating
+//              from the paths that have already been found.
+//
+// Notes:		The graph and its reverse are built once. The edges
+//				that are removed from the graph while looking for
+//				the next paths are set in a mask over the edges of
+//				the graph, rather than set on a copy of it.
+//
+//				The candidates are kept after a search, so the
+//				search can be continued for a larger k.
+//
+// ____________________________________________________________________________
 class KShortestPaths {
  public:
-  KShortestPaths(const DirectedGraph& rGraph, size_t nSource, size_t nTerminal,
-                 size_t nTopk);
+  KShortestPaths(const kShortestPathParms& params);
   virtual ~KShortestPaths();
 
   std::vector<DirectedPath*> GetTopKShortestPaths();
 
+  // The first k paths, the search is continued from the paths found so far
+  // if there are not yet k of them.
+  std::vector<DirectedPath*> GetTopKShortestPaths(size_t k);
+
  private:  // methods
   void _SearchTopKShortestPaths();
+  void _DeviateFromPath(DirectedPath* cur_path);
 
   void _DetermineCost2Target(std::vector<size_t> vertices_list,
                              size_t deviated_node_id);
@@ -53,17 +76,27 @@ class KShortestPaths {
                                    size_t start_node_id, size_t end_node_id,
                                    bool is_deviated_node = false);
   void _UpdateWeight4CostUntilNode(size_t node_id);
-  void _ReverseEdgesInGraph(DirectedGraph& g);
   bool _EdgeHasBeenUsed(size_t start_node_id, size_t end_node_id);
+  double _GetWeight(size_t start_node_id, size_t end_node_id) const;
 
  private:  // members
   size_t m_nTopK;
   size_t m_nSourceNodeId;
   size_t m_nTargetNodeId;
 
-  const DirectedGraph& m_rGraph;
-  DirectedGraph* m_pIntermediateGraph;
-  ShortestPath* m_pShortestPath4IntermediateGraph;
+  // Whether the shortest path has been looked for, and the number of the
+  // results whose deviations have been added to the candidates.
+  bool m_bSearchStarted;
+  size_t m_nDeviatedPaths;
+
+  ShortestPath m_Graph;
+
+  // The reverse of the graph, which holds the cost of each node to the
+  // target in the intermediate graph.
+  ShortestPath m_ReverseGraph;
+
+  // The edges of the graph that are not in the intermediate graph.
+  std::vector<char> m_vRemovedEdges;
 
   // variable to store the top shortest paths
   std::vector<DirectedPath*> m_vTopKShortestPaths;
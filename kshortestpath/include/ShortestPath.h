@@ -14,6 +14,8 @@
 //
 //  11/23/2006   Yan   Initial Version
 //  04/19/2019   Hahn  Modern OS/Compiler Changes
+//  10/18/2026   Hahn  Compressed sparse row graph and native Dijkstra
+//  10/18/2026   Hahn  Reversed graphs and masks of removed edges
 
 //
 //  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -32,46 +34,105 @@
 #ifndef _QYSHORTETSPATH_H_
 #define _QYSHORTETSPATH_H_
 
-#include <map>
 #include <vector>
 
 #include "ConfigCenter.h"
 #include "DirectedGraph.h"
 #include "DirectedPath.h"
+#include "KShortestPathStructs.h"
 
+// ____________________________________________________________________________
+//
+// Class:       ShortestPath
+//
+// Purpose:     ShortestPath runs Dijkstra over a compressed sparse row copy of
+//              the graph, the out edges of each vertex are next to each other
+//              in order of their target.
+//
+// Notes:		The arrays are kept between the calls, so an object
+//				that is built again for the next graph does not
+//				allocate once it has grown to the size of the graph.
+//				The heap is a 4-ary heap that breaks the ties in the
+//				same way as the one of Boost, so the paths are the
+//				same as when the Boost Graph Library was used.
+//
+// ____________________________________________________________________________
 class ShortestPath {
  public:
+  ShortestPath();
   ShortestPath(const DirectedGraph& rGraph);
   virtual ~ShortestPath();
 
+  // Builds the graph from the edge list, when an edge is listed twice the
+  // first one is used.
+  void Build(const kShortestPathParms& params);
+  void Build(const DirectedGraph& rGraph);
+
+  // Builds the graph with the edges of another one reversed, the in edges of
+  // each vertex are in order of their source.
+  void BuildReverse(const ShortestPath& rGraph);
+
   DirectedPath* GetShortestPath(size_t nSourceNodeId, size_t nTargetNodeId);
   void ConstructPathTree(size_t nSourceNodeId);
 
-  double GetDistance(size_t i) {
-    return m_distanceMap.count(i) ? m_distanceMap[i]
-                                  : DirectedGraph::DISCONNECT;
-  }
-  void SetDistance(size_t i, double new_value) { m_distanceMap[i] = new_value; }
+  // Skips the edges that are set in the mask, which is indexed by the edges
+  // of the graph this one was reversed from (or of this one otherwise).
+  void ConstructPathTree(size_t nSourceNodeId,
+                         const std::vector<char>& vRemovedEdges);
 
-  size_t GetNextNodeId(size_t i) {
-    return m_distanceMap.count(i) ? m_nextNodeMap[i] : DirectedGraph::DEADEND;
+  // Copies the vertices of the shortest path to the target and returns its
+  // length, or returns 0 if there is no path or it is longer than nMaxLength.
+  size_t CopyShortestPath(size_t nTargetNodeId, size_t* pVertices,
+                          size_t nMaxLength) const;
+
+  double GetDistance(size_t i) const { return m_vDistance[i]; }
+  void SetDistance(size_t i, double new_value) { m_vDistance[i] = new_value; }
+
+  size_t GetNextNodeId(size_t i) const { return m_vPredecessor[i]; }
+  void SetNextNodeId(size_t i, size_t val) { m_vPredecessor[i] = val; }
+
+  size_t GetNumberOfVertices() const { return m_nNumberOfVertices; }
+  size_t GetNumberOfEdges() const { return m_vTargets.size(); }
+
+  // The out edges of vertex i are GetFirstEdge(i) to GetFirstEdge(i + 1).
+  size_t GetFirstEdge(size_t i) const { return m_vOffsets[i]; }
+  size_t GetEdgeTarget(size_t e) const { return m_vTargets[e]; }
+  double GetEdgeWeight(size_t e) const { return m_vWeights[e]; }
+
+  // The edge of the graph this one was reversed from.
+  size_t GetEdgeId(size_t e) const {
+    return m_vEdgeIds.empty() ? e : m_vEdgeIds[e];
   }
-  void SetNextNodeId(size_t i, size_t val) { m_nextNodeMap[i] = val; }
 
  private:  // methods
-  void _Init();
-  void _DijkstraShortestPathsAlg();
+  void _Init(size_t nNumberOfVertices);
+  void _DijkstraShortestPathsAlg(const std::vector<char>* pRemovedEdges);
   DirectedPath* _GetShortestPath(size_t nTargetNodeId);
 
+  void _HeapPush(size_t v);
+  void _HeapPop();
+  void _HeapUp(size_t index);
+  void _HeapDown();
+
  private:  // members
-  std::vector<ConfigCenter::SizeT_Pair> m_vEdges;
+  size_t m_nNumberOfVertices;
+
+  // The out edges of vertex i are m_vOffsets[i] to m_vOffsets[i + 1].
+  std::vector<size_t> m_vOffsets;
+  std::vector<size_t> m_vTargets;
   std::vector<double> m_vWeights;
 
-  std::map<size_t, double> m_distanceMap;
-  std::map<size_t, size_t> m_nextNodeMap;
+  // Only used when the graph is reversed, otherwise the edges are their own.
+  std::vector<size_t> m_vEdgeIds;
+
+  std::vector<double> m_vDistance;
+  std::vector<size_t> m_vPredecessor;
+
+  std::vector<size_t> m_vHeap;
+  std::vector<size_t> m_vIndexInHeap;
+  std::vector<unsigned char> m_vColor;
 
   size_t m_nSourceNodeId;
-  const DirectedGraph& m_rGraph;
 };
 
 #endif  //_QYSHORTETSPATH_H_
@@ -13,6 +13,8 @@
 //
 //  11/23/2006   Yan   Initial Version
 //  04/19/2019   Hahn  Modern OS/Compiler Changes
+//  10/18/2026   Hahn  Masks of removed edges instead of graph copies
+//  10/18/2026   Hahn  Searches that can be continued for a larger k
 //
 //  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //  Copyright Notice:
@@ -27,6 +29,7 @@
 //
 // ____________________________________________________________________________
 
+#include <algorithm>
 #include <iostream>
 
 #include "KShortestPaths.h"
@@ -35,14 +38,15 @@
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-KShortestPaths::KShortestPaths(const DirectedGraph& rGraph, size_t nSource,
-                               size_t nTerminal, size_t nTopk)
-    : m_rGraph(rGraph),
-      m_nSourceNodeId(nSource),
-      m_nTargetNodeId(nTerminal),
-      m_nTopK(nTopk) {
-  m_pIntermediateGraph = nullptr;
-  m_pShortestPath4IntermediateGraph = nullptr;
+KShortestPaths::KShortestPaths(const kShortestPathParms& params)
+    : m_nTopK(params.k_paths),
+      m_nSourceNodeId(params.src_node),
+      m_nTargetNodeId(params.dest_node),
+      m_bSearchStarted(false),
+      m_nDeviatedPaths(0) {
+  m_Graph.Build(params);
+  m_ReverseGraph.BuildReverse(m_Graph);
+  m_vRemovedEdges.resize(m_Graph.GetNumberOfEdges());
 }
 
 KShortestPaths::~KShortestPaths() {
@@ -56,51 +60,72 @@ KShortestPaths::~KShortestPaths() {
        pos != m_candidatePathsSet.end(); ++pos) {
     delete *pos;
   }
-  //
-  if (m_pShortestPath4IntermediateGraph != nullptr) {
-    delete m_pShortestPath4IntermediateGraph;
-  }
 }
 
-/************************************************************************/
-/* Get the top k shortest paths.
-/************************************************************************/
+/************************************************************************
+ * Get the top k shortest paths.
+ ************************************************************************/
 std::vector<DirectedPath*> KShortestPaths::GetTopKShortestPaths() {
   _SearchTopKShortestPaths();
   return m_vTopKShortestPaths;
 }
 
-/************************************************************************/
-/*  The main function to do searching
-/************************************************************************/
+/************************************************************************
+ * Get the first k shortest paths, continuing the search if needed.
+ ************************************************************************/
+std::vector<DirectedPath*> KShortestPaths::GetTopKShortestPaths(size_t k) {
+  if (k > m_nTopK) m_nTopK = k;
+
+  _SearchTopKShortestPaths();
+
+  if (k >= m_vTopKShortestPaths.size()) return m_vTopKShortestPaths;
+
+  return std::vector<DirectedPath*>(m_vTopKShortestPaths.begin(),
+                                    m_vTopKShortestPaths.begin() + k);
+}
+
+/************************************************************************
+ *  The main function to do searching
+ ************************************************************************/
 void KShortestPaths::_SearchTopKShortestPaths() {
   //////////////////////////////////////////////////////////////////////////
   // first, find the shortest path in the graph
-  m_pShortestPath4IntermediateGraph = new ShortestPath(m_rGraph);
-  DirectedPath* the_shortest_path =
-      m_pShortestPath4IntermediateGraph->GetShortestPath(m_nSourceNodeId,
-                                                         m_nTargetNodeId);
+  if (m_bSearchStarted == false) {
+    m_bSearchStarted = true;
 
-  // check the validity of the result
-  if (the_shortest_path->GetId() < 0)  // the shortest path doesn't exist!
-  {
-    // Added by Tim Hahn to fix a memory leak
-    delete the_shortest_path;
+    DirectedPath* the_shortest_path =
+        m_Graph.GetShortestPath(m_nSourceNodeId, m_nTargetNodeId);
 
-    return;
-  } else {
-    the_shortest_path->SetId(0);
-  }
+    // check the validity of the result
+    if (the_shortest_path->GetLength() == 0) {
+      // the shortest path doesn't exist!
+      // Added by Tim Hahn to fix a memory leak
+      delete the_shortest_path;
 
-  // update the size_termediate variables
-  m_candidatePathsSet.insert(the_shortest_path);
-  m_pathDeviatedNodeMap.insert(std::pair<size_t, size_t>(0, m_nSourceNodeId));
+      return;
+    } else {
+      the_shortest_path->SetId(0);
+    }
+
+    // update the size_termediate variables
+    m_candidatePathsSet.insert(the_shortest_path);
+    m_pathDeviatedNodeMap.insert(
+        std::pair<size_t, size_t>(0, m_nSourceNodeId));
+  }
 
   //////////////////////////////////////////////////////////////////////////
   // second, start to find the other results
+  while (m_vTopKShortestPaths.size() < m_nTopK) {
+    // The deviations from the last result are only added once more paths
+    // are needed, so that a search that found its k paths can be continued
+    // from where it stopped.
+    if (m_nDeviatedPaths < m_vTopKShortestPaths.size()) {
+      _DeviateFromPath(m_vTopKShortestPaths.back());
+      ++m_nDeviatedPaths;
+    }
+
+    if (m_candidatePathsSet.size() == 0) break;
 
-  size_t cur_path_id = 0;
-  while (m_candidatePathsSet.size() != 0 && cur_path_id < m_nTopK) {
     // Fetch the smallest one from a queue of candidates;
     // Note that it's one of results.
     DirectedPath* cur_path = (*m_candidatePathsSet.begin());
@@ -108,47 +133,43 @@ void KShortestPaths::_SearchTopKShortestPaths() {
 
     // Put this candidate into the result list.
     m_vTopKShortestPaths.push_back(cur_path);
+  }
+}
 
-    // Optimization added by Tim Hahn. If we have found the k shortest paths,
-    // why not return?
-    if (m_vTopKShortestPaths.size() == m_nTopK) break;
-
-    ++cur_path_id;
-
-    // initiate temporal variables
-    size_t deviated_node_id = m_pathDeviatedNodeMap[cur_path->GetId()];
-    std::vector<size_t> node_list_in_path = cur_path->GetVertexList();
-
-    // Construct a temporal graph in order to determine the next shortest paths
-    m_pIntermediateGraph = new DirectedGraph(m_rGraph);
-
-    // Determine the costs of nodes in the graph
-    _DetermineCost2Target(node_list_in_path, deviated_node_id);
-
-    // Iterations for the restoration of nodes and edges
-    size_t path_length = node_list_in_path.size();
-    size_t i = 0;
-    for (i = path_length - 2;
-         i >= 0 && node_list_in_path[i] != deviated_node_id; --i) {
-      _RestoreEdges4CostAjustment(node_list_in_path, node_list_in_path[i],
-                                  node_list_in_path[i + 1]);
-    }
-
-    // Call _Restore4CostAjustment again for the deviated_node
-    _RestoreEdges4CostAjustment(node_list_in_path, deviated_node_id,
-                                node_list_in_path[i + 1], true);
-
-    delete m_pIntermediateGraph;
+/************************************************************************
+ * Add the paths that deviate from a result to the candidates.
+ ************************************************************************/
+void KShortestPaths::_DeviateFromPath(DirectedPath* cur_path) {
+  // initiate temporal variables
+  size_t deviated_node_id = m_pathDeviatedNodeMap[cur_path->GetId()];
+  std::vector<size_t> node_list_in_path = cur_path->GetVertexList();
+
+  // Start the intermediate graph from the whole graph again
+  std::fill(m_vRemovedEdges.begin(), m_vRemovedEdges.end(), 0);
+
+  // Determine the costs of nodes in the graph
+  _DetermineCost2Target(node_list_in_path, deviated_node_id);
+
+  // Iterations for the restoration of nodes and edges
+  size_t path_length = node_list_in_path.size();
+  size_t i = 0;
+  for (i = path_length - 2;
+       i >= 0 && node_list_in_path[i] != deviated_node_id; --i) {
+    _RestoreEdges4CostAjustment(node_list_in_path, node_list_in_path[i],
+                                node_list_in_path[i + 1]);
   }
+
+  // Call _Restore4CostAjustment again for the deviated_node
+  _RestoreEdges4CostAjustment(node_list_in_path, deviated_node_id,
+                              node_list_in_path[i + 1], true);
 }
 
-/************************************************************************/
-/* Remove vertices in the input, and recalculate the
-/************************************************************************/
+/************************************************************************
+ * Remove vertices in the input, and recalculate the
+ ************************************************************************/
 void KShortestPaths::_DetermineCost2Target(std::vector<size_t> vertices_list,
                                            size_t deviated_node_id) {
   // first: generate a temporary graph with only parts of the original graph
-  size_t count4vertices = m_pIntermediateGraph->GetNumberOfVertices();
 
   /// remove edges according to the algorithm
   size_t count = vertices_list.size();
@@ -157,75 +178,56 @@ void KShortestPaths::_DetermineCost2Target(std::vector<size_t> vertices_list,
              // be kept.
   {
     size_t remove_node_id = vertices_list[i];
-    for (size_t j = 0; j < count4vertices; ++j) {
-      size_t cur_edges_count = m_pIntermediateGraph->GetNumberOfEdges();
-      if (m_pIntermediateGraph->GetWeight(remove_node_id, j) <
-          DirectedGraph::DISCONNECT) {
-        m_pIntermediateGraph->SetWeight(remove_node_id, j,
-                                        DirectedGraph::DISCONNECT);
-        --cur_edges_count;
-      }
-      m_pIntermediateGraph->SetNumberOfEdges(cur_edges_count);
+    for (size_t e = m_Graph.GetFirstEdge(remove_node_id);
+         e < m_Graph.GetFirstEdge(remove_node_id + 1); ++e) {
+      if (m_Graph.GetEdgeWeight(e) < DirectedGraph::DISCONNECT)
+        m_vRemovedEdges[e] = 1;
     }
   }
 
-  /// reverse the direction of edges in the temporary graph
-  _ReverseEdgesInGraph(*m_pIntermediateGraph);
-
-  // second: run the shortest paths algorithm, but with the target as m_nSource.
-  // run the shortest paths algorithm to get the cost of each nodes in the rest
-  // of the graph
-  if (m_pShortestPath4IntermediateGraph != nullptr) {
-    delete m_pShortestPath4IntermediateGraph;
-  }
-  m_pShortestPath4IntermediateGraph = new ShortestPath(*m_pIntermediateGraph);
-  m_pShortestPath4IntermediateGraph->ConstructPathTree(m_nTargetNodeId);
-
-  // third: reverse the edges in the graph again, go back to the original
-  _ReverseEdgesInGraph(*m_pIntermediateGraph);
+  // second: run the shortest paths algorithm on the reverse graph, with the
+  // target as the source, to get the cost of each node in the rest of the
+  // graph.
+  m_ReverseGraph.ConstructPathTree(m_nTargetNodeId, m_vRemovedEdges);
 }
 
-/************************************************************************/
-/* Restore edges connecting start_node to end_node
-/************************************************************************/
+/************************************************************************
+ * Restore edges connecting start_node to end_node
+ ************************************************************************/
 void KShortestPaths::_RestoreEdges4CostAjustment(
     std::vector<size_t> vertices_list, size_t start_node_id, size_t end_node_id,
     bool is_deviated_node) {
   /// first: restore the arcs from 'start_node_id' except that reaching
   /// 'end_node_id';
   // restore the arcs and recalculate the cost of relative nodes
-  size_t i;
   bool is_updated = false;
-  size_t count4vertices = m_pIntermediateGraph->GetNumberOfVertices();
-  for (i = 0; i < count4vertices; ++i) {
+  for (size_t e = m_Graph.GetFirstEdge(start_node_id);
+       e < m_Graph.GetFirstEdge(start_node_id + 1); ++e) {
+    size_t i = m_Graph.GetEdgeTarget(e);
     if (i == end_node_id || i == start_node_id) continue;
-    double edge_weight = m_rGraph.GetWeight(start_node_id, i);
+    double edge_weight = m_Graph.GetEdgeWeight(e);
     if (edge_weight < DirectedGraph::DISCONNECT) {
       if (is_deviated_node && _EdgeHasBeenUsed(start_node_id, i))
         continue;  //???
 
       // restore the edge from start_node_id to i;
-      m_pIntermediateGraph->SetWeight(
-          start_node_id, i,
-          edge_weight);  //??? correct? if the node cost below is 'disconnect'??
+      m_vRemovedEdges[e] = 0;
 
       // update the distance if the restored arc makes for a shorter path to the
       // target.
-      double node_cost = m_pShortestPath4IntermediateGraph->GetDistance(i);
+      double node_cost = m_ReverseGraph.GetDistance(i);
       if (node_cost < DirectedGraph::DISCONNECT &&
           (edge_weight + node_cost) <
-              m_pShortestPath4IntermediateGraph->GetDistance(start_node_id)) {
-        m_pShortestPath4IntermediateGraph->SetDistance(start_node_id,
-                                                       edge_weight + node_cost);
-        m_pShortestPath4IntermediateGraph->SetNextNodeId(start_node_id, i);
+              m_ReverseGraph.GetDistance(start_node_id)) {
+        m_ReverseGraph.SetDistance(start_node_id, edge_weight + node_cost);
+        m_ReverseGraph.SetNextNodeId(start_node_id, i);
         is_updated = true;
       }
     }
   }
 
   // if possible, correct the labels and update the paths pool
-  double cost_of_start_node =
-      m_pShortestPath4IntermediateGraph->GetDistance(start_node_id);
+  double cost_of_start_node = m_ReverseGraph.GetDistance(start_node_id);
 
   if (cost_of_start_node < DirectedGraph::DISCONNECT) {
     if (is_updated)
@@ -249,8 +251,7 @@ void KShortestPaths::_RestoreEdges4CostAjustment(
     size_t next_node_id = start_node_id;
     do {
       new_path.push_back(next_node_id);
-      next_node_id =
-          m_pShortestPath4IntermediateGraph->GetNextNodeId(next_node_id);
+      next_node_id = m_ReverseGraph.GetNextNodeId(next_node_id);
 
     } while (next_node_id != m_nTargetNodeId);
     new_path.push_back(m_nTargetNodeId);
@@ -259,7 +260,7 @@ void KShortestPaths::_RestoreEdges4CostAjustment(
     double cost_new_path = 0;
     size_t length_new_path = new_path.size();
     for (i = 0; i < length_new_path - 1; ++i) {
-      cost_new_path += m_rGraph.GetWeight(new_path[i], new_path[1 + i]);
+      cost_new_path += _GetWeight(new_path[i], new_path[1 + i]);
     }
 
     // Update the list of shortest paths
@@ -272,77 +273,81 @@ void KShortestPaths::_RestoreEdges4CostAjustment(
   }
 
   // second: restore the arc from 'start_node_id' to 'end_node_id';
-  double edge_weight = m_rGraph.GetWeight(start_node_id, end_node_id);
-  double cost_of_end_node =
-      m_pShortestPath4IntermediateGraph->GetDistance(end_node_id);
-
-  m_pIntermediateGraph->SetWeight(start_node_id, end_node_id, edge_weight);
+  double edge_weight = DirectedGraph::DISCONNECT;
+  double cost_of_end_node = m_ReverseGraph.GetDistance(end_node_id);
+
+  for (size_t e = m_Graph.GetFirstEdge(start_node_id);
+       e < m_Graph.GetFirstEdge(start_node_id + 1); ++e) {
+    if (m_Graph.GetEdgeTarget(e) == end_node_id) {
+      edge_weight = m_Graph.GetEdgeWeight(e);
+      m_vRemovedEdges[e] = 0;
+      break;
+    }
+  }
 
   if (cost_of_start_node > edge_weight + cost_of_end_node) {
-    m_pShortestPath4IntermediateGraph->SetDistance(
-        start_node_id, edge_weight + cost_of_end_node);
-    m_pShortestPath4IntermediateGraph->SetNextNodeId(start_node_id,
-                                                     end_node_id);
+    m_ReverseGraph.SetDistance(start_node_id, edge_weight + cost_of_end_node);
+    m_ReverseGraph.SetNextNodeId(start_node_id, end_node_id);
     //
     _UpdateWeight4CostUntilNode(start_node_id);
   }
 }
 
-/************************************************************************/
-/* Update the weight of arcs before node_id in the graph
-/* TODO: Is there any way to improve the function below!??
-/************************************************************************/
+/************************************************************************
+ * Update the weight of arcs before node_id in the graph
+ * TODO: Is there any way to improve the function below!??
+ ************************************************************************/
 void KShortestPaths::_UpdateWeight4CostUntilNode(size_t node_id) {
-  size_t count4vertices = m_pIntermediateGraph->GetNumberOfVertices();
   std::vector<size_t> candidate_node_list;
+  std::vector<char> in_candidate_list(m_Graph.GetNumberOfVertices(), 0);
   size_t cur_pos = 0;
   candidate_node_list.push_back(node_id);
+  in_candidate_list[node_id] = 1;
 
   do {
     size_t cur_node_id = candidate_node_list[cur_pos++];
 
-    for (size_t i = 0; i < count4vertices; ++i) {
-      double edge_weight = m_pIntermediateGraph->GetWeight(i, cur_node_id);
-      double cost_node = m_pShortestPath4IntermediateGraph->GetDistance(i);
-      double cost_cur_node =
-          m_pShortestPath4IntermediateGraph->GetDistance(cur_node_id);
+    // the in edges of the node, in order of their source
+    for (size_t e = m_ReverseGraph.GetFirstEdge(cur_node_id);
+         e < m_ReverseGraph.GetFirstEdge(cur_node_id + 1); ++e) {
+      if (m_vRemovedEdges[m_ReverseGraph.GetEdgeId(e)] != 0) continue;
+
+      size_t i = m_ReverseGraph.GetEdgeTarget(e);
+      double edge_weight = m_ReverseGraph.GetEdgeWeight(e);
+      double cost_node = m_ReverseGraph.GetDistance(i);
+      double cost_cur_node = m_ReverseGraph.GetDistance(cur_node_id);
 
       if (edge_weight < DirectedGraph::DISCONNECT &&
           cost_node > cost_cur_node + edge_weight) {
-        m_pShortestPath4IntermediateGraph->SetDistance(
-            i, cost_cur_node + edge_weight);
-        m_pShortestPath4IntermediateGraph->SetNextNodeId(i, cur_node_id);
+        m_ReverseGraph.SetDistance(i, cost_cur_node + edge_weight);
+        m_ReverseGraph.SetNextNodeId(i, cur_node_id);
 
-        if (std::find(candidate_node_list.begin(), candidate_node_list.end(),
-                      i) == candidate_node_list.end()) {
+        if (in_candidate_list[i] == 0) {
           candidate_node_list.push_back(i);
+          in_candidate_list[i] = 1;
         }
       }
     }
   } while (cur_pos < candidate_node_list.size());
 }
 
-/************************************************************************/
-/* Reverse directions of all edges in the graph
-/************************************************************************/
-void KShortestPaths::_ReverseEdgesInGraph(DirectedGraph& g) {
-  size_t i;
-  size_t count4vertices = g.GetNumberOfVertices();
-  for (i = 0; i < count4vertices; ++i) {
-    for (size_t j = 0; j < i; ++j) {
-      if (g.GetWeight(i, j) < DirectedGraph::DISCONNECT ||
-          g.GetWeight(j, i) < DirectedGraph::DISCONNECT) {
-        double dTmp = g.GetWeight(i, j);
-        g.SetWeight(i, j, g.GetWeight(j, i));
-        g.SetWeight(j, i, dTmp);
-      }
-    }
+/************************************************************************
+ * Get the weight of the edge from start_node to end_node in the graph
+ ************************************************************************/
+double KShortestPaths::_GetWeight(size_t start_node_id,
+                                  size_t end_node_id) const {
+  for (size_t e = m_Graph.GetFirstEdge(start_node_id);
+       e < m_Graph.GetFirstEdge(start_node_id + 1); ++e) {
+    if (m_Graph.GetEdgeTarget(e) == end_node_id)
+      return m_Graph.GetEdgeWeight(e);
   }
+
+  return DirectedGraph::DISCONNECT;
 }
 
-/************************************************************************/
-/* Check if the edge from start_node to end_node has been in the results or not
-/************************************************************************/
+/************************************************************************
+ * Check if the edge from start_node to end_node has been in the results or not
+ ************************************************************************/
 bool KShortestPaths::_EdgeHasBeenUsed(size_t start_node_id,
                                       size_t end_node_id) {
   size_t count_of_shortest_paths = m_vTopKShortestPaths.size();
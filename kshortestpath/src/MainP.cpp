@@ -12,6 +12,8 @@
 //  Revision History:
 //
 //  04/19/2019   Hahn  Modern OS/Compiler Changes
+//  10/18/2026   Hahn  Shortest paths to every node from a single search
+//  10/18/2026   Hahn  Searches of k shortest paths kept by the caller
 //
 //  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //  Copyright Notice:
@@ -34,51 +36,114 @@
 #ifdef __GNUC__
 extern "C" void calc_k_shortest_paths(const kShortestPathParms &params,
                                       kShortestPathReturn *retVal);
+extern "C" void calc_shortest_path_tree(const kShortestPathParms &params,
+                                        kShortestPathReturn *retVal);
+extern "C" KShortestPaths *create_k_shortest_paths(
+    const kShortestPathParms &params);
+extern "C" void continue_k_shortest_paths(KShortestPaths *search,
+                                          const kShortestPathParms &params,
+                                          kShortestPathReturn *retVal);
+extern "C" void delete_k_shortest_paths(KShortestPaths *search);
 #else
 extern "C" __declspec(dllexport) void calc_k_shortest_paths(
     const kShortestPathParms &params, kShortestPathReturn *retVal);
+extern "C" __declspec(dllexport) void calc_shortest_path_tree(
+    const kShortestPathParms &params, kShortestPathReturn *retVal);
+extern "C" __declspec(dllexport) KShortestPaths *create_k_shortest_paths(
+    const kShortestPathParms &params);
+extern "C" __declspec(dllexport) void continue_k_shortest_paths(
+    KShortestPaths *search, const kShortestPathParms &params,
+    kShortestPathReturn *retVal);
+extern "C" __declspec(dllexport) void delete_k_shortest_paths(
+    KShortestPaths *search);
 #endif
 
 void copyResults(std::vector<DirectedPath *> &topK_shortest_paths,
-                 const kShortestPathParms &params, kShortestPathReturn *retVal,
-                 bool dijkstra);
+                 const kShortestPathParms &params, kShortestPathReturn *retVal);
 
 void calc_k_shortest_paths(const kShortestPathParms &params,
                            kShortestPathReturn *retVal) {
-  DirectedGraph dg(params);
-
   if (params.k_paths == 1) {
-    std::vector<DirectedPath *> topK_shortest_paths;
-
-    ShortestPath sp(dg);
-
-    topK_shortest_paths.push_back(
-        sp.GetShortestPath(params.src_node, params.dest_node));
-
-    copyResults(topK_shortest_paths, params, retVal, true);
-
-    if (topK_shortest_paths.size() > 0) delete topK_shortest_paths[0];
+    // Each thread keeps its own arrays, so once they have grown to the size
+    // of the network the search does not allocate.
+    static thread_local ShortestPath sp;
+
+    sp.Build(params);
+    sp.ConstructPathTree(params.src_node);
+
+    size_t length = sp.CopyShortestPath(params.dest_node, retVal->pathinfo,
+                                        params.total_nodes - 1);
+
+    if (length > 0) {
+      retVal->pathcost[0] = sp.GetDistance(params.dest_node);
+      retVal->pathlen[0] = length;
+    } else {
+      retVal->pathcost[0] = std::numeric_limits<double>::infinity();
+      retVal->pathlen[0] = std::numeric_limits<size_t>::infinity();
+    }
   } else {
-    KShortestPaths ksp(dg, params.src_node, params.dest_node, params.k_paths);
+    KShortestPaths ksp(params);
 
     std::vector<DirectedPath *> topK_shortest_paths =
         ksp.GetTopKShortestPaths();
 
-    copyResults(topK_shortest_paths, params, retVal, false);
+    copyResults(topK_shortest_paths, params, retVal);
   }
 
   return;
 }
 
+// The shortest path from the source to each of the nodes, in the slot of the
+// node. They are the same paths that calc_k_shortest_paths finds for k = 1,
+// the destination and the number of paths are not used.
+void calc_shortest_path_tree(const kShortestPathParms &params,
+                             kShortestPathReturn *retVal) {
+  static thread_local ShortestPath sp;
+
+  sp.Build(params);
+  sp.ConstructPathTree(params.src_node);
+
+  for (size_t d = 0; d < params.total_nodes; ++d) {
+    size_t length = sp.CopyShortestPath(
+        d, &retVal->pathinfo[d * (params.total_nodes - 1)],
+        params.total_nodes - 1);
+
+    if (length > 0) {
+      retVal->pathcost[d] = sp.GetDistance(d);
+      retVal->pathlen[d] = length;
+    } else {
+      retVal->pathcost[d] = std::numeric_limits<double>::infinity();
+      retVal->pathlen[d] = std::numeric_limits<size_t>::infinity();
+    }
+  }
+}
+
+// A search of the k shortest paths that is kept by the caller, so that it can
+// be continued for a larger k instead of being started again. The paths are
+// the same that calc_k_shortest_paths finds for the same parameters.
+KShortestPaths *create_k_shortest_paths(const kShortestPathParms &params) {
+  return new KShortestPaths(params);
+}
+
+// The first k_paths paths of the search, the edges of the parameters are not
+// used, the graph is the one the search was created with.
+void continue_k_shortest_paths(KShortestPaths *search,
+                               const kShortestPathParms &params,
+                               kShortestPathReturn *retVal) {
+  std::vector<DirectedPath *> topK_shortest_paths =
+      search->GetTopKShortestPaths(params.k_paths);
+
+  copyResults(topK_shortest_paths, params, retVal);
+}
+
+void delete_k_shortest_paths(KShortestPaths *search) { delete search; }
+
 void copyResults(std::vector<DirectedPath *> &topK_shortest_paths,
-                 const kShortestPathParms &params, kShortestPathReturn *retVal,
-                 bool dijkstra) {
+                 const kShortestPathParms &params, kShortestPathReturn *retVal) {
   for (std::vector<DirectedPath *>::iterator iter = topK_shortest_paths.begin();
        iter != topK_shortest_paths.end(); ++iter) {
     if ((*iter)->GetLength() <= 0 ||
         (*iter)->GetLength() >= params.total_nodes) {
-      if (dijkstra == true) delete *iter;
-
       topK_shortest_paths.erase(iter);
 
       if (topK_shortest_paths.size() == 0)
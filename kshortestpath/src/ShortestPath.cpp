@@ -13,6 +13,7 @@
 //
 //  11/23/2006   Yan   Initial Version
 //  04/19/2019   Hahn  Modern OS/Compiler Changes
+//  10/18/2026   Hahn  Compressed sparse row graph and native Dijkstra
 //
 //  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //  Copyright Notice:
@@ -27,144 +28,412 @@
 //
 // ____________________________________________________________________________
 
-#include <iostream>
+#include "ShortestPath.h"
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
+// The arity of the heap, which is the same as the one used by Boost.
+static const size_t HEAP_ARITY = 4;
 
-#include "ShortestPath.h"
+static const size_t NOT_IN_HEAP = static_cast<size_t>(-1);
+
+enum VertexColor { WHITE, GRAY, BLACK };
+
+/************************************************************************
+ * Default Constructor
+ ************************************************************************/
+ShortestPath::ShortestPath() : m_nNumberOfVertices(0), m_nSourceNodeId(-1) {}
 
-typedef boost::adjacency_list<boost::listS, boost::vecS, boost::directedS,
-                              boost::no_property,
-                              boost::property<boost::edge_weight_t, double> >
-    Boost_Graph_Type;
-typedef boost::graph_traits<Boost_Graph_Type>::edge_descriptor Edge_Descriptor;
-typedef boost::graph_traits<Boost_Graph_Type>::vertex_descriptor
-    Vertex_Descriptor;
-
-/* Default Constructor
-/************************************************************************/
-ShortestPath::ShortestPath(const DirectedGraph& rGraph) : m_rGraph(rGraph) {
-  m_nSourceNodeId = -1;  // the source node id is 0 by default.
-  _Init();
+ShortestPath::ShortestPath(const DirectedGraph& rGraph)
+    : m_nNumberOfVertices(0), m_nSourceNodeId(-1) {
+  Build(rGraph);
 }
 
 ShortestPath::~ShortestPath() {}
 
-/************************************************************************/
-/* Initiate members
-/************************************************************************/
-void ShortestPath::_Init() {
-  size_t vertices_count = m_rGraph.GetNumberOfVertices();
-
-  // First: edges with weights
-  for (size_t i = 0; i != vertices_count; ++i) {
-    for (size_t j = 0; j != vertices_count; ++j) {
-      if (m_rGraph.GetWeight(i, j) != DirectedGraph::DISCONNECT) {
-        m_vEdges.push_back(ConfigCenter::Edge_Type(i, j));
-        m_vWeights.push_back(m_rGraph.GetWeight(i, j));
-      }
+/************************************************************************
+ * Initiate members
+ ************************************************************************/
+void ShortestPath::_Init(size_t nNumberOfVertices) {
+  m_nNumberOfVertices = nNumberOfVertices;
+  m_nSourceNodeId = -1;
+
+  m_vOffsets.assign(nNumberOfVertices + 1, 0);
+  m_vTargets.clear();
+  m_vWeights.clear();
+  m_vEdgeIds.clear();
+
+  m_vDistance.assign(nNumberOfVertices, DirectedGraph::DISCONNECT);
+  m_vPredecessor.assign(nNumberOfVertices, DirectedGraph::DEADEND);
+
+  m_vHeap.clear();
+  m_vIndexInHeap.resize(nNumberOfVertices);
+  m_vColor.resize(nNumberOfVertices);
+}
+
+/************************************************************************
+ * Build the graph from a directed graph, whose edges are already in
+ * order of their source and target.
+ ************************************************************************/
+void ShortestPath::Build(const DirectedGraph& rGraph) {
+  _Init(rGraph.GetNumberOfVertices());
+
+  const ConfigCenter::SizeT_Pair_Double_Map& edges = rGraph.GetEdges();
+
+  for (ConfigCenter::SizeT_Pair_Double_Map::const_iterator pos = edges.begin();
+       pos != edges.end(); ++pos) {
+    if (pos->second != DirectedGraph::DISCONNECT) {
+      ++m_vOffsets[pos->first.first + 1];
+      m_vTargets.push_back(pos->first.second);
+      m_vWeights.push_back(pos->second);
     }
   }
+
+  for (size_t i = 0; i < m_nNumberOfVertices; ++i)
+    m_vOffsets[i + 1] += m_vOffsets[i];
 }
 
-/************************************************************************/
-/* Analysis of m_vResult4Vertices and m_vResult4Distance to generate the
-/* shortest path.
-/************************************************************************/
+/************************************************************************
+ * Build the graph straight from the edge list, without going through a
+ * directed graph.
+ ************************************************************************/
+void ShortestPath::Build(const kShortestPathParms& params) {
+  _Init(params.total_nodes);
+
+  for (size_t a = 0; a < params.total_edges; ++a)
+    ++m_vOffsets[params.edge_list[a].src_node + 1];
+
+  for (size_t i = 0; i < m_nNumberOfVertices; ++i)
+    m_vOffsets[i + 1] += m_vOffsets[i];
+
+  m_vTargets.resize(params.total_edges);
+  m_vWeights.resize(params.total_edges);
+
+  // The heap is empty, so it is used for the next free slot of each vertex.
+  m_vHeap.assign(m_vOffsets.begin(), m_vOffsets.end() - 1);
+
+  for (size_t a = 0; a < params.total_edges; ++a) {
+    const kShortestPathEdges& edge = params.edge_list[a];
+
+    // Insert the edge in order of its target, after the edges with the same
+    // target so that the first of them is the one that is kept.
+    size_t slot = m_vHeap[edge.src_node]++;
+
+    while (slot > m_vOffsets[edge.src_node] &&
+           m_vTargets[slot - 1] > edge.dest_node) {
+      m_vTargets[slot] = m_vTargets[slot - 1];
+      m_vWeights[slot] = m_vWeights[slot - 1];
+      --slot;
+    }
+
+    m_vTargets[slot] = edge.dest_node;
+    m_vWeights[slot] = edge.edge_cost;
+  }
+
+  m_vHeap.clear();
+
+  // Remove the duplicate edges, keeping the first of each, and then the
+  // edges that are disconnected.
+  size_t count = 0;
+
+  for (size_t i = 0; i < m_nNumberOfVertices; ++i) {
+    size_t begin = m_vOffsets[i];
+    size_t end = m_vOffsets[i + 1];
+
+    m_vOffsets[i] = count;
+
+    for (size_t e = begin; e < end; ++e) {
+      if (e > begin && m_vTargets[e] == m_vTargets[e - 1]) continue;
+
+      if (m_vWeights[e] == DirectedGraph::DISCONNECT) continue;
+
+      m_vTargets[count] = m_vTargets[e];
+      m_vWeights[count] = m_vWeights[e];
+      ++count;
+    }
+  }
+
+  m_vOffsets[m_nNumberOfVertices] = count;
+
+  m_vTargets.resize(count);
+  m_vWeights.resize(count);
+}
+
+/************************************************************************
+ * Build the graph with the edges of another one reversed. The edges of
+ * the other graph are in order of their source, so adding them in that
+ * order keeps the in edges of each vertex in order of their source.
+ ************************************************************************/
+void ShortestPath::BuildReverse(const ShortestPath& rGraph) {
+  _Init(rGraph.m_nNumberOfVertices);
+
+  size_t count = rGraph.m_vTargets.size();
+
+  for (size_t e = 0; e < count; ++e) ++m_vOffsets[rGraph.m_vTargets[e] + 1];
+
+  for (size_t i = 0; i < m_nNumberOfVertices; ++i)
+    m_vOffsets[i + 1] += m_vOffsets[i];
+
+  m_vTargets.resize(count);
+  m_vWeights.resize(count);
+  m_vEdgeIds.resize(count);
+
+  // The heap is empty, so it is used for the next free slot of each vertex.
+  m_vHeap.assign(m_vOffsets.begin(), m_vOffsets.end() - 1);
+
+  for (size_t i = 0; i < m_nNumberOfVertices; ++i) {
+    for (size_t e = rGraph.m_vOffsets[i]; e < rGraph.m_vOffsets[i + 1]; ++e) {
+      size_t slot = m_vHeap[rGraph.m_vTargets[e]]++;
+
+      m_vTargets[slot] = i;
+      m_vWeights[slot] = rGraph.m_vWeights[e];
+      m_vEdgeIds[slot] = e;
+    }
+  }
+
+  m_vHeap.clear();
+}
+
+/************************************************************************
+ * Analysis of m_vResult4Vertices and m_vResult4Distance to generate the
+ * shortest path.
+ ************************************************************************/
 DirectedPath* ShortestPath::_GetShortestPath(size_t nTargetNodeId) {
   std::vector<size_t> vertex_list;
 
   // Check the input
-  if (nTargetNodeId >= m_rGraph.GetNumberOfVertices() || nTargetNodeId < 0) {
+  if (nTargetNodeId >= m_nNumberOfVertices) {
     return new DirectedPath(-1, DirectedGraph::DISCONNECT, vertex_list);
   }
 
-  if (m_distanceMap[nTargetNodeId] == DirectedGraph::DISCONNECT) {
+  if (m_vDistance[nTargetNodeId] == DirectedGraph::DISCONNECT) {
     return new DirectedPath(-2, DirectedGraph::DISCONNECT, vertex_list);
   }
 
   // Determine the shortest path from the source to the terminal.
+  size_t length = 1;
+
+  for (size_t cur_vertex = nTargetNodeId; cur_vertex != m_nSourceNodeId;
+       cur_vertex = m_vPredecessor[cur_vertex])
+    ++length;
+
+  vertex_list.resize(length);
+  CopyShortestPath(nTargetNodeId, &vertex_list[0], length);
+
+  return new DirectedPath(0, m_vDistance[nTargetNodeId], vertex_list);
+}
+
+/************************************************************************
+ * Copy the shortest path from the source to a target, from the
+ * source to the target.
+ ************************************************************************/
+size_t ShortestPath::CopyShortestPath(size_t nTargetNodeId, size_t* pVertices,
+                                      size_t nMaxLength) const {
+  if (nTargetNodeId >= m_nNumberOfVertices ||
+      m_vDistance[nTargetNodeId] == DirectedGraph::DISCONNECT)
+    return 0;
+
+  size_t length = 1;
+
+  for (size_t cur_vertex = nTargetNodeId; cur_vertex != m_nSourceNodeId;
+       cur_vertex = m_vPredecessor[cur_vertex])
+    ++length;
+
+  if (length > nMaxLength) return 0;
+
   size_t cur_vertex = nTargetNodeId;
-  std::list<size_t> tmp_list;
-  tmp_list.push_front(nTargetNodeId);
-  do {
-    if (m_nextNodeMap[cur_vertex] == m_nSourceNodeId) {
-      if (cur_vertex != m_nSourceNodeId) tmp_list.push_front(m_nSourceNodeId);
-      break;
-    } else {
-      cur_vertex = m_nextNodeMap[cur_vertex];
-      tmp_list.push_front(cur_vertex);
-    }
-  } while (1);
-  //
-  copy(tmp_list.begin(), tmp_list.end(), back_inserter(vertex_list));
 
-  //
-  return new DirectedPath(0, m_distanceMap[nTargetNodeId], vertex_list);
+  for (size_t i = length; i-- > 0;) {
+    pVertices[i] = cur_vertex;
+    cur_vertex = m_vPredecessor[cur_vertex];
+  }
+
+  return length;
 }
 
-/************************************************************************/
-/* Calculate the shortest path from a source to a target.
-/************************************************************************/
+/************************************************************************
+ * Calculate the shortest path from a source to a target.
+ ************************************************************************/
 DirectedPath* ShortestPath::GetShortestPath(size_t nSourceNodeId,
                                             size_t nTargetNodeId) {
   if (m_nSourceNodeId != nSourceNodeId) {
     m_nSourceNodeId = nSourceNodeId;
-    _DijkstraShortestPathsAlg();
+    _DijkstraShortestPathsAlg(nullptr);
   }
 
   return _GetShortestPath(nTargetNodeId);
 }
 
-/************************************************************************/
-/* Based on the input - the source of the path, create a steiner tree. (???)
-/************************************************************************/
+/************************************************************************
+ * Based on the input - the source of the path, create a steiner tree. (???)
+ ************************************************************************/
 void ShortestPath::ConstructPathTree(size_t nSourceNodeId) {
   m_nSourceNodeId = nSourceNodeId;
-  _DijkstraShortestPathsAlg();
+  _DijkstraShortestPathsAlg(nullptr);
+}
+
+/************************************************************************
+ * Create the tree without the edges that have been removed
+ ************************************************************************/
+void ShortestPath::ConstructPathTree(size_t nSourceNodeId,
+                                     const std::vector<char>& vRemovedEdges) {
+  m_nSourceNodeId = nSourceNodeId;
+  _DijkstraShortestPathsAlg(&vRemovedEdges);
 }
 
-/************************************************************************/
-/*
-/************************************************************************/
-void ShortestPath::_DijkstraShortestPathsAlg() {
-  size_t edges_count = m_rGraph.GetNumberOfEdges();
-  size_t vertices_count = m_rGraph.GetNumberOfVertices();
-
-  //////////////////////////////////////////////////////////////////////////
-  // Initiate the boost graph
-  std::vector<Vertex_Descriptor> vResult4Vertices;
-  std::vector<double> vResult4Distance;
-  Boost_Graph_Type g(vertices_count);
-  boost::property_map<Boost_Graph_Type, boost::edge_weight_t>::type weightmap =
-      get(boost::edge_weight, g);
-  //
-  for (std::size_t j = 0; j < static_cast<size_t>(edges_count); ++j) {
-    Edge_Descriptor e;
-    bool inserted;
-    tie(e, inserted) = add_edge(m_vEdges[j].first, m_vEdges[j].second, g);
-    weightmap[e] = m_vWeights[j];
+/************************************************************************
+ * Dijkstra, in the same order as the breadth first visit of Boost
+ ************************************************************************/
+void ShortestPath::_DijkstraShortestPathsAlg(
+    const std::vector<char>* pRemovedEdges) {
+  for (size_t i = 0; i < m_nNumberOfVertices; ++i) {
+    m_vDistance[i] = DirectedGraph::DISCONNECT;
+    m_vPredecessor[i] = i;
+    m_vColor[i] = WHITE;
+    m_vIndexInHeap[i] = NOT_IN_HEAP;
+  }
+
+  m_vHeap.clear();
+
+  if (m_nSourceNodeId >= m_nNumberOfVertices) return;
+
+  m_vDistance[m_nSourceNodeId] = 0;
+  m_vColor[m_nSourceNodeId] = GRAY;
+  _HeapPush(m_nSourceNodeId);
+
+  while (m_vHeap.empty() == false) {
+    size_t u = m_vHeap[0];
+    _HeapPop();
+
+    double d_u = m_vDistance[u];
+
+    for (size_t e = m_vOffsets[u]; e < m_vOffsets[u + 1]; ++e) {
+      if (pRemovedEdges != nullptr && (*pRemovedEdges)[GetEdgeId(e)] != 0)
+        continue;
+
+      size_t v = m_vTargets[e];
+
+      if (m_vColor[v] == BLACK) continue;
+
+      // The distances are added as a closed plus, so that a disconnected
+      // vertex stays disconnected.
+      double d_v = m_vDistance[v];
+      double cost = (d_u == DirectedGraph::DISCONNECT ||
+                     m_vWeights[e] == DirectedGraph::DISCONNECT)
+                        ? DirectedGraph::DISCONNECT
+                        : d_u + m_vWeights[e];
+
+      bool decreased = false;
+
+      if (cost < d_v) {
+        m_vDistance[v] = cost;
+
+        if (m_vDistance[v] < d_v) {
+          m_vPredecessor[v] = u;
+          decreased = true;
+        }
+      }
+
+      if (m_vColor[v] == WHITE) {
+        m_vColor[v] = GRAY;
+        _HeapPush(v);
+      } else if (decreased) {
+        _HeapUp(m_vIndexInHeap[v]);
+      }
+    }
+
+    m_vColor[u] = BLACK;
   }
+}
+
+/************************************************************************
+ * Add a vertex to the heap
+ ************************************************************************/
+void ShortestPath::_HeapPush(size_t v) {
+  size_t index = m_vHeap.size();
+  m_vHeap.push_back(v);
+  m_vIndexInHeap[v] = index;
+
+  _HeapUp(index);
+}
+
+/************************************************************************
+ * Remove the vertex with the least distance from the heap
+ ************************************************************************/
+void ShortestPath::_HeapPop() {
+  m_vIndexInHeap[m_vHeap[0]] = NOT_IN_HEAP;
+
+  if (m_vHeap.size() != 1) {
+    m_vHeap[0] = m_vHeap.back();
+    m_vIndexInHeap[m_vHeap[0]] = 0;
+    m_vHeap.pop_back();
+
+    _HeapDown();
+  } else {
+    m_vHeap.pop_back();
+  }
+}
+
+/************************************************************************
+ * Move the vertex towards the root until its parent is not further
+ ************************************************************************/
+void ShortestPath::_HeapUp(size_t index) {
+  size_t moving = m_vHeap[index];
+  double moving_dist = m_vDistance[moving];
+
+  while (index != 0) {
+    size_t parent_index = (index - 1) / HEAP_ARITY;
+    size_t parent = m_vHeap[parent_index];
+
+    if ((moving_dist < m_vDistance[parent]) == false) break;
+
+    m_vHeap[index] = parent;
+    m_vIndexInHeap[parent] = index;
+    index = parent_index;
+  }
+
+  m_vHeap[index] = moving;
+  m_vIndexInHeap[moving] = index;
+}
+
+/************************************************************************
+ * Move the root down until none of its children are closer
+ ************************************************************************/
+void ShortestPath::_HeapDown() {
+  if (m_vHeap.empty()) return;
+
+  size_t index = 0;
+  size_t moving = m_vHeap[0];
+  double moving_dist = m_vDistance[moving];
+  size_t heap_size = m_vHeap.size();
+
+  for (;;) {
+    size_t first_child_index = index * HEAP_ARITY + 1;
+
+    if (first_child_index >= heap_size) break;
+
+    size_t children = heap_size - first_child_index;
+    if (children > HEAP_ARITY) children = HEAP_ARITY;
+
+    size_t smallest_child_index = first_child_index;
+    double smallest_child_dist = m_vDistance[m_vHeap[first_child_index]];
+
+    for (size_t i = 1; i < children; ++i) {
+      double i_dist = m_vDistance[m_vHeap[first_child_index + i]];
+
+      if (i_dist < smallest_child_dist) {
+        smallest_child_index = first_child_index + i;
+        smallest_child_dist = i_dist;
+      }
+    }
+
+    if ((smallest_child_dist < moving_dist) == false) break;
+
+    size_t child = m_vHeap[smallest_child_index];
+
+    m_vHeap[index] = child;
+    m_vIndexInHeap[child] = index;
+    m_vHeap[smallest_child_index] = moving;
+    m_vIndexInHeap[moving] = smallest_child_index;
 
-  // about the vertices in the boost graph
-  vResult4Vertices.resize(num_vertices(g));
-  vResult4Distance.resize(num_vertices(g));
-  Vertex_Descriptor s = vertex(m_nSourceNodeId, g);
-
-  // run the algorithm
-  // VC++ has trouble with the named parameters mechanism
-  boost::property_map<Boost_Graph_Type, boost::vertex_index_t>::type indexmap =
-      get(boost::vertex_index, g);
-  dijkstra_shortest_paths(
-      g, s, &vResult4Vertices[0], &vResult4Distance[0], weightmap, indexmap,
-      std::less<double>(), boost::closed_plus<double>(),
-      DirectedGraph::DISCONNECT, 0, boost::default_dijkstra_visitor());
-
-  //////////////////////////////////////////////////////////////////////////
-  // Set the results
-  for (size_t i = 0; i < vResult4Vertices.size(); ++i) {
-    m_distanceMap[i] = vResult4Distance[i];
-    m_nextNodeMap[i] = vResult4Vertices[i];
+    index = smallest_child_index;
   }
 }
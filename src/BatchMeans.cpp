@@ -0,0 +1,140 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      BatchMeans.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the BatchMeans.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Batch means convergence of a run.
+//  10/18/2026  v2.1    Absolute precision for the metrics near zero.
+//
+// ____________________________________________________________________________
+
+#include "BatchMeans.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Thread.h"
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	BatchMeans
+// Description:		Creates a monitor with the given batch size and
+//					relative and absolute precision targets.
+//
+///////////////////////////////////////////////////////////////////
+BatchMeans::BatchMeans(size_t b, size_t m, double p, double a)
+    : batchSize(b),
+      minBatches(m),
+      precision(p),
+      absolutePrecision(a),
+      lastRequests(0),
+      lastSuccesses(0),
+      lastFailures(0),
+      lastQFactor(0.0) {}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	reset
+// Description:		Clears all of the batches, for the start of a
+//					new run or once the warm-up has been removed.
+//
+///////////////////////////////////////////////////////////////////
+void BatchMeans::reset(const GlobalStats &stats) {
+  lastRequests = stats.ConnectionRequests;
+  lastSuccesses = stats.ConnectionSuccesses;
+  lastFailures =
+      stats.CollisionFailures + stats.QualityFailures + stats.NoPathFailures;
+  lastQFactor = stats.qFactorTotal;
+
+  blocking = RunningStat();
+  quality = RunningStat();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	update
+// Description:		Closes the current batch once enough requests
+//					have been made and checks for convergence.
+//
+///////////////////////////////////////////////////////////////////
+bool BatchMeans::update(const GlobalStats &stats) {
+  if (stats.ConnectionRequests - lastRequests < batchSize) return false;
+
+  size_t failures =
+      stats.CollisionFailures + stats.QualityFailures + stats.NoPathFailures;
+
+  double requests = double(stats.ConnectionRequests - lastRequests);
+  double successes = double(stats.ConnectionSuccesses - lastSuccesses);
+
+  // The blocking is counted from the failures rather than the successes, so
+  // that the requests that are still being set up at the end of a batch do
+  // not show up as blocked.
+  blocking.add(double(failures - lastFailures) / requests);
+
+  if (successes > 0.0)
+    quality.add((stats.qFactorTotal - lastQFactor) / successes);
+
+  lastRequests = stats.ConnectionRequests;
+  lastSuccesses = stats.ConnectionSuccesses;
+  lastFailures = failures;
+  lastQFactor = stats.qFactorTotal;
+
+  if (blocking.getCount() < minBatches) return false;
+
+  return hasConverged(blocking) == true && hasConverged(quality) == true;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	saveCheckpoint
+// Description:		Writes the batches to a checkpoint
+//
+///////////////////////////////////////////////////////////////////
+void BatchMeans::saveCheckpoint(CheckpointWriter &out) const {
+  out.write(lastRequests);
+  out.write(lastSuccesses);
+  out.write(lastFailures);
+  out.write(lastQFactor);
+  out.write(blocking);
+  out.write(quality);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	loadCheckpoint
+// Description:		Reads the batches from a checkpoint
+//
+///////////////////////////////////////////////////////////////////
+void BatchMeans::loadCheckpoint(CheckpointReader &in) {
+  in.read(lastRequests);
+  in.read(lastSuccesses);
+  in.read(lastFailures);
+  in.read(lastQFactor);
+  in.read(blocking);
+  in.read(quality);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	hasConverged
+// Description:		Returns true if the half width of the confidence
+//					interval is within the relative precision of
+//					the mean. A mean of zero has no relative
+//					precision, so the absolute precision is the
+//					floor of the target.
+//
+///////////////////////////////////////////////////////////////////
+bool BatchMeans::hasConverged(const RunningStat &metric) const {
+  if (metric.getCount() < 2) return false;
+
+  return metric.getHalfWidth() <=
+         std::max(precision * fabs(metric.getMean()), absolutePrecision);
+}
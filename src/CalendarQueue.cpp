@@ -0,0 +1,251 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      CalendarQueue.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the calendar queue
+//					(R. Brown, 1988) implementation of the
+//					EventQueue.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Calendar queue backend of the EventQueue.
+//
+// ____________________________________________________________________________
+
+#include "CalendarQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+const size_t CalendarEventQueue::MIN_BUCKETS = 16;
+const size_t CalendarEventQueue::WIDTH_SAMPLES = 25;
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	CalendarEventQueue
+// Description:		Default constructor
+//
+///////////////////////////////////////////////////////////////////
+CalendarEventQueue::CalendarEventQueue()
+    : buckets(MIN_BUCKETS),
+      size(0),
+      bucketWidth(1.0),
+      currentBucket(0),
+      nextBucket(0),
+      nextBucketKnown(false),
+      lastTime(0.0) {}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	~CalendarEventQueue
+// Description:		Default destructor
+//
+///////////////////////////////////////////////////////////////////
+CalendarEventQueue::~CalendarEventQueue() {}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	pushEvent
+// Description:		Adds the event to the bucket for its time and
+//					grows the calendar if the buckets are
+//					getting crowded.
+//
+///////////////////////////////////////////////////////////////////
+void CalendarEventQueue::pushEvent(const Event &e) {
+  if (std::isfinite(e.e_time) == false) {
+    overflow.push(e);
+    return;
+  }
+
+  insert(e);
+  ++size;
+
+  if (size > 2 * buckets.size()) resize(2 * buckets.size());
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	peekNextEvent
+// Description:		Returns the earliest event without removing it
+//					from the calendar.
+//
+///////////////////////////////////////////////////////////////////
+const Event &CalendarEventQueue::peekNextEvent() const {
+  if (size == 0) return overflow.top();
+
+  long long int nbuckets = static_cast<long long int>(buckets.size());
+
+  return buckets[findNextBucket() % nbuckets].back();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getNextEvent
+// Description:		Removes the earliest event from the calendar
+//					and returns it.
+//
+///////////////////////////////////////////////////////////////////
+Event CalendarEventQueue::getNextEvent() {
+  if (size == 0) {
+    Event retVal = overflow.top();
+
+    overflow.pop();
+
+    return retVal;
+  }
+
+  long long int nbuckets = static_cast<long long int>(buckets.size());
+  long long int found = findNextBucket();
+
+  Bucket &bucket = buckets[found % nbuckets];
+
+  Event retVal = bucket.back();
+
+  bucket.pop_back();
+  --size;
+
+  currentBucket = found;
+  nextBucketKnown = false;
+  lastTime = retVal.e_time;
+
+  if (buckets.size() > MIN_BUCKETS && size < buckets.size() / 2)
+    resize(buckets.size() / 2);
+
+  return retVal;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	findNextBucket
+// Description:		Returns the virtual bucket that holds the
+//					earliest event on the calendar.
+//
+///////////////////////////////////////////////////////////////////
+long long int CalendarEventQueue::findNextBucket() const {
+  if (nextBucketKnown == true) return nextBucket;
+
+  long long int nbuckets = static_cast<long long int>(buckets.size());
+  long long int found = -1;
+
+  // Scan one year of the calendar, starting from the bucket of the last
+  // event that was removed.
+  for (long long int b = currentBucket; b < currentBucket + nbuckets; ++b) {
+    const Bucket &bucket = buckets[b % nbuckets];
+
+    if (bucket.empty() == false &&
+        virtualBucket(bucket.back().e_time) <= b) {
+      found = b;
+      break;
+    }
+  }
+
+  if (found == -1) {
+    // Nothing in the current year, so go directly to the earliest event.
+    const Event *earliest = nullptr;
+
+    for (size_t b = 0; b < buckets.size(); ++b) {
+      if (buckets[b].empty() == false &&
+          (earliest == nullptr || *earliest < buckets[b].back())) {
+        earliest = &buckets[b].back();
+      }
+    }
+
+    found = virtualBucket(earliest->e_time);
+  }
+
+  nextBucket = found;
+  nextBucketKnown = true;
+
+  return found;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	insert
+// Description:		Places the event in its bucket, keeping the
+//					bucket ordered with the next event at the
+//					back.
+//
+///////////////////////////////////////////////////////////////////
+void CalendarEventQueue::insert(const Event &e) {
+  long long int vb = virtualBucket(e.e_time);
+
+  if (vb < currentBucket) currentBucket = vb;
+
+  // The earliest event is always in the bucket of its own time, so a new
+  // event can only make an earlier bucket the next one.
+  if (nextBucketKnown == true && vb < nextBucket) nextBucket = vb;
+
+  Bucket &bucket = buckets[vb % static_cast<long long int>(buckets.size())];
+
+  bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), e), e);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	resize
+// Description:		Rebuilds the calendar with the new number of
+//					buckets and a bucket width based upon the
+//					events currently in the queue.
+//
+///////////////////////////////////////////////////////////////////
+void CalendarEventQueue::resize(size_t newBucketCount) {
+  std::vector<Event> events;
+  events.reserve(size);
+
+  for (size_t b = 0; b < buckets.size(); ++b)
+    events.insert(events.end(), buckets[b].begin(), buckets[b].end());
+
+  bucketWidth = calculateBucketWidth(events);
+
+  buckets.assign(newBucketCount, Bucket());
+
+  currentBucket = virtualBucket(lastTime);
+  nextBucketKnown = false;
+
+  for (size_t e = 0; e < events.size(); ++e) insert(events[e]);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	calculateBucketWidth
+// Description:		Estimates the bucket width from the average
+//					separation of the events at the front of the
+//					queue, ignoring the outliers.
+//
+///////////////////////////////////////////////////////////////////
+double CalendarEventQueue::calculateBucketWidth(
+    std::vector<Event> &events) const {
+  size_t samples = std::min(events.size(), WIDTH_SAMPLES);
+
+  if (samples < 2) return bucketWidth;
+
+  std::vector<double> times(events.size());
+
+  for (size_t e = 0; e < events.size(); ++e) times[e] = events[e].e_time;
+
+  std::partial_sort(times.begin(), times.begin() + samples, times.end());
+
+  double average = (times[samples - 1] - times[0]) / double(samples - 1);
+
+  double total = 0.0;
+  size_t count = 0;
+
+  for (size_t s = 1; s < samples; ++s) {
+    double separation = times[s] - times[s - 1];
+
+    if (separation <= 2.0 * average) {
+      total += separation;
+      ++count;
+    }
+  }
+
+  if (count == 0 || total <= 0.0) return bucketWidth;
+
+  return 3.0 * total / double(count);
+}
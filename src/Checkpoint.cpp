@@ -0,0 +1,129 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      Checkpoint.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the checkpoint
+//					streams.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Binary checkpoint streams of a run.
+//  10/18/2026  v2.1    Event types written in one byte.
+//
+// ____________________________________________________________________________
+
+#include "Checkpoint.h"
+
+#include <cstring>
+
+const char CheckpointWriter::MAGIC[8] = {'R', 'A', 'P', 'T', 'O', 'R', 'C', 'P'};
+const unsigned int CheckpointWriter::VERSION = 4;
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	CheckpointWriter
+// Description:		Opens the checkpoint file and writes the header
+//
+///////////////////////////////////////////////////////////////////
+CheckpointWriter::CheckpointWriter(const std::string &f)
+    : out(f.c_str(), std::ios::out | std::ios::binary | std::ios::trunc) {
+  writeArray(MAGIC, sizeof(MAGIC));
+  write(VERSION);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	writeString
+// Description:		Writes a string preceded by its length
+//
+///////////////////////////////////////////////////////////////////
+void CheckpointWriter::writeString(const std::string &s) {
+  write(s.size());
+  writeArray(s.data(), s.size());
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	writeVector
+// Description:		Writes a vector preceded by its length
+//
+///////////////////////////////////////////////////////////////////
+void CheckpointWriter::writeVector(const std::vector<double> &v) {
+  write(v.size());
+
+  if (v.empty() == false) writeArray(&v[0], v.size());
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	close
+// Description:		Flushes and closes the checkpoint file
+//
+///////////////////////////////////////////////////////////////////
+void CheckpointWriter::close() { out.close(); }
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	CheckpointReader
+// Description:		Opens the checkpoint file for reading
+//
+///////////////////////////////////////////////////////////////////
+CheckpointReader::CheckpointReader(const std::string &f)
+    : in(f.c_str(), std::ios::in | std::ios::binary) {}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	checkHeader
+// Description:		Reads and checks the header of the file
+//
+///////////////////////////////////////////////////////////////////
+bool CheckpointReader::checkHeader() {
+  char magic[sizeof(CheckpointWriter::MAGIC)];
+  unsigned int version = 0;
+
+  readArray(magic, sizeof(magic));
+  read(version);
+
+  return isGood() == true &&
+         memcmp(magic, CheckpointWriter::MAGIC, sizeof(magic)) == 0 &&
+         version == CheckpointWriter::VERSION;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	readString
+// Description:		Reads a string preceded by its length
+//
+///////////////////////////////////////////////////////////////////
+std::string CheckpointReader::readString() {
+  size_t length = 0;
+  read(length);
+
+  if (isGood() == false) return std::string();
+
+  std::string s(length, '\0');
+  if (length > 0) readArray(&s[0], length);
+
+  return s;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	readVector
+// Description:		Reads a vector preceded by its length
+//
+///////////////////////////////////////////////////////////////////
+void CheckpointReader::readVector(std::vector<double> &v) {
+  size_t length = 0;
+  read(length);
+
+  if (isGood() == false) return;
+
+  v.resize(length);
+  if (length > 0) readArray(&v[0], length);
+}
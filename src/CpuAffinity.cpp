@@ -0,0 +1,257 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      CpuAffinity.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the CpuAffinity.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Threads pinned to their own cores.
+//  10/18/2026  v2.1    Cores grouped by the cpulist of their NUMA node.
+//  10/18/2026  v2.1    Cores of the process kept for the scenarios of a sweep.
+//
+// ____________________________________________________________________________
+
+#include "CpuAffinity.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "Thread.h"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sched.h>
+#endif
+
+#define HAVE_STRUCT_TIMESPEC
+#include "pthread.h"
+
+extern Thread *threadZero;
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	CpuAffinity
+// Description:		Creates the affinity with no threads pinned and
+//					reads the cores the process is allowed to run
+//					on.
+//
+///////////////////////////////////////////////////////////////////
+CpuAffinity::CpuAffinity() {
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    for (int c = 0; c < CPU_SETSIZE; ++c)
+      if (CPU_ISSET(c, &allowed)) processCpus.push_back(c);
+  }
+#endif
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	enable
+// Description:		Orders the cores the process is allowed to run on
+//					starting with the current one.
+//
+///////////////////////////////////////////////////////////////////
+void CpuAffinity::enable() {
+  cpus.clear();
+
+  std::vector<std::vector<int> > nodes;
+
+#ifdef __linux__
+  if (processCpus.empty() == false) {
+    // The nodes are read in the order of their number.
+    std::vector<int> nodeNumbers;
+    DIR* dir = opendir("/sys/devices/system/node");
+
+    if (dir != nullptr) {
+      for (struct dirent* entry = readdir(dir); entry != nullptr;
+           entry = readdir(dir)) {
+        std::string name(entry->d_name);
+
+        if (name.compare(0, 4, "node") == 0 && name.size() > 4 &&
+            name.find_first_not_of("0123456789", 4) == std::string::npos)
+          nodeNumbers.push_back(atoi(name.c_str() + 4));
+      }
+
+      closedir(dir);
+    }
+
+    std::sort(nodeNumbers.begin(), nodeNumbers.end());
+
+    for (size_t n = 0; n < nodeNumbers.size(); ++n) {
+      std::ostringstream file;
+      file << "/sys/devices/system/node/node" << nodeNumbers[n] << "/cpulist";
+
+      std::ifstream in(file.str().c_str());
+      std::string list;
+
+      if (std::getline(in, list)) nodes.push_back(parseCpuList(list));
+    }
+
+    // The controller was built on the current core, so the first slot stays
+    // there to keep its memory local.
+    cpus = orderCpus(processCpus, nodes, sched_getcpu());
+  }
+#endif
+
+  std::ostringstream buffer;
+
+  if (cpus.empty() == true)
+    buffer << "WARNING: Unable to pin the threads on this platform.";
+  else
+    buffer << "Pinning the threads to " << cpus.size() << " cores on "
+           << (nodes.empty() == true ? 1 : nodes.size()) << " nodes.";
+
+  threadZero->recordEvent(buffer.str(), true, 0);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	parseCpuList
+// Description:		Returns the cores of a cpulist of sysfs, which
+//					is a comma separated list of cores and ranges
+//					of cores.
+//
+///////////////////////////////////////////////////////////////////
+std::vector<int> CpuAffinity::parseCpuList(const std::string &list) {
+  std::vector<int> result;
+  std::istringstream in(list);
+  std::string range;
+
+  while (std::getline(in, range, ',')) {
+    if (range.find_first_of("0123456789") == std::string::npos) continue;
+
+    size_t dash = range.find('-');
+    int first = atoi(range.c_str());
+    int last = dash == std::string::npos ? first
+                                         : atoi(range.c_str() + dash + 1);
+
+    for (int c = first; c <= last; ++c) result.push_back(c);
+  }
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	orderCpus
+// Description:		Orders the allowed cores so that the slots fill
+//					the node of the current core first, starting
+//					at the current core, and then the other nodes.
+//
+///////////////////////////////////////////////////////////////////
+std::vector<int> CpuAffinity::orderCpus(
+    const std::vector<int> &allowed,
+    const std::vector<std::vector<int> > &nodes, int current) {
+  std::vector<std::vector<int> > groups;
+  std::vector<bool> placed(allowed.size(), false);
+
+  for (size_t n = 0; n < nodes.size(); ++n) {
+    std::vector<int> group;
+
+    for (size_t c = 0; c < nodes[n].size(); ++c) {
+      std::vector<int>::const_iterator it =
+          std::find(allowed.begin(), allowed.end(), nodes[n][c]);
+
+      if (it != allowed.end() && placed[it - allowed.begin()] == false) {
+        placed[it - allowed.begin()] = true;
+        group.push_back(nodes[n][c]);
+      }
+    }
+
+    if (group.empty() == false) groups.push_back(group);
+  }
+
+  std::vector<int> unplaced;
+
+  for (size_t c = 0; c < allowed.size(); ++c)
+    if (placed[c] == false) unplaced.push_back(allowed[c]);
+
+  if (unplaced.empty() == false) groups.push_back(unplaced);
+
+  std::vector<int> result;
+
+  for (size_t g = 0; g < groups.size(); ++g) {
+    std::vector<int>::iterator it =
+        std::find(groups[g].begin(), groups[g].end(), current);
+
+    if (it == groups[g].end()) continue;
+
+    std::rotate(groups[g].begin(), it, groups[g].end());
+    result.insert(result.end(), groups[g].begin(), groups[g].end());
+    groups.erase(groups.begin() + g);
+    break;
+  }
+
+  for (size_t g = 0; g < groups.size(); ++g)
+    result.insert(result.end(), groups[g].begin(), groups[g].end());
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	pin
+// Description:		Pins the calling thread to the core of the slot.
+//					When there are more slots than cores the cores
+//					are shared.
+//
+///////////////////////////////////////////////////////////////////
+bool CpuAffinity::pin(size_t slot) const {
+  if (isEnabled() == false) return false;
+
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpus[slot % cpus.size()], &set);
+
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	unpin
+// Description:		Lets the calling thread run on all of the cores
+//					the process was allowed to run on when it was
+//					started.
+//
+///////////////////////////////////////////////////////////////////
+void CpuAffinity::unpin() const {
+#ifdef __linux__
+  if (processCpus.empty() == true) return;
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  for (size_t c = 0; c < processCpus.size(); ++c) CPU_SET(processCpus[c], &set);
+
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getCpu
+// Description:		Returns the core of the slot, or -1 if the
+//					threads are not pinned.
+//
+///////////////////////////////////////////////////////////////////
+long long int CpuAffinity::getCpu(size_t slot) const {
+  if (isEnabled() == false) return -1;
+
+  return cpus[slot % cpus.size()];
+}
@@ -0,0 +1,152 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      DPArena.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the DPArena.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Per-thread arena of the DP search.
+//
+// ____________________________________________________________________________
+
+#include "DPArena.h"
+
+#include "Edge.h"
+
+const size_t DPArena::NO_ITEM = static_cast<size_t>(-1);
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	DPArena
+// Description:		Creates an empty arena for the given network
+//
+///////////////////////////////////////////////////////////////////
+DPArena::DPArena(size_t r, size_t edges, size_t w)
+    : routers(r),
+      wavelengths(w),
+      words((w + 63) / 64),
+      k(0),
+      nextItem(0),
+      edgeFree(edges * ((w + 63) / 64), 0),
+      edgeRequest(edges, 0),
+      request(0) {
+  pathBuffers[0].resize(r > 1 ? r - 1 : 1);
+  pathBuffers[1].resize(r > 1 ? r - 1 : 1);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	reset
+// Description:		Clears the search for the next request. The
+//					memory is kept for the searches to come.
+//
+///////////////////////////////////////////////////////////////////
+void DPArena::reset(size_t paths) {
+  k = paths;
+
+  items.clear();
+  availability.clear();
+  nextItem = 0;
+
+  Slot empty;
+  empty.item = NO_ITEM;
+  empty.pathSpans = 0;
+  empty.optimalWave = 0.0;
+  empty.pathQuality = 0.0;
+  empty.pathWeight = 0.0;
+
+  slots.assign(routers * k, empty);
+
+  // The status of the edges may have changed since the last request.
+  ++request;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	addItem
+// Description:		Adds the item to the end of the queue, if any of
+//					the wavelengths are free along its path.
+//
+///////////////////////////////////////////////////////////////////
+void DPArena::addItem(size_t parent, Edge *edge, size_t edgeIndex) {
+  const unsigned long long *free = getFreeWavelengths(edge, edgeIndex);
+
+  size_t first = availability.size();
+  availability.resize(first + words);
+
+  unsigned long long any = 0;
+
+  for (size_t i = 0; i < words; ++i) {
+    unsigned long long word = free[i];
+
+    if (parent != NO_ITEM) word &= availability[parent * words + i];
+
+    availability[first + i] = word;
+    any |= word;
+  }
+
+  if (any == 0) {
+    availability.resize(first);
+    return;
+  }
+
+  Item item;
+  item.parent = parent;
+  item.edge = edge;
+  item.pathLength = 1;
+  item.pathSpans = edge->getNumberOfSpans();
+
+  if (parent != NO_ITEM) {
+    item.pathLength += items[parent].pathLength;
+    item.pathSpans += items[parent].pathSpans;
+  }
+
+  items.push_back(item);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getPath
+// Description:		Follows the items back to the source to copy
+//					the edges of the path.
+//
+///////////////////////////////////////////////////////////////////
+size_t DPArena::getPath(size_t i, Edge **path) const {
+  size_t length = items[i].pathLength;
+
+  for (size_t p = length; i != NO_ITEM; i = items[i].parent)
+    path[--p] = items[i].edge;
+
+  return length;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getFreeWavelengths
+// Description:		Returns the free wavelengths of the edge, working
+//					them out the first time the search of a request
+//					reaches the edge.
+//
+///////////////////////////////////////////////////////////////////
+const unsigned long long *DPArena::getFreeWavelengths(Edge *edge,
+                                                      size_t edgeIndex) {
+  unsigned long long *free = &edgeFree[edgeIndex * words];
+
+  if (edgeRequest[edgeIndex] != request) {
+    edgeRequest[edgeIndex] = request;
+
+    for (size_t i = 0; i < words; ++i) free[i] = 0;
+
+    for (size_t w = 0; w < wavelengths; ++w) {
+      if (edge->getStatus(w) == EDGE_FREE) free[w / 64] |= 1ULL << (w % 64);
+    }
+  }
+
+  return free;
+}
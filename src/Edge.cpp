@@ -43,6 +43,7 @@ extern ALLEGRO_BITMAP *routersbmp;
 
 #endif
 
+#include "Checkpoint.h"
 #include "EstablishedConnections.h"
 
 extern Thread *threadZero;
@@ -72,30 +73,25 @@ Edge::Edge()
 //
 // Function Name:	Edge
 // Description:		Constructor with arguments to set the source,
-//					destination, and number of spans.
+//					destination, and number of spans, along with
+//					the state of the wavelengths of the edge.
 //
 ///////////////////////////////////////////////////////////////////
-Edge::Edge(size_t src, size_t dest, size_t spans)
+Edge::Edge(size_t src, size_t dest, size_t spans, EdgeStatus *st,
+           long long int *sessions, double *deg, EdgeStats *es)
     : QMDegredation(0.0),
-      activeSession(0),
+      activeSession(sessions),
       actualUsage(0),
       algorithmUsage(0.0),
-      degredation(nullptr),
+      degredation(deg),
       destinationIndex(dest),
       numberOfSpans(spans),
       pheremone(0.0),
       sourceIndex(src),
-      stats(nullptr),
-      status(nullptr) {
-  status = new EdgeStatus[threadZero->getNumberOfWavelengths()];
-  activeSession = new long long int[threadZero->getNumberOfWavelengths()];
-
-  degredation = new double[threadZero->getNumberOfWavelengths()];
-
+      stats(es),
+      status(st) {
   resetQMDegredation();
 
-  stats = new EdgeStats;
-
   resetEdgeStats();
 
   for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
@@ -119,11 +115,6 @@ Edge::Edge(size_t src, size_t dest, size_t spans)
 //
 ///////////////////////////////////////////////////////////////////
 Edge::~Edge() {
-  delete[] status;
-  delete[] activeSession;
-  delete[] degredation;
-  delete[] stats;
-
 #ifndef NO_ALLEGRO
   usageList.clear();
 
@@ -620,6 +611,50 @@ void Edge::resetEdgeStats() {
   stats->droppedConnections = 0;
 }
 
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	saveCheckpoint
+// Description:		Writes the state of the edge to a checkpoint,
+//					the established connections are written by the
+//					thread as they are shared between edges.
+//
+///////////////////////////////////////////////////////////////////
+void Edge::saveCheckpoint(CheckpointWriter &out) const {
+  size_t waves = threadZero->getNumberOfWavelengths();
+
+  out.writeArray(status, waves);
+  out.writeArray(activeSession, waves);
+  out.writeArray(degredation, waves);
+
+  out.write(algorithmUsage);
+  out.write(actualUsage);
+  out.write(QMDegredation);
+  out.write(pheremone);
+  out.write(*stats);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	loadCheckpoint
+// Description:		Reads the state of the edge from a checkpoint
+//
+///////////////////////////////////////////////////////////////////
+void Edge::loadCheckpoint(CheckpointReader &in) {
+  size_t waves = threadZero->getNumberOfWavelengths();
+
+  in.readArray(status, waves);
+  in.readArray(activeSession, waves);
+  in.readArray(degredation, waves);
+
+  in.read(algorithmUsage);
+  in.read(actualUsage);
+  in.read(QMDegredation);
+  in.read(pheremone);
+  in.read(*stats);
+
+  establishedConnections.clear();
+}
+
 #ifndef NO_ALLEGRO
 ///////////////////////////////////////////////////////////////////
 //
@@ -0,0 +1,159 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      EventProfiler.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the
+//					EventProfiler.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Counts and times of the events of a run.
+//
+// ____________________________________________________________________________
+
+#include "EventProfiler.h"
+
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "Thread.h"
+
+extern Thread *threadZero;
+
+const double EventProfiler::SAMPLE_INTERVAL = 60.0 * 60.0;
+
+static const char *EVENT_NAMES[NUMBER_OF_EVENTS] = {
+    "ACTIVATE_WORKSTATIONS",          "DEACTIVATE_WORKSTATIONS",
+    "UPDATE_USAGE",                   "UPDATE_GUI",
+    "CONNECTION_REQUEST",             "CREATE_CONNECTION_PROBE",
+    "CREATE_CONNECTION_CONFIRMATION", "COLLISION_NOTIFICATION",
+    "DESTROY_CONNECTION_PROBE"};
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	EventProfiler
+// Description:		Creates an empty profile
+//
+///////////////////////////////////////////////////////////////////
+EventProfiler::EventProfiler() { reset(0.0); }
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	reset
+// Description:		Clears the profile at the start of a run, which
+//					starts at the given simulated time.
+//
+///////////////////////////////////////////////////////////////////
+void EventProfiler::reset(double time) {
+  memset(profiles, 0, sizeof(profiles));
+
+  depthTotal = 0;
+  depthCount = 0;
+  depthPeak = 0;
+  depthPeakTime = 0.0;
+
+  nextSample = ceil(time / SAMPLE_INTERVAL) * SAMPLE_INTERVAL;
+  samples.clear();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	add
+// Description:		Adds the handler time of an event to the profile
+//					of its type.
+//
+///////////////////////////////////////////////////////////////////
+void EventProfiler::add(EventType type, unsigned long long int ns) {
+  TypeProfile &p = profiles[type];
+
+  ++p.count;
+  p.totalNs += ns;
+
+  if (ns > p.maxNs) p.maxNs = ns;
+
+  size_t bucket = 0;
+
+  while (bucket < BUCKETS - 1 && (ns >> (bucket + 1)) > 0) ++bucket;
+
+  ++p.histogram[bucket];
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getPercentile
+// Description:		Returns the upper edge, in microseconds, of the
+//					bucket that holds the given quantile of the
+//					handler times.
+//
+///////////////////////////////////////////////////////////////////
+double EventProfiler::getPercentile(const TypeProfile &p, double q) const {
+  unsigned long long int target =
+      static_cast<unsigned long long int>(ceil(q * double(p.count)));
+  unsigned long long int seen = 0;
+
+  for (size_t b = 0; b < BUCKETS; ++b) {
+    seen += p.histogram[b];
+
+    if (seen >= target && seen > 0) {
+      double edge = ldexp(1.0, int(b) + 1);
+
+      return (edge < double(p.maxNs) ? edge : double(p.maxNs)) / 1000.0;
+    }
+  }
+
+  return double(p.maxNs) / 1000.0;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	print
+// Description:		Prints the profile of the run as a table, along
+//					with the depth of the event queue over time.
+//
+///////////////////////////////////////////////////////////////////
+void EventProfiler::print(size_t ci) const {
+  std::ostringstream heading;
+  heading << "EVENT PROFILE: " << std::setw(32) << std::left << "TYPE"
+          << std::right << std::setw(10) << "COUNT" << std::setw(12)
+          << "TOTAL(ms)" << std::setw(10) << "MEAN(us)" << std::setw(10)
+          << "P50(us)" << std::setw(10) << "P99(us)" << std::setw(10)
+          << "MAX(us)";
+  threadZero->recordEvent(heading.str(), true, ci);
+
+  for (size_t t = 0; t < NUMBER_OF_EVENTS; ++t) {
+    const TypeProfile &p = profiles[t];
+
+    if (p.count == 0) continue;
+
+    std::ostringstream row;
+    row << "EVENT PROFILE: " << std::setw(32) << std::left << EVENT_NAMES[t]
+        << std::right << std::setw(10) << p.count << std::fixed
+        << std::setprecision(1) << std::setw(12) << double(p.totalNs) / 1.0e6
+        << std::setprecision(2) << std::setw(10)
+        << double(p.totalNs) / double(p.count) / 1000.0 << std::setw(10)
+        << getPercentile(p, 0.5) << std::setw(10) << getPercentile(p, 0.99)
+        << std::setw(10) << double(p.maxNs) / 1000.0;
+    threadZero->recordEvent(row.str(), true, ci);
+  }
+
+  std::ostringstream depth;
+  depth << "EVENT QUEUE DEPTH: MEAN = "
+        << (depthCount > 0 ? double(depthTotal) / double(depthCount) : 0.0)
+        << ", PEAK = " << depthPeak << " AT TIME = " << depthPeakTime;
+  threadZero->recordEvent(depth.str(), true, ci);
+
+  std::ostringstream timeline;
+  timeline << "EVENT QUEUE DEPTH OVER TIME:";
+
+  for (size_t s = 0; s < samples.size(); ++s)
+    timeline << " " << samples[s].first << "=" << samples[s].second;
+
+  threadZero->recordEvent(timeline.str(), true, ci);
+}
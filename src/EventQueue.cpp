@@ -19,34 +19,118 @@
 // ____________________________________________________________________________
 
 #include "EventQueue.h"
+#include "CalendarQueue.h"
+#include "Thread.h"
+
+#include <sstream>
+
+extern Thread *threadZero;
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	createEventQueue
+// Description:		Creates the event queue implementation that was
+//					selected in the quality parameters.
+//
+///////////////////////////////////////////////////////////////////
+EventQueue *EventQueue::createEventQueue(EventQueueType type) {
+  if (type == CALENDAR_QUEUE)
+    return new CalendarEventQueue();
+  else if (type == VERIFY_QUEUE)
+    return new VerifyEventQueue();
+  else
+    return new HeapEventQueue();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	reportKeyOverflow
+// Description:		Terminates the simulation when the session or
+//					sequence of an event does not fit in its
+//					ordering key.
+//
+///////////////////////////////////////////////////////////////////
+void EventQueue::reportKeyOverflow(unsigned long long int session,
+                                   unsigned long long int sequence) {
+  std::ostringstream buffer;
+  buffer << "ERROR: Session " << session << " or sequence " << sequence
+         << " does not fit in the event ordering key.";
+  threadZero->recordEvent(buffer.str(), true, 0);
+  exit(ERROR_PRIORITY_QUEUE);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	HeapEventQueue
+// Description:		Default constructor
+//
+///////////////////////////////////////////////////////////////////
+HeapEventQueue::HeapEventQueue() {}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	~HeapEventQueue
+// Description:		Default destructor
+//
+///////////////////////////////////////////////////////////////////
+HeapEventQueue::~HeapEventQueue() {}
 
 ///////////////////////////////////////////////////////////////////
 //
-// Function Name:	EventQueue
+// Function Name:	VerifyEventQueue
 // Description:		Default constructor
 //
 ///////////////////////////////////////////////////////////////////
-EventQueue::EventQueue() {}
+VerifyEventQueue::VerifyEventQueue()
+    : heap(new HeapEventQueue()),
+      calendar(new CalendarEventQueue()),
+      eventsCompared(0) {}
 
 ///////////////////////////////////////////////////////////////////
 //
-// Function Name:	~EventQueue
+// Function Name:	~VerifyEventQueue
 // Description:		Default destructor
 //
 ///////////////////////////////////////////////////////////////////
-EventQueue::~EventQueue() {}
+VerifyEventQueue::~VerifyEventQueue() {
+  delete heap;
+  delete calendar;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	pushEvent
+// Description:		Adds the event to both of the queues.
+//
+///////////////////////////////////////////////////////////////////
+void VerifyEventQueue::pushEvent(const Event &e) {
+  heap->addEvent(e);
+  calendar->addEvent(e);
+}
 
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	getNextEvent()
-// Description:		Removes the top element from the priority queue
-//					and returns it.
+// Description:		Removes the next event from both of the queues
+//					and exits if they are not the same event.
 //
 ///////////////////////////////////////////////////////////////////
-Event EventQueue::getNextEvent() {
-  Event retVal = pq.top();
+Event VerifyEventQueue::getNextEvent() {
+  Event h = heap->getNextEvent();
+  Event c = calendar->getNextEvent();
+
+  ++eventsCompared;
 
-  pq.pop();
+  if (h.e_type != c.e_type || h.e_time != c.e_time ||
+      h.e_data.request != c.e_data.request) {
+    std::ostringstream buffer;
+    buffer << "ERROR: Event queues disagree after " << eventsCompared
+           << " events. Heap = (" << h.e_type << ", " << h.e_time
+           << "), Calendar = (" << c.e_type << ", " << c.e_time << ")";
+    threadZero->recordEvent(buffer.str(), true, 0);
+    threadZero->flushLog(true);
+    exit(ERROR_EVENT_QUEUE);
+  }
 
-  return retVal;
+  return h;
 }
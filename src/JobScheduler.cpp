@@ -0,0 +1,450 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      JobScheduler.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the
+//					JobScheduler.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Longest job first sweep with work stealing.
+//  10/18/2026  v2.1    Replications claimed as one job of a shared sweep.
+//
+// ____________________________________________________________________________
+
+#include "JobScheduler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "Replications.h"
+#include "Thread.h"
+
+extern Thread *threadZero;
+
+// Relative cost of a run with each routing algorithm, measured on NSF with
+// 21 wavelengths and relative to shortest path. The ant colony algorithms
+// send out a whole colony for each request and are assumed to be the most
+// expensive of all.
+static const double ROUTING_COST[NUMBER_OF_ROUTING_ALGORITHMS] = {
+    1.0,    // SHORTEST_PATH
+    2.0,    // PABR
+    2.0,    // LORA
+    65.0,   // IMPAIRMENT_AWARE
+    12.0,   // Q_MEASUREMENT
+    12.0,   // ADAPTIVE_QoS
+    7.0,    // DYNAMIC_PROGRAMMING
+    100.0,  // ACO
+    100.0}; // MAX_MIN_ACO
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	JobScheduler
+// Description:		Creates an empty scheduler
+//
+///////////////////////////////////////////////////////////////////
+JobScheduler::JobScheduler() : wavelengths(0), sweep(nullptr), sweepJobs(0) {
+  pthread_mutex_init(&mutex, nullptr);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	~JobScheduler
+// Description:		Deletes any jobs that were never handed out
+//
+///////////////////////////////////////////////////////////////////
+JobScheduler::~JobScheduler() {
+  reset();
+
+  pthread_mutex_destroy(&mutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	reset
+// Description:		Deletes any jobs that were never handed out and
+//					forgets the jobs that were run.
+//
+///////////////////////////////////////////////////////////////////
+void JobScheduler::reset() {
+  pthread_mutex_lock(&mutex);
+
+  for (size_t j = 0; j < pending.size(); ++j) delete pending[j].job;
+
+  for (size_t w = 0; w < queues.size(); ++w)
+    for (size_t j = 0; j < queues[w].jobs.size(); ++j)
+      delete queues[w].jobs[j].job;
+
+  pending.clear();
+  queues.clear();
+  completed.clear();
+  sharedJobs.clear();
+
+  delete sweep;
+  sweep = nullptr;
+  sweepJobs = 0;
+
+  pthread_mutex_unlock(&mutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	estimateCost
+// Description:		Estimates how long a job will take to run, in
+//					arbitrary units. The number of requests grows
+//					with the number of active workstations and the
+//					work per request with the number of wavelengths.
+//
+///////////////////////////////////////////////////////////////////
+double JobScheduler::estimateCost(const AlgorithmToRun &job, size_t w) {
+  return ROUTING_COST[job.ra] * double(job.workstations) * double(w);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	isMoreExpensive
+// Description:		Orders the jobs from the longest to the shortest
+//
+///////////////////////////////////////////////////////////////////
+bool JobScheduler::isMoreExpensive(const Job &a, const Job &b) {
+  return a.estimate > b.estimate;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	addJob
+// Description:		Adds a job to the sweep
+//
+///////////////////////////////////////////////////////////////////
+void JobScheduler::addJob(AlgorithmToRun *job, size_t worker) {
+  pthread_mutex_lock(&mutex);
+
+  Job j;
+  j.job = job;
+  j.config = *job;
+  j.estimate = estimateCost(*job, wavelengths);
+
+  if (queues.empty() == true) {
+    // The first replications of a configuration are added together and are
+    // one job of the sweep, so that they are claimed by a single process.
+    if (job->replications != nullptr && pending.empty() == false &&
+        pending.back().job->replications == job->replications)
+      j.index = pending.back().index;
+    else
+      j.index = sweepJobs++;
+
+    pending.push_back(j);
+  } else {
+    j.index = queues[worker].current.index;
+    queues[worker].jobs.push_front(j);
+    queues[worker].remaining += j.estimate;
+
+    if (sweep != nullptr) ++sharedJobs[j.index].outstanding;
+  }
+
+  pthread_mutex_unlock(&mutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	start
+// Description:		Sorts the jobs longest first and deals them out
+//					to the workers in turn.
+//
+///////////////////////////////////////////////////////////////////
+void JobScheduler::start(size_t workers, size_t w) {
+  pthread_mutex_lock(&mutex);
+
+  wavelengths = w;
+  startTime = std::chrono::steady_clock::now();
+
+  // The jobs used to be taken from the back of the list, that order is kept
+  // for jobs of the same cost.
+  std::reverse(pending.begin(), pending.end());
+
+  for (size_t j = 0; j < pending.size(); ++j)
+    pending[j].estimate = estimateCost(pending[j].config, wavelengths);
+
+  // The order does not change the length of the sweep with a single worker,
+  // so it is left alone, as each thread draws the traffic of its runs from
+  // one generator and the results depend on the order of the runs.
+  if (workers > 1)
+    std::stable_sort(pending.begin(), pending.end(), isMoreExpensive);
+
+  queues.resize(workers);
+
+  for (size_t q = 0; q < workers; ++q) {
+    queues[q].remaining = 0.0;
+    queues[q].currentStolen = false;
+  }
+
+  for (size_t j = 0; j < pending.size(); ++j) {
+    WorkerQueue &queue = queues[j % workers];
+
+    queue.jobs.push_back(pending[j]);
+    queue.remaining += pending[j].estimate;
+  }
+
+  pending.clear();
+
+  pthread_mutex_unlock(&mutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getNextJob
+// Description:		Returns the next job for the worker, which is the
+//					front of its own queue or, if that is empty, the
+//					front of the queue with the most work left.
+//
+///////////////////////////////////////////////////////////////////
+AlgorithmToRun *JobScheduler::getNextJob(size_t worker) {
+  pthread_mutex_lock(&mutex);
+
+  AlgorithmToRun *job = nullptr;
+
+  while (job == nullptr) {
+    size_t victim = worker;
+
+    if (queues[worker].jobs.empty() == true) {
+      for (size_t q = 0; q < queues.size(); ++q) {
+        if (queues[q].jobs.empty() == false &&
+            (victim == worker ||
+             queues[q].remaining > queues[victim].remaining))
+          victim = q;
+      }
+    }
+
+    if (queues[victim].jobs.empty() == true) break;
+
+    WorkerQueue &from = queues[victim];
+
+    queues[worker].current = from.jobs.front();
+    queues[worker].currentStolen = (victim != worker);
+
+    from.jobs.pop_front();
+    from.remaining -= queues[worker].current.estimate;
+
+    job = queues[worker].current.job;
+
+    // The replications of a job are always run by the process that claimed
+    // it, so only the jobs of the sweep itself need to be claimed. The other
+    // first replications of the job are still queued when it is claimed.
+    size_t index = queues[worker].current.index;
+
+    if (sweep != nullptr && sharedJobs.find(index) == sharedJobs.end()) {
+      if (sweep->claim(index) == true) {
+        sharedJobs[index].outstanding = 1 + countQueued(index);
+      } else {
+        dropQueued(index);
+
+        if (job->replications != nullptr) delete job->replications;
+
+        delete job;
+        job = nullptr;
+      }
+    }
+  }
+
+  pthread_mutex_unlock(&mutex);
+
+  return job;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	countQueued
+// Description:		Returns the number of runs of the job of the
+//					sweep that are still queued.
+//
+///////////////////////////////////////////////////////////////////
+size_t JobScheduler::countQueued(size_t index) const {
+  size_t count = 0;
+
+  for (size_t q = 0; q < queues.size(); ++q)
+    for (size_t j = 0; j < queues[q].jobs.size(); ++j)
+      if (queues[q].jobs[j].index == index) ++count;
+
+  return count;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	dropQueued
+// Description:		Deletes the queued runs of a job of the sweep
+//					that another process has claimed.
+//
+///////////////////////////////////////////////////////////////////
+void JobScheduler::dropQueued(size_t index) {
+  for (size_t q = 0; q < queues.size(); ++q) {
+    std::deque<Job> &jobs = queues[q].jobs;
+
+    for (size_t j = 0; j < jobs.size();) {
+      if (jobs[j].index == index) {
+        queues[q].remaining -= jobs[j].estimate;
+
+        delete jobs[j].job;
+        jobs.erase(jobs.begin() + j);
+      } else {
+        ++j;
+      }
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	completeJob
+// Description:		Records the runtime of the last job that was
+//					handed out to the worker.
+//
+///////////////////////////////////////////////////////////////////
+void JobScheduler::completeJob(size_t worker, double seconds) {
+  pthread_mutex_lock(&mutex);
+
+  CompletedJob c;
+  c.config = queues[worker].current.config;
+  c.estimate = queues[worker].current.estimate;
+  c.seconds = seconds;
+  c.worker = worker;
+  c.stolen = queues[worker].currentStolen;
+
+  completed.push_back(c);
+
+  if (sweep != nullptr) {
+    size_t index = queues[worker].current.index;
+    SharedJob &shared = sharedJobs[index];
+
+    if (--shared.outstanding == 0) {
+      sweep->save(index, shared.results);
+      sharedJobs.erase(index);
+    }
+  }
+
+  pthread_mutex_unlock(&mutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	share
+// Description:		Shares the sweep with the other processes
+//
+///////////////////////////////////////////////////////////////////
+void JobScheduler::share(const std::string &prefix) {
+  pthread_mutex_lock(&mutex);
+
+  delete sweep;
+  sweep = new SharedSweep(prefix);
+
+  pthread_mutex_unlock(&mutex);
+
+  std::ostringstream buffer;
+  buffer << "Sharing the sweep through the " << prefix << " files.";
+  threadZero->recordEvent(buffer.str(), true, 0);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	recordResults
+// Description:		Adds the results of the current job of the
+//					worker to the results of its job in the sweep.
+//
+///////////////////////////////////////////////////////////////////
+void JobScheduler::recordResults(size_t worker, const std::string &results) {
+  pthread_mutex_lock(&mutex);
+
+  if (sweep != nullptr)
+    sharedJobs[queues[worker].current.index].results += results;
+
+  pthread_mutex_unlock(&mutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	mergeResults
+// Description:		Merges the results of the jobs of the shared
+//					sweep, if this process is the last to finish.
+//
+///////////////////////////////////////////////////////////////////
+void JobScheduler::mergeResults() const {
+  pthread_mutex_lock(&mutex);
+
+  if (sweep != nullptr && sweep->merge(sweepJobs) == false) {
+    std::ostringstream buffer;
+    buffer << "The results of the sweep are merged by the last process to "
+              "finish.";
+    threadZero->recordEvent(buffer.str(), true, 0);
+  }
+
+  pthread_mutex_unlock(&mutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getNumberOfJobs
+// Description:		Returns the number of jobs that are waiting to
+//					be handed out.
+//
+///////////////////////////////////////////////////////////////////
+size_t JobScheduler::getNumberOfJobs() const {
+  pthread_mutex_lock(&mutex);
+
+  size_t count = pending.size();
+
+  for (size_t q = 0; q < queues.size(); ++q) count += queues[q].jobs.size();
+
+  pthread_mutex_unlock(&mutex);
+
+  return count;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	printReport
+// Description:		Prints the estimated cost and the actual runtime
+//					of every job, along with the length of the sweep.
+//
+///////////////////////////////////////////////////////////////////
+void JobScheduler::printReport() const {
+  pthread_mutex_lock(&mutex);
+
+  double busy = 0.0;
+
+  for (size_t c = 0; c < completed.size(); ++c) {
+    const CompletedJob &job = completed[c];
+
+    std::ostringstream line;
+    line << "JOB " << threadZero->getRoutingAlgorithmName(job.config.ra) << "-"
+         << threadZero->getWavelengthAlgorithmName(job.config.wa)
+         << ", PROBE = " << threadZero->getProbeStyleName(job.config.ps)
+         << ", QA = " << job.config.qa
+         << ", WORKS = " << job.config.workstations;
+
+    if (job.config.replications != nullptr)
+      line << ", REPLICATION = " << job.config.replication;
+
+    line << ": ESTIMATE = " << job.estimate << ", RUN TIME = " << std::fixed
+         << std::setprecision(2) << job.seconds << "s, THREAD = " << job.worker
+         << (job.stolen == true ? " (STOLEN)" : "");
+    threadZero->recordEvent(line.str(), true, 0);
+
+    busy += job.seconds;
+  }
+
+  double makespan = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - startTime)
+                        .count();
+
+  std::ostringstream sweep;
+  sweep << "SWEEP TIME = " << std::fixed << std::setprecision(2) << makespan
+        << "s, BUSY TIME = " << busy << "s, THREADS = " << queues.size();
+  threadZero->recordEvent(sweep.str(), true, 0);
+
+  pthread_mutex_unlock(&mutex);
+}
@@ -18,12 +18,18 @@
 //
 // ____________________________________________________________________________
 
+#include "CpuAffinity.h"
 #include "ErrorCodes.h"
+#include "JobScheduler.h"
+#include "ResourceManager.h"
 #include "Thread.h"
+#include "Topology.h"
 
 #define HAVE_STRUCT_TIMESPEC
 #include "pthread.h"
 
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -77,19 +83,37 @@ Thread **threads = nullptr;
 
 size_t threadCount = 0;
 
-std::vector<AlgorithmToRun *> algParams;
+JobScheduler scheduler;
+
+CpuAffinity affinity;
+
+struct ThreadArgs {
+  size_t id;
+  int argc;
+  const char **argv;
+};
+
+// The arguments of one scenario of a sweep file.
+struct Scenario {
+  std::string topology;
+  std::string wavelengths;
+  std::string seed;
+  std::string probes;
+  std::string iterations;
+};
 
 void *runThread(void *n);
 void runSimulation(int argc, const char *argv[]);
-
-pthread_mutex_t ScheduleMutex;
+void runSweepFile(const char *program, const char *file, const char *threads);
 
 int main(int argc, const char *argv[]) {
-  if (argc != 7) {
+  if (argc != 7 && argc != 3) {
     std::cerr << "Usage: " << argv[0]
               << " <Topology> <Wavelengths> <Random Seed> <Thread Count> "
                  "<Iteration Count> <Probe Count>"
               << std::endl;
+    std::cerr << "       " << argv[0] << " <Sweep File> <Thread Count>"
+              << std::endl;
     std::cerr << std::endl;
 
     std::cerr << "Topology: NSF, Mesh, Mesh6x6, Mesh8x8, Mesh10x10"
@@ -100,6 +124,10 @@ int main(int argc, const char *argv[]) {
               << std::endl;
     std::cerr << "Iteration Count: <number of iterations, 1 to n>" << std::endl;
     std::cerr << "Probe Count: <number of probes, 1 to n>" << std::endl;
+    std::cerr << "Sweep File: <one line for each scenario of the form "
+                 "Scenario=<Topology>,<Wavelengths>,<Random Seed>,"
+                 "<Probe Count>,<Iteration Count>>"
+              << std::endl;
 
     return ERROR_INVALID_PARAMETERS;
   }
@@ -168,12 +196,96 @@ int main(int argc, const char *argv[]) {
 
   al_uninstall_system();
 #else
-  runSimulation(argc, argv);
+  if (argc == 3)
+    runSweepFile(argv[0], argv[1], argv[2]);
+  else
+    runSimulation(argc, argv);
+
+  ResourceManager::clearPhysicsCache();
+  Topology::clearCache();
 #endif
 
   return 0;
 }
 
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	runSweepFile
+// Description:		Runs each of the scenarios in the sweep file in
+//					turn. The scenarios share the topologies and
+//					the physics tables, so they are only built once
+//					for each topology and wavelength grid.
+//
+///////////////////////////////////////////////////////////////////
+void runSweepFile(const char *program, const char *file, const char *threads) {
+  std::ifstream in(file);
+
+  if (in.is_open() == false) {
+    std::cerr << "ERROR: Unable to open the sweep file " << file << "."
+              << std::endl;
+    exit(ERROR_SWEEP_FILE);
+  }
+
+  std::vector<Scenario> scenarios;
+
+  std::string line;
+  size_t lineNumber = 0;
+
+  while (std::getline(in, line)) {
+    ++lineNumber;
+
+    if (line.empty() == false && line[line.size() - 1] == '\r')
+      line.erase(line.size() - 1);
+
+    if (line.empty() == true) continue;
+
+    std::vector<std::string> param = Thread::split(line, '=');
+    std::vector<std::string> values;
+
+    if (param.size() == 2 && param[0] == "Scenario")
+      values = Thread::split(param[1], ',');
+
+    if (values.size() != 5) {
+      std::cerr << "ERROR: Invalid scenario on line " << lineNumber
+                << " of the sweep file " << file << "." << std::endl;
+      exit(ERROR_SWEEP_FILE);
+    }
+
+    Scenario scenario;
+    scenario.topology = values[0];
+    scenario.wavelengths = values[1];
+    scenario.seed = values[2];
+    scenario.probes = values[3];
+    scenario.iterations = values[4];
+
+    scenarios.push_back(scenario);
+  }
+
+  in.close();
+
+  if (scenarios.empty() == true) {
+    std::cerr << "ERROR: No scenarios in the sweep file " << file << "."
+              << std::endl;
+    exit(ERROR_SWEEP_FILE);
+  }
+
+  for (size_t s = 0; s < scenarios.size(); ++s) {
+    const char *argv[7] = {program,
+                           scenarios[s].topology.c_str(),
+                           scenarios[s].wavelengths.c_str(),
+                           scenarios[s].seed.c_str(),
+                           threads,
+                           scenarios[s].iterations.c_str(),
+                           scenarios[s].probes.c_str()};
+
+    std::cout << "Running scenario " << s + 1 << " of " << scenarios.size()
+              << ": " << argv[1] << " " << argv[2] << " " << argv[3] << " "
+              << argv[4] << " " << argv[5] << " " << argv[6] << std::endl;
+
+    runSimulation(7, argv);
+  }
+}
+
 void runSimulation(int argc, const char *argv[]) {
   int *threadZeroReturn = 0;
 
@@ -199,15 +311,26 @@ void runSimulation(int argc, const char *argv[]) {
   rectfill(screen, 0, 0, SCREEN_W, 40, color);
 #endif
 
-  pthread_mutex_init(&ScheduleMutex, nullptr);
+  if (threadCount > scheduler.getNumberOfJobs())
+    threadCount = scheduler.getNumberOfJobs();
+
+  if (threadZero->getQualityParams().thread_affinity == true)
+    affinity.enable();
+  else
+    affinity.disable();
 
-  if (threadCount > algParams.size()) threadCount = algParams.size();
+  if (threadZero->getQualityParams().shared_sweep == true) {
+    std::ostringstream prefix;
+    prefix << "output/Sweep-" << argv[1] << "-" << argv[2] << "-" << argv[3]
+           << "-" << argv[5] << "-" << argv[6];
 
+    scheduler.share(prefix.str());
+  }
+
+  // The other threads are created by their own pthread, see runThread.
   for (size_t t = 1; t < threadCount; ++t) {
-    Thread *thread = new Thread(t, argc, argv, false);
+    threads[t] = nullptr;
     pThreads.push_back(new pthread_t);
-
-    thread->initResourceManager();
   }
 
   std::ostringstream buffer;
@@ -215,9 +338,15 @@ void runSimulation(int argc, const char *argv[]) {
   threadZero->recordEvent(buffer.str(), true, 0);
   threadZero->flushLog(true);
 
+  scheduler.start(threadCount, threadZero->getNumberOfWavelengths());
+
   for (size_t t = 1; t < threadCount; ++t) {
-    int ret_code =
-        pthread_create(pThreads[t - 1], nullptr, runThread, new size_t(t));
+    ThreadArgs *args = new ThreadArgs;
+    args->id = t;
+    args->argc = argc;
+    args->argv = argv;
+
+    int ret_code = pthread_create(pThreads[t - 1], nullptr, runThread, args);
 
     if (ret_code != 0) {
       std::cerr << "ERROR: Thread creation failed with code: " << ret_code
@@ -226,7 +355,12 @@ void runSimulation(int argc, const char *argv[]) {
     }
   }
 
-  threadZeroReturn = static_cast<int *>(runThread(new size_t(0)));
+  ThreadArgs *args = new ThreadArgs;
+  args->id = 0;
+  args->argc = argc;
+  args->argv = argv;
+
+  threadZeroReturn = static_cast<int *>(runThread(args));
 
   for (size_t t = 1; t < threadCount; ++t) {
     pthread_join(*pThreads[t - 1], nullptr);
@@ -237,7 +371,17 @@ void runSimulation(int argc, const char *argv[]) {
 #endif
   }
 
-  for (size_t t = 0; t < threadCount; ++t) {
+  // This thread was pinned as thread zero, and runs the next scenario of a
+  // sweep file, whose threads would otherwise inherit its single core.
+  affinity.unpin();
+
+  scheduler.printReport();
+  scheduler.mergeResults();
+  threadZero->flushLog(true);
+
+  // Thread zero owns the resource manager and logger the other threads
+  // share, so it is deleted last.
+  for (size_t t = threadCount; t-- > 0;) {
     delete threads[t];
 
     if (t != 0) delete pThreads[t - 1];
@@ -247,10 +391,14 @@ void runSimulation(int argc, const char *argv[]) {
 
   pThreads.clear();
 
-  pthread_mutex_destroy(&ScheduleMutex);
-
   delete threadZeroReturn;
 
+  threadZero = nullptr;
+  threads = nullptr;
+  threadCount = 0;
+
+  scheduler.reset();
+
 #ifndef NO_ALLEGRO
 
   explore_time = 0;
@@ -260,27 +408,49 @@ void runSimulation(int argc, const char *argv[]) {
 }
 
 void *runThread(void *n) {
-  size_t *t_id = static_cast<size_t *>(n);
+  ThreadArgs *args = static_cast<ThreadArgs *>(n);
+  size_t t_id = args->id;
+
+  size_t slot = t_id * threadZero->getQualityParams().run_workers;
+
+  if (affinity.pin(slot) == true) {
+    std::ostringstream buffer;
+    buffer << "Thread " << t_id << " pinned to core " << affinity.getCpu(slot)
+           << ".";
+    threadZero->recordEvent(buffer.str(), true, 0);
+  }
+
+  // Each thread builds its own network once it has been pinned, so that the
+  // memory is first touched, and so placed, on the node of its core.
+  if (t_id != 0) {
+    Thread *thread = new Thread(t_id, args->argc, args->argv, false);
+
+    thread->initResourceManager();
+  }
 
   int *retVal = new int;
 
-  while (algParams.size() > 0) {
-    pthread_mutex_lock(&ScheduleMutex);
+  while (true) {
+    AlgorithmToRun *alg = scheduler.getNextJob(t_id);
+
+    if (alg == nullptr) break;
 
-    AlgorithmToRun *alg = algParams.back();
-    algParams.pop_back();
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
 
-    pthread_mutex_unlock(&ScheduleMutex);
+    *retVal = threads[t_id]->runThread(alg);
 
-    *retVal = threads[*t_id]->runThread(alg);
+    scheduler.completeJob(t_id, std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count());
 
 #ifndef NO_ALLEGRO
     textprintf_ex(screen, font, 20, SCREEN_H - 30, color2, color, "%s", folder);
-    threads[*t_id]->saveThread(folder);
+    threads[t_id]->saveThread(folder);
 #endif
   }
 
-  delete t_id;
+  delete args;
 
   return retVal;
 }
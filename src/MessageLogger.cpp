@@ -34,7 +34,8 @@ extern Thread* threadZero;
 //
 ///////////////////////////////////////////////////////////////////
 MessageLogger::MessageLogger(const std::string& topo, const std::string& lambda,
-                             const std::string& seed, const std::string& k) {
+                             const std::string& seed, const std::string& k)
+    : capturing(false), captureIndex(0) {
   pthread_mutex_init(&LogMutex, nullptr);
   pthread_mutex_init(&PrintMutex, nullptr);
   pthread_mutex_init(&ResultsMutex, nullptr);
@@ -96,6 +97,9 @@ void MessageLogger::recordEvent(const std::string& e, bool print, size_t ci) {
 
   eventLogger << message.str();
 
+  if (capturing == true && print == true && ci == captureIndex)
+    capture << e << std::endl;
+
   pthread_mutex_unlock(&LogMutex);
 
   if (print == true) {
@@ -122,3 +126,38 @@ void MessageLogger::flushLog(bool print) {
     pthread_mutex_unlock(&PrintMutex);
   }
 }
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	startCapture
+// Description:		Starts keeping a copy of the messages printed for
+//					the thread.
+//
+///////////////////////////////////////////////////////////////////
+void MessageLogger::startCapture(size_t ci) {
+  pthread_mutex_lock(&LogMutex);
+
+  capture.str("");
+  captureIndex = ci;
+  capturing = true;
+
+  pthread_mutex_unlock(&LogMutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	stopCapture
+// Description:		Stops the capture and returns the messages
+//
+///////////////////////////////////////////////////////////////////
+std::string MessageLogger::stopCapture() {
+  pthread_mutex_lock(&LogMutex);
+
+  capturing = false;
+  std::string captured = capture.str();
+  capture.str("");
+
+  pthread_mutex_unlock(&LogMutex);
+
+  return captured;
+}
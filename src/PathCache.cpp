@@ -0,0 +1,124 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      PathCache.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the PathCache.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Shortest paths shared across the sweep.
+//
+// ____________________________________________________________________________
+
+#include "PathCache.h"
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	PathCache
+// Description:		Creates an empty cache for the given number of
+//					routers.
+//
+///////////////////////////////////////////////////////////////////
+PathCache::PathCache(size_t r) : routers(r), entries(r * r) {
+  pthread_rwlock_init(&lock, nullptr);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	~PathCache
+// Description:		Deletes all of the cached paths
+//
+///////////////////////////////////////////////////////////////////
+PathCache::~PathCache() {
+  for (size_t p = 0; p < entries.size(); ++p)
+    for (size_t e = 0; e < entries[p].size(); ++e)
+      deletePaths(entries[p][e].paths);
+
+  pthread_rwlock_destroy(&lock);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	lookup
+// Description:		Searches the entries of the pair of routers, the
+//					caller must hold the lock.
+//
+///////////////////////////////////////////////////////////////////
+kShortestPathReturn *PathCache::lookup(size_t src, size_t dest, size_t k,
+                                       PathCostModel model) const {
+  const std::vector<Entry> &pair = entries[src * routers + dest];
+
+  for (size_t e = 0; e < pair.size(); ++e) {
+    if (pair[e].k == k && pair[e].model == model) return pair[e].paths;
+  }
+
+  return nullptr;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	find
+// Description:		Returns the cached paths, if there are any
+//
+///////////////////////////////////////////////////////////////////
+kShortestPathReturn *PathCache::find(size_t src, size_t dest, size_t k,
+                                     PathCostModel model) const {
+  pthread_rwlock_rdlock(&lock);
+
+  kShortestPathReturn *paths = lookup(src, dest, k, model);
+
+  pthread_rwlock_unlock(&lock);
+
+  return paths;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	insert
+// Description:		Adds the paths to the cache, unless they were
+//					added by another thread in the meantime.
+//
+///////////////////////////////////////////////////////////////////
+kShortestPathReturn *PathCache::insert(size_t src, size_t dest, size_t k,
+                                       PathCostModel model,
+                                       kShortestPathReturn *paths) {
+  pthread_rwlock_wrlock(&lock);
+
+  kShortestPathReturn *cached = lookup(src, dest, k, model);
+
+  if (cached == nullptr) {
+    Entry entry;
+    entry.k = k;
+    entry.model = model;
+    entry.paths = paths;
+
+    entries[src * routers + dest].push_back(entry);
+
+    cached = paths;
+  }
+
+  pthread_rwlock_unlock(&lock);
+
+  if (cached != paths) deletePaths(paths);
+
+  return cached;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	deletePaths
+// Description:		Frees the memory of a set of paths
+//
+///////////////////////////////////////////////////////////////////
+void PathCache::deletePaths(kShortestPathReturn *paths) {
+  delete[] paths->pathcost;
+  delete[] paths->pathinfo;
+  delete[] paths->pathlen;
+
+  delete paths;
+}
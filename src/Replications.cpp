@@ -0,0 +1,237 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      Replications.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the
+//					ReplicationSet and RunningStat.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Independent replications with confidence intervals.
+//
+// ____________________________________________________________________________
+
+#include "Replications.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+
+#include "Thread.h"
+
+extern Thread *threadZero;
+
+// Two sided 95% critical values of the Student t distribution for 1 to 30
+// degrees of freedom, the normal value is used beyond that.
+static const double T_95[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447,
+                              2.365,  2.306, 2.262, 2.228, 2.201, 2.179,
+                              2.160,  2.145, 2.131, 2.120, 2.110, 2.101,
+                              2.093,  2.086, 2.080, 2.074, 2.069, 2.064,
+                              2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	add
+// Description:		Adds a new observation to the running statistic
+//
+///////////////////////////////////////////////////////////////////
+void RunningStat::add(double x) {
+  ++count;
+
+  double delta = x - mean;
+  mean += delta / double(count);
+  m2 += delta * (x - mean);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getVariance
+// Description:		Returns the sample variance of the observations
+//
+///////////////////////////////////////////////////////////////////
+double RunningStat::getVariance() const {
+  if (count < 2) return 0.0;
+
+  return m2 / double(count - 1);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getHalfWidth
+// Description:		Returns the half width of the 95% confidence
+//					interval of the mean, or infinity if there are
+//					not enough observations for one.
+//
+///////////////////////////////////////////////////////////////////
+double RunningStat::getHalfWidth() const {
+  if (count < 2) return std::numeric_limits<double>::infinity();
+
+  size_t df = count - 1;
+  double t = df <= 30 ? T_95[df - 1] : 1.96;
+
+  return t * sqrt(getVariance() / double(count));
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	ReplicationSet
+// Description:		Creates the set of replications for the given
+//					configuration.
+//
+///////////////////////////////////////////////////////////////////
+ReplicationSet::ReplicationSet(const AlgorithmToRun &c, size_t minR,
+                               size_t maxR, double hw)
+    : config(c),
+      minReplications(minR < maxR ? minR : maxR),
+      maxReplications(maxR),
+      targetHalfWidth(hw),
+      launched(0),
+      completed(0) {
+  pthread_mutex_init(&mutex, nullptr);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	~ReplicationSet
+// Description:		Default destructor
+//
+///////////////////////////////////////////////////////////////////
+ReplicationSet::~ReplicationSet() { pthread_mutex_destroy(&mutex); }
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	createReplication
+// Description:		Creates the job for the next replication of the
+//					configuration.
+//
+///////////////////////////////////////////////////////////////////
+AlgorithmToRun *ReplicationSet::createReplication() {
+  AlgorithmToRun *ap = new AlgorithmToRun(config);
+
+  ap->replication = launched++;
+  ap->replications = this;
+
+  return ap;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	addReplication
+// Description:		Adds the statistics of a completed replication
+//					and launches another one if the blocking has
+//					not converged yet.
+//
+///////////////////////////////////////////////////////////////////
+AlgorithmToRun *ReplicationSet::addReplication(const GlobalStats &stats,
+                                               size_t ci, bool *finished) {
+  pthread_mutex_lock(&mutex);
+
+  // A replication without requests counts as no blocking, and one without
+  // successes has no setup delay to add.
+  double requests = double(stats.ConnectionRequests);
+
+  if (requests == 0.0) requests = 1.0;
+
+  blocking.add(
+      double(stats.ConnectionRequests - stats.ConnectionSuccesses) / requests);
+  collisions.add(double(stats.CollisionFailures) / requests);
+  quality.add(double(stats.QualityFailures) / requests);
+  resources.add(double(stats.NoPathFailures) / requests);
+  probes.add(double(stats.ProbeSentCount) / requests);
+
+  if (stats.ConnectionSuccesses > 0)
+    delay.add(stats.totalSetupDelay / double(stats.ConnectionSuccesses));
+
+  ++completed;
+
+  AlgorithmToRun *next = nullptr;
+
+  // Once the minimum number has been launched, the replications are
+  // added one at a time so that no more are run than are needed.
+  if (completed >= minReplications && launched == completed &&
+      launched < maxReplications &&
+      blocking.getHalfWidth() > targetHalfWidth) {
+    next = createReplication();
+  }
+
+  *finished = (next == nullptr && completed == launched);
+
+  if (*finished == true) printSummary(ci);
+
+  pthread_mutex_unlock(&mutex);
+
+  return next;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getReplicationSeed
+// Description:		Derives the seed of a replication from the seed
+//					given on the command line.
+//
+///////////////////////////////////////////////////////////////////
+unsigned int ReplicationSet::getReplicationSeed(size_t baseSeed,
+                                                size_t replication) {
+  std::seed_seq seq{static_cast<unsigned int>(baseSeed),
+                    static_cast<unsigned int>(replication)};
+
+  unsigned int seed = 0;
+  seq.generate(&seed, &seed + 1);
+
+  return seed;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	printSummary
+// Description:		Prints the aggregated results of all of the
+//					replications of the configuration.
+//
+///////////////////////////////////////////////////////////////////
+void ReplicationSet::printSummary(size_t ci) const {
+  std::ostringstream algorithm;
+  algorithm << "**REPLICATIONS SUMMARY, ALGORITHM = "
+            << threadZero->getRoutingAlgorithmName(config.ra) << "-"
+            << threadZero->getWavelengthAlgorithmName(config.wa)
+            << ", WORKS = " << config.workstations
+            << ", PROBE = " << threadZero->getProbeStyleName(config.ps)
+            << ", QA = " << config.qa;
+  threadZero->recordEvent(algorithm.str(), true, ci);
+
+  std::ostringstream reason;
+  reason << "REPLICATIONS = " << completed << ", STOP REASON = "
+         << (blocking.getHalfWidth() <= targetHalfWidth ? "CONVERGED"
+                                                        : "MAX REPLICATIONS");
+  threadZero->recordEvent(reason.str(), true, ci);
+
+  std::ostringstream overall;
+  overall << "OVERALL BLOCKING MEAN = " << blocking.getMean()
+          << ", VARIANCE = " << blocking.getVariance() << ", 95% CI = ["
+          << blocking.getMean() - blocking.getHalfWidth() << ", "
+          << blocking.getMean() + blocking.getHalfWidth() << "]";
+  threadZero->recordEvent(overall.str(), true, ci);
+
+  const RunningStat *metrics[] = {&collisions, &quality, &resources, &probes,
+                                  &delay};
+  const char *names[] = {"COLLISIONS", "BAD QUALITY", "NON RESOURCES",
+                         "AVERAGE PROBES PER REQUEST",
+                         "AVERAGE REQUEST DELAY TIME"};
+
+  for (size_t m = 0; m < 5; ++m) {
+    std::ostringstream metric;
+    metric << names[m] << " MEAN = " << metrics[m]->getMean()
+           << " +/- " << metrics[m]->getHalfWidth();
+    threadZero->recordEvent(metric.str(), true, ci);
+  }
+
+  std::ostringstream stars;
+  stars << std::string("**********************************************")
+        << std::endl;
+  threadZero->recordEvent(stars.str(), true, ci);
+}
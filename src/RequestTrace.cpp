@@ -0,0 +1,411 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      RequestTrace.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the
+//					RequestTrace.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Binary trace of the request stream.
+//
+// ____________________________________________________________________________
+
+#include "RequestTrace.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Thread.h"
+#include "pthread.h"
+
+extern Thread *threadZero;
+
+const char RequestTrace::MAGIC[8] = {'R', 'A', 'P', 'T', 'O', 'R', 'T', 'R'};
+const unsigned long long RequestTrace::VERSION = 1;
+
+// Several threads may ask for the same trace at once, only one of them
+// records it.
+static pthread_mutex_t TraceMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Draws the requests of the workstations in exactly the same way as
+// Thread::generateTrafficEvent does.
+class TraceGenerator {
+ public:
+  TraceGenerator(const Thread *t, const TraceHeader &h)
+      : thread(t),
+        header(h),
+        generator(static_cast<unsigned int>(h.seed)),
+        generateZeroToOne(0, 1),
+        generateRandomRouter(0, h.routers - 1),
+        generateRandomDuration(1.0 / h.duration),
+        generateArrivalInterval(1.0 / h.arrivalInterval) {}
+
+  TraceRecord next(size_t workstation, double now);
+
+  std::default_random_engine &getGenerator() { return generator; }
+
+ private:
+  const Thread *thread;
+  const TraceHeader &header;
+
+  std::default_random_engine generator;
+
+  std::uniform_real_distribution<double> generateZeroToOne;
+  std::uniform_int_distribution<size_t> generateRandomRouter;
+  std::exponential_distribution<double> generateRandomDuration;
+  std::exponential_distribution<double> generateArrivalInterval;
+};
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	next
+// Description:		Draws the next request of the workstation, made
+//					at the given time.
+//
+///////////////////////////////////////////////////////////////////
+TraceRecord TraceGenerator::next(size_t workstation, double now) {
+  TraceRecord r;
+
+  r.arrivalTime = now + generateArrivalInterval(generator);
+  r.duration = generateRandomDuration(generator);
+
+  if (r.duration < header.minDuration) r.duration = header.minDuration;
+
+  size_t source = thread->getWorkstationAt(workstation)->getParentRouterIndex();
+  size_t destination = source;
+
+  while (source == destination) {
+    if (header.destDist == UNIFORM)
+      destination = generateRandomRouter(generator);
+    else if (header.destDist == DISTANCE || header.destDist == INVERSE_DISTANCE)
+      destination = thread->getRouterAt(source)->generateDestination(
+          generateZeroToOne(generator));
+  }
+
+  r.destination = destination;
+
+  return r;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	RequestTrace
+// Description:		Creates an empty trace for the given file
+//
+///////////////////////////////////////////////////////////////////
+RequestTrace::RequestTrace(const std::string &f)
+    : file(f),
+      mapping(nullptr),
+      length(0),
+      header(nullptr),
+      order(nullptr),
+      offsets(nullptr),
+      records(nullptr) {}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	~RequestTrace
+// Description:		Unmaps the trace
+//
+///////////////////////////////////////////////////////////////////
+RequestTrace::~RequestTrace() { unmap(); }
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	open
+// Description:		Maps in the trace stored in the file, recording
+//					it first if the file is missing or was recorded
+//					with different settings.
+//
+///////////////////////////////////////////////////////////////////
+RequestTrace *RequestTrace::open(const std::string &f, const Thread *t,
+                                 unsigned int seed, size_t activeWorkstations,
+                                 double stopTime) {
+  const QualityParameters &qp = threadZero->getQualityParams();
+
+  TraceHeader h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, MAGIC, sizeof(MAGIC));
+  h.version = VERSION;
+  h.seed = seed;
+  h.routers = t->getNumberOfRouters();
+  h.workstations = t->getNumberOfWorkstations();
+  h.activeWorkstations = activeWorkstations;
+  h.destDist = qp.dest_dist;
+  h.arrivalInterval = qp.arrival_interval;
+  h.duration = qp.duration;
+  h.minDuration = threadZero->getMinDuration();
+  h.stopTime = stopTime;
+
+  pthread_mutex_lock(&TraceMutex);
+
+  RequestTrace *trace = new RequestTrace(f);
+
+  std::ostringstream buffer;
+
+  if (trace->map() == true && trace->matches(h) == true) {
+    buffer << "Replaying the request trace " << f;
+  } else {
+    trace->unmap();
+    trace->record(t, h);
+
+    buffer << "Recorded the request trace " << f;
+  }
+
+  threadZero->recordEvent(buffer.str(), false, t->getControllerIndex());
+
+  pthread_mutex_unlock(&TraceMutex);
+
+  return trace;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	map
+// Description:		Maps the file into memory. Returns false if the
+//					file is missing or is not a complete trace.
+//
+///////////////////////////////////////////////////////////////////
+bool RequestTrace::map() {
+  const char *base = nullptr;
+
+#ifdef _WIN32
+  std::ifstream in(file.c_str(), std::ios::in | std::ios::binary);
+
+  if (!in.is_open()) return false;
+
+  in.seekg(0, std::ios::end);
+  length = static_cast<size_t>(in.tellg());
+  in.seekg(0, std::ios::beg);
+
+  if (length < sizeof(TraceHeader)) return false;
+
+  buffer.resize(length);
+  in.read(&buffer[0], length);
+
+  if (!in.good()) return false;
+
+  base = &buffer[0];
+#else
+  int fd = ::open(file.c_str(), O_RDONLY);
+
+  if (fd < 0) return false;
+
+  struct stat st;
+
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(TraceHeader)) {
+    ::close(fd);
+    return false;
+  }
+
+  length = size_t(st.st_size);
+  mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+
+  if (mapping == MAP_FAILED) {
+    mapping = nullptr;
+    return false;
+  }
+
+  base = static_cast<const char *>(mapping);
+#endif
+
+  header = reinterpret_cast<const TraceHeader *>(base);
+
+  size_t workstations = header->workstations;
+
+  order = reinterpret_cast<const unsigned long long *>(base + sizeof(TraceHeader));
+  offsets = order + workstations;
+  records = reinterpret_cast<const TraceRecord *>(offsets + workstations + 1);
+
+  size_t expected = sizeof(TraceHeader) +
+                    sizeof(unsigned long long) * (2 * workstations + 1) +
+                    sizeof(TraceRecord) * header->records;
+
+  if (length != expected) return false;
+
+  return offsets[workstations] == header->records;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	unmap
+// Description:		Releases the memory holding the trace
+//
+///////////////////////////////////////////////////////////////////
+void RequestTrace::unmap() {
+#ifndef _WIN32
+  if (mapping != nullptr) munmap(mapping, length);
+#endif
+
+  mapping = nullptr;
+  length = 0;
+  buffer.clear();
+
+  header = nullptr;
+  order = nullptr;
+  offsets = nullptr;
+  records = nullptr;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	matches
+// Description:		Returns true if the trace was recorded with the
+//					settings in the given header.
+//
+///////////////////////////////////////////////////////////////////
+bool RequestTrace::matches(const TraceHeader &h) const {
+  return memcmp(header->magic, h.magic, sizeof(h.magic)) == 0 &&
+         header->version == h.version && header->seed == h.seed &&
+         header->routers == h.routers &&
+         header->workstations == h.workstations &&
+         header->activeWorkstations == h.activeWorkstations &&
+         header->destDist == h.destDist &&
+         header->arrivalInterval == h.arrivalInterval &&
+         header->duration == h.duration &&
+         header->minDuration == h.minDuration &&
+         header->stopTime == h.stopTime;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	record
+// Description:		Draws every request up to the stop time and
+//					saves them to the file. The requests are drawn
+//					in the order in which a run handles them, so the
+//					trace holds the same workload as a run starting
+//					from the same seed would have drawn itself.
+//
+///////////////////////////////////////////////////////////////////
+void RequestTrace::record(const Thread *t, const TraceHeader &h) {
+  size_t workstations = h.workstations;
+
+  TraceGenerator generator(t, h);
+
+  // The activation order is drawn as in activate_workstations.
+  std::vector<unsigned long long> workstationOrder(workstations);
+  std::vector<bool> active(workstations, false);
+
+  std::uniform_int_distribution<size_t> generateRandomWorkstation(
+      0, workstations - 1);
+
+  size_t numberFound = 0;
+
+  while (numberFound < workstations) {
+    size_t wkstn = generateRandomWorkstation(generator.getGenerator());
+
+    if (active[wkstn] == false) {
+      workstationOrder[numberFound] = wkstn;
+      active[wkstn] = true;
+
+      numberFound++;
+    }
+  }
+
+  active.assign(workstations, false);
+
+  for (size_t w = 0; w < h.activeWorkstations; ++w)
+    active[workstationOrder[w]] = true;
+
+  std::vector<std::vector<TraceRecord> > streams(workstations);
+
+  typedef std::pair<double, size_t> Pending;
+  std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending> >
+      pending;
+
+  for (size_t w = 0; w < workstations; ++w) {
+    if (active[w] == true) {
+      streams[w].push_back(generator.next(w, 0.0));
+      pending.push(Pending(streams[w].back().arrivalTime, w));
+    }
+  }
+
+  // Each request draws the next one of its workstation when it is handled,
+  // as long as the run has not reached the stop time.
+  while (pending.empty() == false) {
+    Pending p = pending.top();
+    pending.pop();
+
+    if (p.first < h.stopTime) {
+      streams[p.second].push_back(generator.next(p.second, p.first));
+      pending.push(Pending(streams[p.second].back().arrivalTime, p.second));
+    }
+  }
+
+  std::vector<unsigned long long> streamOffsets(workstations + 1, 0);
+
+  for (size_t w = 0; w < workstations; ++w)
+    streamOffsets[w + 1] = streamOffsets[w] + streams[w].size();
+
+  TraceHeader recorded = h;
+  recorded.records = streamOffsets[workstations];
+
+  length = sizeof(TraceHeader) +
+           sizeof(unsigned long long) * (2 * workstations + 1) +
+           sizeof(TraceRecord) * recorded.records;
+
+  buffer.resize(length);
+
+  char *base = &buffer[0];
+  char *next = base;
+
+  memcpy(next, &recorded, sizeof(TraceHeader));
+  next += sizeof(TraceHeader);
+
+  memcpy(next, &workstationOrder[0], sizeof(unsigned long long) * workstations);
+  next += sizeof(unsigned long long) * workstations;
+
+  memcpy(next, &streamOffsets[0],
+         sizeof(unsigned long long) * (workstations + 1));
+  next += sizeof(unsigned long long) * (workstations + 1);
+
+  for (size_t w = 0; w < workstations; ++w) {
+    if (streams[w].empty() == false) {
+      memcpy(next, &streams[w][0], sizeof(TraceRecord) * streams[w].size());
+      next += sizeof(TraceRecord) * streams[w].size();
+    }
+  }
+
+  header = reinterpret_cast<const TraceHeader *>(base);
+  order = reinterpret_cast<const unsigned long long *>(base + sizeof(TraceHeader));
+  offsets = order + workstations;
+  records = reinterpret_cast<const TraceRecord *>(offsets + workstations + 1);
+
+  // The trace is written under a temporary name first, so that a crash never
+  // leaves a partial trace behind. A failed write does not stop the run, the
+  // trace is simply recorded again next time.
+  std::string temp = file + ".tmp";
+
+  std::ofstream out(temp.c_str(),
+                    std::ios::out | std::ios::binary | std::ios::trunc);
+  out.write(base, length);
+  out.close();
+
+  std::remove(file.c_str());
+
+  if (out.fail() || std::rename(temp.c_str(), file.c_str()) != 0) {
+    std::ostringstream error;
+    error << "Unable to write the request trace file " << file << ".";
+    threadZero->recordEvent(error.str(), true, t->getControllerIndex());
+  }
+}
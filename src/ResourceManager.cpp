@@ -25,21 +25,121 @@
 #include "ErrorCodes.h"
 #include "OctaveWrapper.h"
 #include "Thread.h"
+#include "Topology.h"
 
 #define HAVE_STRUCT_TIMESPEC
 #include "pthread.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iomanip>
+#include <map>
 #include <sstream>
+#include <vector>
 
 extern Thread* threadZero;
 extern Thread** threads;
 
 extern "C" void calc_k_shortest_paths(const kShortestPathParms& params,
                                       kShortestPathReturn* retVal);
+extern "C" void calc_shortest_path_tree(const kShortestPathParms& params,
+                                        kShortestPathReturn* retVal);
+extern "C" KShortestPaths* create_k_shortest_paths(
+    const kShortestPathParms& params);
+extern "C" void continue_k_shortest_paths(KShortestPaths* search,
+                                          const kShortestPathParms& params,
+                                          kShortestPathReturn* retVal);
+
+// Arguments shared by the iterations that are handed to the WorkerPool of
+// the thread. Every iteration only writes to its own slot of the outputs.
+struct IAPathTask {
+  size_t src_index;
+  size_t dest_index;
+  const std::vector<kShortestPathEdges>* edges;
+  const std::vector<unsigned long long>* freeEdges;
+  size_t words;
+  const std::vector<size_t>* searchWavelengths;
+  kShortestPathReturn* paths;
+  size_t stride;
+};
+
+struct SpanTreeTask {
+  const kShortestPathParms* params;
+  kShortestPathReturn* trees;
+};
+
+// The span file starts with this header, followed by the cost, the length and
+// the routers of the shortest path of every pair of different routers, in the
+// order of the source and then the destination. The paths by hop count come
+// first and then the ones by span count, in the order of the PathCostModel.
+struct SpanFileHeader {
+  char magic[8];
+  unsigned long long version;
+  unsigned long long topologyHash;
+  unsigned long long routers;
+};
+
+static const char SPAN_FILE_MAGIC[8] = {'R', 'A', 'P', 'T', 'O', 'R', 'S', 'P'};
+static const unsigned long long SPAN_FILE_VERSION = 2;
+
+struct QualityTask {
+  const ResourceManager* rm;
+  CreateConnectionProbeEvent* ccpe;
+  bool* wave_available;
+  size_t ci;
+  double* q;
+  double* xpm;
+  double* fwm;
+  double* ase;
+};
+
+// A list of wavelengths on a path whose Q factors are estimated by the
+// WorkerPool, the outputs are in the order of the list.
+struct WaveListTask {
+  const ResourceManager* rm;
+  Edge** path;
+  size_t pathLen;
+  const size_t* waves;
+  size_t ci;
+  double* q;
+  double* xpm;
+  double* fwm;
+  double* ase;
+};
+
+static void calculate_IA_search(size_t s, void* arg);
+static void calculate_span_tree(size_t r, void* arg);
+static void estimate_Q_wavelength(size_t w, void* arg);
+static void estimate_Q_listed(size_t i, void* arg);
+
+// The tables of the nonlinear impairments only depend on the wavelength grid
+// and the fiber, so the scenarios of a sweep that share them build them once.
+struct PhysicsTables {
+  size_t wavelengths;
+  double fc;
+  double f_step;
+  int halfwavelength;
+  int nonlinear_halfwin;
+  double channel_power;
+  double D;
+  double alphaDB;
+  double gamma;
+
+  double* sys_fs;
+  double* sys_link_xpm_database;
+  std::vector<double*>* fwm_fs;
+  std::vector<long long int*>* inter_indecies;
+  std::vector<long long int>* fwm_combinations;
+};
+
+static std::vector<PhysicsTables> PhysicsCache;
+
+// The Octave interpreter is only started once for the whole program.
+static OctaveWrapper* Octave = nullptr;
 
 ///////////////////////////////////////////////////////////////////
 //
@@ -53,51 +153,128 @@ ResourceManager::ResourceManager()
       inter_indecies(nullptr),
       span_distance(nullptr),
       sys_fs_num(0),
-      SP_paths(nullptr),
+      pathCache(new PathCache(threadZero->getNumberOfRouters())),
       kSP_edgeList(nullptr),
       wave_ordering(nullptr),
-      sys_fs(new double[threadZero->getNumberOfWavelengths()]),
-      sys_link_xpm_database(new double[threadZero->getNumberOfWavelengths() *
-                                       threadZero->getNumberOfWavelengths()]) {
+      sys_fs(nullptr),
+      sys_link_xpm_database(nullptr) {
   calc_min_spans();
 
-  OctaveWrapper ow;
-  ow.build_nonlinear_datastructure(sys_fs, sys_link_xpm_database);
+  if (threadZero->getQualityParams().candidate_paths > 0)
+    build_candidate_pool();
+
+  loadPhysicsTables();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	loadPhysicsTables
+// Description:		Uses the physics tables of an earlier scenario
+//					with the same wavelength grid and fiber, or
+//					builds them if there is none.
+//
+///////////////////////////////////////////////////////////////////
+void ResourceManager::loadPhysicsTables() {
+  const QualityParameters& qp = threadZero->getQualityParams();
+  size_t w = threadZero->getNumberOfWavelengths();
+
+  for (size_t c = 0; c < PhysicsCache.size(); ++c) {
+    const PhysicsTables& p = PhysicsCache[c];
+
+    if (p.wavelengths == w && p.fc == qp.fc && p.f_step == qp.f_step &&
+        p.halfwavelength == qp.halfwavelength &&
+        p.nonlinear_halfwin == qp.nonlinear_halfwin &&
+        p.channel_power == qp.channel_power && p.D == qp.D &&
+        p.alphaDB == qp.alphaDB && p.gamma == qp.gamma) {
+      sys_fs = p.sys_fs;
+      sys_link_xpm_database = p.sys_link_xpm_database;
+      fwm_fs = p.fwm_fs;
+      inter_indecies = p.inter_indecies;
+      fwm_combinations = p.fwm_combinations;
+
+      std::ostringstream buffer;
+      buffer << "Reusing the physics tables of the " << w
+             << " wavelength grid.";
+      threadZero->recordEvent(buffer.str(), true, 0);
+
+      return;
+    }
+  }
+
+  sys_fs = new double[w];
+  sys_link_xpm_database = new double[w * w];
+
+  if (Octave == nullptr) Octave = new OctaveWrapper;
+
+  Octave->build_nonlinear_datastructure(sys_fs, sys_link_xpm_database);
 
   precompute_fwm_combinations();
+
+  PhysicsTables p;
+  p.wavelengths = w;
+  p.fc = qp.fc;
+  p.f_step = qp.f_step;
+  p.halfwavelength = qp.halfwavelength;
+  p.nonlinear_halfwin = qp.nonlinear_halfwin;
+  p.channel_power = qp.channel_power;
+  p.D = qp.D;
+  p.alphaDB = qp.alphaDB;
+  p.gamma = qp.gamma;
+  p.sys_fs = sys_fs;
+  p.sys_link_xpm_database = sys_link_xpm_database;
+  p.fwm_fs = fwm_fs;
+  p.inter_indecies = inter_indecies;
+  p.fwm_combinations = fwm_combinations;
+
+  PhysicsCache.push_back(p);
 }
 
 ///////////////////////////////////////////////////////////////////
 //
-// Function Name:	~ResourceManager
-// Description:		Default destructor with no arguments.
+// Function Name:	clearPhysicsCache
+// Description:		Deletes the physics tables of all of the
+//					wavelength grids and stops Octave.
 //
 ///////////////////////////////////////////////////////////////////
-ResourceManager::~ResourceManager() {
-  delete[] sys_fs;
-  delete[] sys_link_xpm_database;
+void ResourceManager::clearPhysicsCache() {
+  for (size_t c = 0; c < PhysicsCache.size(); ++c) {
+    PhysicsTables& p = PhysicsCache[c];
 
-  delete[] wave_ordering;
+    delete[] p.sys_fs;
+    delete[] p.sys_link_xpm_database;
 
-  delete[] span_distance;
+    for (size_t w = 0; w < p.wavelengths; ++w) {
+      p.fwm_combinations[w].clear();
 
-  for (size_t s = 0; s < fwm_combinations->size(); ++s)
-    fwm_combinations[s].clear();
+      delete[](*p.fwm_fs)[w];
+      delete[](*p.inter_indecies)[w];
+    }
 
-  for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
-    delete[](*fwm_fs)[w];
-    delete[](*inter_indecies)[w];
+    delete[] p.fwm_combinations;
+    delete[] p.fwm_fs;
+    delete[] p.inter_indecies;
   }
 
-  fwm_fs->clear();
-  inter_indecies->clear();
+  PhysicsCache.clear();
 
-  delete[] fwm_combinations;
+  delete Octave;
+  Octave = nullptr;
+}
 
-  delete[] fwm_fs;
-  delete[] inter_indecies;
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	~ResourceManager
+// Description:		Default destructor with no arguments.
+//
+///////////////////////////////////////////////////////////////////
+ResourceManager::~ResourceManager() {
+  // The physics tables are kept for the other scenarios of the sweep, they
+  // are deleted by clearPhysicsCache.
+  delete[] wave_ordering;
+
+  delete[] span_distance;
 
-  freeSPMatrix();
+  delete pathCache;
 
   delete[] kSP_edgeList;
 }
@@ -106,19 +283,18 @@ ResourceManager::~ResourceManager() {
 //
 // Function Name:	calculate_SP_path
 // Description:		Calculates the shortest path from source to
-//					destination for the SP algorithm
+//					destination for the SP algorithm. The paths
+//					are cached for the whole sweep and must not
+//					be deleted by the caller.
 //
 ///////////////////////////////////////////////////////////////////
 kShortestPathReturn* ResourceManager::calculate_SP_path(size_t src_index,
                                                         size_t dest_index,
                                                         size_t k, size_t ci) {
-  if (threads[ci]->getCurrentRoutingAlgorithm() == SHORTEST_PATH) {
-    if (SP_paths != 0)
-      if (SP_paths[src_index * threadZero->getNumberOfRouters() + dest_index] !=
-          0)
-        return SP_paths[src_index * threadZero->getNumberOfRouters() +
-                        dest_index];
-  }
+  kShortestPathReturn* cached =
+      pathCache->find(src_index, dest_index, k, HOP_COUNT);
+
+  if (cached != nullptr) return cached;
 
   if (kSP_edgeList == nullptr) build_KSP_EdgeList();
 
@@ -149,13 +325,7 @@ kShortestPathReturn* ResourceManager::calculate_SP_path(size_t src_index,
 
   delete[] kSP_params.edge_list;
 
-  if (threads[ci]->getCurrentRoutingAlgorithm() == SHORTEST_PATH) {
-    if (SP_paths != 0)
-      SP_paths[src_index * threadZero->getNumberOfRouters() + dest_index] =
-          kSP_return;
-  }
-
-  return kSP_return;
+  return pathCache->insert(src_index, dest_index, k, HOP_COUNT, kSP_return);
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -168,7 +338,10 @@ kShortestPathReturn* ResourceManager::calculate_SP_path(size_t src_index,
 ///////////////////////////////////////////////////////////////////
 size_t ResourceManager::calculate_span_distance(size_t src_index,
                                                       size_t dest_index) {
-  size_t retVal = 0;
+  kShortestPathReturn* cached =
+      pathCache->find(src_index, dest_index, 1, SPAN_COUNT);
+
+  if (cached != nullptr) return static_cast<size_t>(cached->pathcost[0]);
 
   if (kSP_edgeList == 0) build_KSP_EdgeList();
 
@@ -194,28 +367,122 @@ size_t ResourceManager::calculate_span_distance(size_t src_index,
 
   delete[] kSP_params.edge_list;
 
-  retVal = static_cast<size_t>(kSP_return->pathcost[0]);
+  kSP_return =
+      pathCache->insert(src_index, dest_index, 1, SPAN_COUNT, kSP_return);
+
+  return static_cast<size_t>(kSP_return->pathcost[0]);
+}
 
-  delete[] kSP_return->pathinfo;
-  delete[] kSP_return->pathcost;
-  delete[] kSP_return->pathlen;
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	rank_candidate_paths
+// Description:		Orders the candidate paths from source to
+//					destination by their current cost and returns
+//					the first k. When k is more than the candidate
+//					paths and there may be other paths, the caller
+//					has to search for the paths instead.
+//
+///////////////////////////////////////////////////////////////////
+kShortestPathReturn* ResourceManager::rank_candidate_paths(
+    size_t src_index, size_t dest_index, size_t k, size_t ci,
+    CandidateCostModel model) {
+  size_t m = threadZero->getQualityParams().candidate_paths;
+  size_t stride = threadZero->getNumberOfRouters() - 1;
 
-  delete kSP_return;
+  GlobalStats& stats = threads[ci]->getGlobalStats();
+  ++stats.candidateSearches;
 
-  return retVal;
+  const kShortestPathReturn* candidates =
+      pathCache->find(src_index, dest_index, m, SPAN_COUNT);
+
+  size_t found = 0;
+
+  while (candidates != nullptr && found < m &&
+         candidates->pathcost[found] != std::numeric_limits<double>::infinity())
+    ++found;
+
+  // The candidates only hold every path when fewer than m were found.
+  if (candidates == nullptr || (k > found && found == m)) {
+    ++stats.candidateFallbacks;
+    return nullptr;
+  }
+
+  std::vector<std::pair<double, size_t> > ranked(found);
+
+  for (size_t p = 0; p < found; ++p) {
+    double cost = 0.0;
+
+    for (size_t r = 0; r < candidates->pathlen[p] - 1; ++r) {
+      Edge* edge = threads[ci]
+                       ->getRouterAt(candidates->pathinfo[p * stride + r])
+                       ->getEdgeByDestination(
+                           candidates->pathinfo[p * stride + r + 1]);
+
+      if (model == USAGE_COST)
+        cost += pow(threadZero->getBeta(), double(edge->getAlgorithmUsage()));
+      else
+        cost += edge->getQMDegredation();
+    }
+
+    ranked[p] = std::make_pair(cost, p);
+  }
+
+  // The span count breaks the ties, as the candidates are in that order.
+  std::sort(ranked.begin(), ranked.end());
+
+  kShortestPathReturn* kSP_return = new kShortestPathReturn();
+
+  kSP_return->pathinfo = new size_t[k * stride];
+  kSP_return->pathcost = new double[k];
+  kSP_return->pathlen = new size_t[k];
+
+  for (size_t a = 0; a < k; ++a) {
+    if (a < found) {
+      size_t p = ranked[a].second;
+
+      kSP_return->pathcost[a] = ranked[a].first;
+      kSP_return->pathlen[a] = candidates->pathlen[p];
+
+      for (size_t b = 0; b < candidates->pathlen[p]; ++b)
+        kSP_return->pathinfo[a * stride + b] =
+            candidates->pathinfo[p * stride + b];
+    } else {
+      kSP_return->pathcost[a] = std::numeric_limits<double>::infinity();
+      kSP_return->pathlen[a] = std::numeric_limits<size_t>::infinity();
+    }
+  }
+
+  return kSP_return;
 }
 
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	calculate_LORA_path
 // Description:		Calculates the shortest path from source to
-//					destination for the LORA algorithm
+//					destination for the LORA algorithm. The
+//					edge costs only change when the link usage is
+//					updated, so the paths are cached by the thread
+//					until then.
 //
 ///////////////////////////////////////////////////////////////////
 kShortestPathReturn* ResourceManager::calculate_LORA_path(size_t src_index,
                                                           size_t dest_index,
                                                           size_t k, size_t ci) {
-  if (kSP_edgeList == 0) build_KSP_EdgeList();
+  UsagePathCache* usagePaths = threads[ci]->getUsagePaths();
+
+  kShortestPathReturn* cached = usagePaths->find(src_index, dest_index, k);
+
+  if (cached != nullptr) return cached;
+
+  if (threadZero->getQualityParams().candidate_paths > 0) {
+    kShortestPathReturn* ranked =
+        rank_candidate_paths(src_index, dest_index, k, ci, USAGE_COST);
+
+    if (ranked != nullptr) {
+      usagePaths->insert(src_index, dest_index, k, ranked);
+      return ranked;
+    }
+  }
 
   kShortestPathParms kSP_params;
 
@@ -224,39 +491,59 @@ kShortestPathReturn* ResourceManager::calculate_LORA_path(size_t src_index,
   kSP_params.k_paths = k;
   kSP_params.total_nodes = threadZero->getNumberOfRouters();
   kSP_params.total_edges = threadZero->getNumberOfEdges();
-  kSP_params.edge_list = new kShortestPathEdges[kSP_params.total_edges];
+  kSP_params.edge_list = nullptr;
 
-  memcpy(kSP_params.edge_list, kSP_edgeList,
-         sizeof(kShortestPathEdges) * kSP_params.total_edges);
+  kShortestPathReturn* kSP_return = new kShortestPathReturn();
 
-  size_t num = 0;
+  kSP_return->pathinfo =
+      new size_t[kSP_params.k_paths * (kSP_params.total_nodes - 1)];
+  kSP_return->pathcost = new double[kSP_params.k_paths];
+  kSP_return->pathlen = new size_t[kSP_params.k_paths];
 
-  for (size_t a = 0; a < threadZero->getNumberOfRouters(); ++a) {
-    Router* routerA = threads[ci]->getRouterAt(a);
+  // The search for a smaller k in the same epoch is continued, as PABR asks
+  // for more paths on each of its iterations.
+  KShortestPaths* search = usagePaths->findSearch(src_index, dest_index);
 
-    for (size_t b = 0; b < threadZero->getNumberOfRouters(); ++b) {
-      size_t edgeID = routerA->isAdjacentTo(b);
+  if (search == nullptr) {
+    if (kSP_edgeList == 0) build_KSP_EdgeList();
 
-      if (edgeID >= 0) {
-        kSP_params.edge_list[num].edge_cost =
-            pow(threadZero->getBeta(),
-                double(routerA->getEdgeByIndex(edgeID)->getAlgorithmUsage()));
+    kSP_params.edge_list = new kShortestPathEdges[kSP_params.total_edges];
 
-        ++num;
+    memcpy(kSP_params.edge_list, kSP_edgeList,
+           sizeof(kShortestPathEdges) * kSP_params.total_edges);
+
+    size_t num = 0;
+
+    for (size_t a = 0; a < threadZero->getNumberOfRouters(); ++a) {
+      Router* routerA = threads[ci]->getRouterAt(a);
+
+      for (size_t b = 0; b < threadZero->getNumberOfRouters(); ++b) {
+        long long int edgeID = routerA->isAdjacentTo(b);
+
+        if (edgeID >= 0) {
+          kSP_params.edge_list[num].edge_cost = pow(
+              threadZero->getBeta(),
+              double(routerA->getEdgeByIndex(edgeID)->getAlgorithmUsage()));
+
+          ++num;
+        }
       }
     }
-  }
 
-  kShortestPathReturn* kSP_return = new kShortestPathReturn();
+    if (k == 1) {
+      calc_k_shortest_paths(kSP_params, kSP_return);
+    } else {
+      search = create_k_shortest_paths(kSP_params);
+      usagePaths->insertSearch(src_index, dest_index, search);
+    }
 
-  kSP_return->pathinfo =
-      new size_t[kSP_params.k_paths * (kSP_params.total_nodes - 1)];
-  kSP_return->pathcost = new double[kSP_params.k_paths];
-  kSP_return->pathlen = new size_t[kSP_params.k_paths];
+    delete[] kSP_params.edge_list;
+  }
 
-  calc_k_shortest_paths(kSP_params, kSP_return);
+  if (search != nullptr)
+    continue_k_shortest_paths(search, kSP_params, kSP_return);
 
-  delete[] kSP_params.edge_list;
+  usagePaths->insert(src_index, dest_index, k, kSP_return);
 
   return kSP_return;
 }
@@ -271,19 +558,10 @@ kShortestPathReturn* ResourceManager::calculate_LORA_path(size_t src_index,
 kShortestPathReturn* ResourceManager::calculate_IA_path(size_t src_index,
                                                         size_t dest_index,
                                                         size_t ci) {
-  kShortestPathParms* kSP_params =
-      new kShortestPathParms[threadZero->getNumberOfWavelengths()];
+  size_t wavelengths = threadZero->getNumberOfWavelengths();
 
-  for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
-    kSP_params[w].src_node = src_index;
-    kSP_params[w].dest_node = dest_index;
-    kSP_params[w].k_paths = 1;
-    kSP_params[w].total_nodes = threadZero->getNumberOfRouters();
-    kSP_params[w].total_edges = 0;
-
-    kSP_params[w].edge_list =
-        new kShortestPathEdges[threadZero->getNumberOfEdges()];
-  }
+  std::vector<kShortestPathEdges> edges;
+  std::vector<Edge*> edgePointers;
 
   for (size_t a = 0; a < threadZero->getNumberOfRouters(); ++a) {
     Router* routerA = threads[ci]->getRouterAt(a);
@@ -294,60 +572,128 @@ kShortestPathReturn* ResourceManager::calculate_IA_path(size_t src_index,
       if (edgeID >= 0) {
         Edge* edge = routerA->getEdgeByDestination(b);
 
-        for (size_t w = 0; w < threadZero->getNumberOfWavelengths();
-             ++w) {
-          if (edge->getStatus(w) == EDGE_FREE) {
-            kSP_params[w].edge_list[kSP_params[w].total_edges].src_node = a;
-            kSP_params[w].edge_list[kSP_params[w].total_edges].dest_node = b;
+        kShortestPathEdges kSP_edge;
+        kSP_edge.src_node = a;
+        kSP_edge.dest_node = b;
+        kSP_edge.edge_cost = double(edge->getNumberOfSpans());
 
-            kSP_params[w].edge_list[kSP_params[w].total_edges].edge_cost =
-                double(edge->getNumberOfSpans());
-
-            ++kSP_params[w].total_edges;
-          }
-        }
+        edges.push_back(kSP_edge);
+        edgePointers.push_back(edge);
       }
     }
   }
 
-  kShortestPathReturn* kSP_temp = new kShortestPathReturn;
+  // The edges that are free on each wavelength, one bit for each edge.
+  size_t words = (edges.size() + 63) / 64;
+  std::vector<unsigned long long> freeEdges(wavelengths * words, 0);
 
-  kSP_temp->pathinfo = new size_t[kSP_params[0].total_nodes - 1];
-  kSP_temp->pathcost = new double[1];
-  kSP_temp->pathlen = new size_t[1];
+  for (size_t e = 0; e < edges.size(); ++e) {
+    for (size_t w = 0; w < wavelengths; ++w) {
+      if (edgePointers[e]->getStatus(w) == EDGE_FREE)
+        freeEdges[w * words + e / 64] |= 1ULL << (e % 64);
+    }
+  }
+
+  // The path on a wavelength only depends on which edges are free, so the
+  // wavelengths with the same free edges share a single search, which is
+  // run for the first of them.
+  std::map<std::vector<unsigned long long>, size_t> searchOfEdges;
+  std::vector<size_t> searchOfWavelength(wavelengths);
+  std::vector<size_t> searchWavelengths;
+
+  for (size_t w = 0; w < wavelengths; ++w) {
+    std::vector<unsigned long long> key(freeEdges.begin() + w * words,
+                                        freeEdges.begin() + (w + 1) * words);
+
+    std::pair<std::map<std::vector<unsigned long long>, size_t>::iterator,
+              bool>
+        search = searchOfEdges.insert(
+            std::make_pair(key, searchWavelengths.size()));
+
+    if (search.second == true) searchWavelengths.push_back(w);
+
+    searchOfWavelength[w] = search.first->second;
+  }
+
+  size_t stride = threadZero->getNumberOfRouters() - 1;
 
   kShortestPathReturn* kSP_return = new kShortestPathReturn;
 
-  kSP_return->pathinfo = new size_t[(kSP_params[0].total_nodes - 1) *
-                                    threadZero->getNumberOfWavelengths()];
-  kSP_return->pathcost = new double[threadZero->getNumberOfWavelengths()];
-  kSP_return->pathlen = new size_t[threadZero->getNumberOfWavelengths()];
+  kSP_return->pathinfo = new size_t[stride * wavelengths];
+  kSP_return->pathcost = new double[wavelengths];
+  kSP_return->pathlen = new size_t[wavelengths];
 
-  for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
-    calc_k_shortest_paths(kSP_params[w], kSP_temp);
+  // The searches are independent of each other, so they are shared out
+  // between the workers of the thread.
+  IAPathTask task;
 
-    kSP_return->pathcost[w] = kSP_temp->pathcost[0];
-    kSP_return->pathlen[w] = kSP_temp->pathlen[0];
+  task.src_index = src_index;
+  task.dest_index = dest_index;
+  task.edges = &edges;
+  task.freeEdges = &freeEdges;
+  task.words = words;
+  task.searchWavelengths = &searchWavelengths;
+  task.paths = kSP_return;
+  task.stride = stride;
 
-    if (kSP_return->pathlen[w] != std::numeric_limits<int>::infinity())
-      for (size_t p = 0; p < kSP_return->pathlen[w]; ++p)
-        kSP_return->pathinfo[w * (kSP_params[0].total_nodes - 1) + p] =
-            kSP_temp->pathinfo[p];
+  threads[ci]->getWorkers()->run(searchWavelengths.size(), calculate_IA_search,
+                                 &task);
 
-    delete[] kSP_params[w].edge_list;
-  }
+  for (size_t w = 0; w < wavelengths; ++w) {
+    size_t first = searchWavelengths[searchOfWavelength[w]];
 
-  delete[] kSP_temp->pathinfo;
-  delete[] kSP_temp->pathcost;
-  delete[] kSP_temp->pathlen;
+    if (first == w) continue;
 
-  delete kSP_temp;
+    kSP_return->pathcost[w] = kSP_return->pathcost[first];
+    kSP_return->pathlen[w] = kSP_return->pathlen[first];
 
-  delete[] kSP_params;
+    for (size_t p = 0; p < kSP_return->pathlen[w]; ++p)
+      kSP_return->pathinfo[w * stride + p] =
+          kSP_return->pathinfo[first * stride + p];
+  }
 
   return kSP_return;
 }
 
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	calculate_IA_search
+// Description:		Finds the shortest path over the edges that are
+//					free on the first wavelength of a search, for
+//					use with the WorkerPool.
+//
+///////////////////////////////////////////////////////////////////
+static void calculate_IA_search(size_t s, void* arg) {
+  IAPathTask* task = static_cast<IAPathTask*>(arg);
+
+  size_t w = (*task->searchWavelengths)[s];
+  const unsigned long long* freeEdges = &(*task->freeEdges)[w * task->words];
+
+  kShortestPathParms kSP_params;
+
+  kSP_params.src_node = task->src_index;
+  kSP_params.dest_node = task->dest_index;
+  kSP_params.k_paths = 1;
+  kSP_params.total_nodes = task->stride + 1;
+  kSP_params.total_edges = 0;
+  kSP_params.edge_list = new kShortestPathEdges[task->edges->size()];
+
+  for (size_t e = 0; e < task->edges->size(); ++e) {
+    if ((freeEdges[e / 64] >> (e % 64) & 1ULL) != 0)
+      kSP_params.edge_list[kSP_params.total_edges++] = (*task->edges)[e];
+  }
+
+  kShortestPathReturn path;
+
+  path.pathinfo = &task->paths->pathinfo[w * task->stride];
+  path.pathcost = &task->paths->pathcost[w];
+  path.pathlen = &task->paths->pathlen[w];
+
+  calc_k_shortest_paths(kSP_params, &path);
+
+  delete[] kSP_params.edge_list;
+}
+
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	calculate_PAR_path
@@ -535,6 +881,13 @@ kShortestPathReturn* ResourceManager::calculate_PAR_path(size_t src_index,
 kShortestPathReturn* ResourceManager::calculate_QM_path(size_t src_index,
                                                         size_t dest_index,
                                                         size_t k, size_t ci) {
+  if (threadZero->getQualityParams().candidate_paths > 0) {
+    kShortestPathReturn* ranked =
+        rank_candidate_paths(src_index, dest_index, k, ci, QM_COST);
+
+    if (ranked != nullptr) return ranked;
+  }
+
   if (kSP_edgeList == 0) build_KSP_EdgeList();
 
   kShortestPathParms kSP_params;
@@ -725,6 +1078,16 @@ kShortestPathReturn* ResourceManager::calculate_ACO_path(size_t src_index,
     threads[ci]->getRouterAt(n)->generateACOProbabilities(dest_index);
   }
 
+  // The Q factors of the free wavelengths of an ant are estimated by the
+  // workers of the thread.
+  std::vector<size_t> freeWaves;
+  std::vector<double> waveQ(threadZero->getNumberOfWavelengths());
+  std::vector<double> waveXPM(threadZero->getNumberOfWavelengths());
+  std::vector<double> waveFWM(threadZero->getNumberOfWavelengths());
+  std::vector<double> waveASE(threadZero->getNumberOfWavelengths());
+
+  freeWaves.reserve(threadZero->getNumberOfWavelengths());
+
   for (size_t i = 0; i < threadZero->getQualityParams().MM_ACO_N_iter;
        ++i) {
     Ant* ants = new Ant[threadZero->getQualityParams().ACO_ants];
@@ -776,24 +1139,26 @@ kShortestPathReturn* ResourceManager::calculate_ACO_path(size_t src_index,
       double bestQ = 0.0;
       double pathWeight = 0.0;
 
+      freeWaves.clear();
+
       for (size_t w3 = 0; w3 < threadZero->getNumberOfWavelengths();
            ++w3) {
-        double ase;
-        double fwm;
-        double xpm;
-        double Q;
+        if (free[w3] == true) freeWaves.push_back(w3);
+      }
 
-        if (free[w3] == true) {
-          Q = threadZero->getResourceManager()->estimate_Q(
-              w3, ants[a].path, ants[a].pathlen, &xpm, &fwm, &ase, ci);
+      delete[] free;
 
-          if (Q > bestQ) {
-            bestQ = Q;
-          }
-        }
+      if (freeWaves.empty() == false) {
+        estimate_Q_list(ants[a].path, ants[a].pathlen, &freeWaves[0],
+                        freeWaves.size(), ci, &waveQ[0], &waveXPM[0],
+                        &waveFWM[0], &waveASE[0]);
       }
 
-      delete[] free;
+      for (size_t w4 = 0; w4 < freeWaves.size(); ++w4) {
+        if (waveQ[w4] > bestQ) {
+          bestQ = waveQ[w4];
+        }
+      }
 
       pathWeight =
           (1.0 - alpha) * (bestQ / Q_exp) + alpha * l_exp / double(spans);
@@ -1061,126 +1426,96 @@ kShortestPathReturn* ResourceManager::calculate_DP_path(size_t src_index,
               threadZero->getQualityParams()
                   .ASE_perEDFA[threadZero->getQualityParams().halfwavelength]));
 
-  for (size_t r1 = 0; r1 < threadZero->getNumberOfRouters(); ++r1) {
-    DP_node* node = new DP_node();
-
-    node->paths = new Edge*[k * (threadZero->getNumberOfRouters() - 1)];
-    node->waveAvailability = new bool[k * threadZero->getNumberOfWavelengths()];
-    node->pathLength = new size_t[k];
-    node->pathSpans = new size_t[k];
-    node->optimalWave = new double[k];
-    node->pathQuality = new double[k];
-    node->pathWeight = new double[k];
-
-    for (size_t t = 0; t < k * (threadZero->getNumberOfRouters() - 1);
-         ++t) {
-      node->paths[t] = 0;
-    }
+  DPArena* arena = threads[ci]->getDPArena();
+  const Topology* network = threads[ci]->getNetwork();
 
-    for (size_t w = 0; w < k * threadZero->getNumberOfWavelengths();
-         ++w) {
-      node->waveAvailability[w] = true;
-    }
+  arena->reset(k);
 
-    for (size_t k1 = 0; k1 < k; ++k1) {
-      node->pathLength[k1] = 0;
-      node->pathSpans[k1] = 0;
-      node->pathQuality[k1] = 0.0;
-      node->pathWeight[k1] = 0.0;
-    }
+  Router* source = threads[ci]->getRouterAt(src_index);
 
-    threads[ci]->getRouterAt(r1)->dp_node = node;
+  for (size_t e = 0; e < source->getNumberOfEdges(); ++e) {
+    arena->addItem(DPArena::NO_ITEM, source->getEdgeByIndex(e),
+                   network->getFirstEdge(src_index) + e);
   }
 
-  std::queue<DP_item*> Q;
+  Edge** path = arena->getPathBuffer(0);
+  Edge** slotPath = arena->getPathBuffer(1);
 
-  for (size_t e = 0;
-       e < threads[ci]->getRouterAt(src_index)->getNumberOfEdges(); ++e) {
-    bool addEdge = false;
-    DP_item* item = new DP_item;
+  size_t workers = threads[ci]->getWorkers()->getNumberOfWorkers();
 
-    item->path = new Edge*[threadZero->getNumberOfRouters() - 1];
-    item->waveAvailability = new bool[threadZero->getNumberOfWavelengths()];
+  std::vector<size_t> freeWaves;
+  std::vector<double> waveQ(threadZero->getNumberOfWavelengths());
+  std::vector<double> waveXPM(threadZero->getNumberOfWavelengths());
+  std::vector<double> waveFWM(threadZero->getNumberOfWavelengths());
+  std::vector<double> waveASE(threadZero->getNumberOfWavelengths());
 
-    item->path[0] = threads[ci]->getRouterAt(src_index)->getEdgeByIndex(e);
+  freeWaves.reserve(threadZero->getNumberOfWavelengths());
 
-    item->pathLength = 1;
-    item->pathSpans = item->path[0]->getNumberOfSpans();
+  while (arena->hasNextItem() == true) {
+    size_t current = arena->popNextItem();
 
-    for (size_t n = 1; n < threadZero->getNumberOfRouters() - 1; ++n)
-      item->path[n] = 0;
+    // Adding items may move the items of the arena, so this is a copy.
+    DPArena::Item current_item = arena->getItem(current);
 
-    for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
-      item->waveAvailability[w] = item->path[0]->getStatus(w) == EDGE_FREE;
+    Edge* edge = current_item.edge;
+    size_t router = edge->getDestinationIndex();
 
-      if (item->waveAvailability[w] == true) addEdge = true;
-    }
-
-    if (addEdge == true) {
-      Q.push(item);
-    } else {
-      delete[] item->path;
-      delete[] item->waveAvailability;
-
-      delete item;
-    }
-  }
-
-  while (Q.size() > 0) {
-    DP_item* current_item = Q.front();
-    Q.pop();
-
-    Edge* edge = current_item->path[current_item->pathLength - 1];
-
-    DP_node* dest_node =
-        threads[ci]->getRouterAt(edge->getDestinationIndex())->dp_node;
+    DPArena::Slot* dest_node = arena->getSlots(router);
 
     size_t additionalSpans =
-        span_distance[edge->getDestinationIndex() *
-                          threadZero->getNumberOfRouters() +
-                      dest_index];
+        span_distance[router * threadZero->getNumberOfRouters() + dest_index];
+
+    // With an alpha of one the weight of the path does not depend on the
+    // Q-factor of the wavelength, so a path that cannot beat the last of the
+    // k paths of its router is dropped before any Q-factor is estimated.
+    if (alpha == 1.0 &&
+        l_exp / double(current_item.pathSpans + additionalSpans) <=
+            dest_node[k - 1].pathWeight)
+      continue;
+
+    if (current_item.pathSpans + additionalSpans < threadZero->getMaxSpans()) {
+      size_t pathLength = arena->getPath(current, path);
 
-    if (current_item->pathSpans + additionalSpans < threadZero->getMaxSpans()) {
       // Search for the wavelength with the best weight
       double bestQ = 0.0;
       double pathWeight = 0.0;
       double waveWeight = 0.0;
       size_t bestW = 0;
 
+      freeWaves.clear();
+
       for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
-        double ase = 0.0;
-        double xpm = 0.0;
-        double fwm = 0.0;
+        if (arena->isAvailable(current, w) == true) freeWaves.push_back(w);
+      }
 
-        double Q = 0.0;
+      // With an alpha of one the first wavelength over the threshold wins,
+      // so only as many wavelengths as there are workers are estimated at
+      // once. Otherwise all of them are needed.
+      size_t batch = (alpha == 1.0) ? workers : freeWaves.size();
+      bool found = false;
 
-        double bestCaseQ = 0.0;
-        double bestCaseASE = 0.0;
+      for (size_t first = 0; first < freeWaves.size() && found == false;
+           first += batch) {
+        size_t count = std::min(batch, freeWaves.size() - first);
 
-        if (current_item->waveAvailability[w] == true) {
-          Q = threadZero->getResourceManager()->estimate_Q(
-              w, &current_item->path[0], current_item->pathLength, &xpm, &fwm,
-              &ase, ci);
+        estimate_Q_list(path, pathLength, &freeWaves[first], count, ci,
+                        &waveQ[0], &waveXPM[0], &waveFWM[0], &waveASE[0]);
 
-          bestCaseASE =
-              additionalSpans *
-              threadZero->getQualityParams()
-                  .ASE_perEDFA[threadZero->getQualityParams().halfwavelength];
-          bestCaseQ =
-              10.0 * log10(threadZero->getQualityParams().channel_power /
-                           sqrt(bestCaseASE + ase + xpm + fwm));
+        for (size_t i = 0; i < count; ++i) {
+          double Q = waveQ[i];
 
           waveWeight =
               (1.0 - alpha) * (Q / Q_exp) +
-              alpha * l_exp / double(current_item->pathSpans + additionalSpans);
+              alpha * l_exp / double(current_item.pathSpans + additionalSpans);
 
           if (waveWeight > pathWeight &&
               Q > threadZero->getQualityParams().TH_Q) {
             bestQ = Q;
             pathWeight = waveWeight;
-            bestW = w;
+            bestW = freeWaves[first + i];
 
             if (alpha == 1.0) {
+              found = true;
               break;
             }
           }
@@ -1188,19 +1523,22 @@ kShortestPathReturn* ResourceManager::calculate_DP_path(size_t src_index,
       }
 
       if (bestQ >= threadZero->getQualityParams().TH_Q &&
-          pathWeight > dest_node->pathWeight[k - 1]) {
+          pathWeight > dest_node[k - 1].pathWeight) {
         // Check for duplicates....we need to keep k distinct paths!
         bool uniqueK = false;
 
         for (size_t k0 = 0; k0 < k; ++k0) {
           uniqueK = false;
 
-          for (size_t r = 0; r < current_item->pathLength; ++r) {
-            if (current_item->path[r] !=
-                dest_node
-                    ->paths[k0 * (threadZero->getNumberOfRouters() - 1) + r]) {
-              uniqueK = true;
-              break;
+          if (dest_node[k0].item == DPArena::NO_ITEM ||
+              arena->getPath(dest_node[k0].item, slotPath) < pathLength) {
+            uniqueK = true;
+          } else {
+            for (size_t r = 0; r < pathLength; ++r) {
+              if (path[r] != slotPath[r]) {
+                uniqueK = true;
+                break;
+              }
             }
           }
 
@@ -1215,63 +1553,30 @@ kShortestPathReturn* ResourceManager::calculate_DP_path(size_t src_index,
           size_t k1 = k - 1;
           size_t k2 = 0;
 
-          while (k1 > 0 && (pathWeight > dest_node->pathWeight[k1 - 1] ||
-                            dest_node->pathLength[k1 - 1] == 0)) {
+          while (k1 > 0 && (pathWeight > dest_node[k1 - 1].pathWeight ||
+                            dest_node[k1 - 1].item == DPArena::NO_ITEM)) {
             --k1;
           }
 
           k2 = k - 1;
 
           while (k2 > k1) {
-            memcpy(
-                &dest_node->paths[k2 * (threadZero->getNumberOfRouters() - 1)],
-                &dest_node
-                     ->paths[(k2 - 1) * (threadZero->getNumberOfRouters() - 1)],
-                sizeof(Edge*) * (threadZero->getNumberOfRouters() - 1));
-
-            memcpy(
-                &dest_node
-                     ->waveAvailability[k2 *
-                                        threadZero->getNumberOfWavelengths()],
-                &dest_node
-                     ->waveAvailability[(k2 - 1) *
-                                        threadZero->getNumberOfWavelengths()],
-                sizeof(bool) * threadZero->getNumberOfWavelengths());
-
-            dest_node->pathLength[k2] = dest_node->pathLength[k2 - 1];
-            dest_node->pathQuality[k2] = dest_node->pathQuality[k2 - 1];
-            dest_node->optimalWave[k2] = dest_node->optimalWave[k2 - 1];
-            dest_node->pathSpans[k2] = dest_node->pathSpans[k2 - 1];
-            dest_node->pathWeight[k2] = dest_node->pathWeight[k2 - 1];
+            dest_node[k2] = dest_node[k2 - 1];
 
             --k2;
           }
 
           // Insert where appropriate
-          memcpy(&dest_node->paths[k1 * (threadZero->getNumberOfRouters() - 1)],
-                 &current_item->path[0],
-                 sizeof(Edge*) * (threadZero->getNumberOfRouters() - 1));
-
-          memcpy(
-              &dest_node->waveAvailability[k1 * threadZero
-                                                    ->getNumberOfWavelengths()],
-              &current_item->waveAvailability[0],
-              sizeof(bool) * threadZero->getNumberOfWavelengths());
-
-          dest_node->pathLength[k1] = current_item->pathLength;
-          dest_node->pathSpans[k1] = current_item->pathSpans;
-          dest_node->pathQuality[k1] = bestQ;
-          dest_node->optimalWave[k1] = static_cast<double>(bestW);
-          dest_node->pathWeight[k1] = pathWeight;
+          dest_node[k1].item = current;
+          dest_node[k1].pathSpans = current_item.pathSpans;
+          dest_node[k1].pathQuality = bestQ;
+          dest_node[k1].optimalWave = static_cast<double>(bestW);
+          dest_node[k1].pathWeight = pathWeight;
 
           for (size_t e = 0;
-               e < threads[ci]
-                       ->getRouterAt(edge->getDestinationIndex())
-                       ->getNumberOfEdges();
-               ++e) {
-            Edge* tmp_edge = threads[ci]
-                                 ->getRouterAt(edge->getDestinationIndex())
-                                 ->getEdgeByIndex(e);
+               e < threads[ci]->getRouterAt(router)->getNumberOfEdges(); ++e) {
+            Edge* tmp_edge =
+                threads[ci]->getRouterAt(router)->getEdgeByIndex(e);
 
             // We don't want to put edges with a destinaton of the source on the
             // Q. This would result in a cycle.
@@ -1281,8 +1586,8 @@ kShortestPathReturn* ResourceManager::calculate_DP_path(size_t src_index,
 
             bool cycle = false;
 
-            for (size_t r = 0; r < current_item->pathLength; ++r) {
-              if (current_item->path[r]->getSourceIndex() ==
+            for (size_t r = 0; r < pathLength; ++r) {
+              if (path[r]->getSourceIndex() ==
                   tmp_edge->getDestinationIndex()) {
                 cycle = true;
                 break;
@@ -1291,113 +1596,57 @@ kShortestPathReturn* ResourceManager::calculate_DP_path(size_t src_index,
 
             if (cycle == true) continue;
 
-            bool addEdge = false;
-            DP_item* item = new DP_item;
-
-            item->path = new Edge*[threadZero->getNumberOfRouters() - 1];
-            item->waveAvailability =
-                new bool[threadZero->getNumberOfWavelengths()];
-
-            item->pathLength = current_item->pathLength + 1;
-            item->pathSpans =
-                current_item->pathSpans + tmp_edge->getNumberOfSpans();
-
-            if (item->pathSpans > threadZero->getMaxSpans() ||
-                (alpha == 0 &&
-                 item->pathSpans >
-                     threadZero->getRouterAt(tmp_edge->getDestinationIndex())
-                         ->dp_node->pathSpans[k - 1] &&
-                 threadZero->getRouterAt(tmp_edge->getDestinationIndex())
-                         ->dp_node->pathSpans[k - 1] != 0)) {
-              delete[] item->path;
-              delete[] item->waveAvailability;
-
-              delete item;
+            size_t pathSpans =
+                current_item.pathSpans + tmp_edge->getNumberOfSpans();
+            size_t nextSpans =
+                arena->getSlots(tmp_edge->getDestinationIndex())[k - 1]
+                    .pathSpans;
 
+            if (pathSpans > threadZero->getMaxSpans() ||
+                (alpha == 0 && pathSpans > nextSpans && nextSpans != 0)) {
               continue;
             }
 
-            memcpy(item->path, current_item->path,
-                   sizeof(Edge*) * (threadZero->getNumberOfRouters() - 1));
-
-            item->path[item->pathLength - 1] = tmp_edge;
-
-            for (size_t w = 0; w < threadZero->getNumberOfWavelengths();
-                 ++w) {
-              item->waveAvailability[w] = current_item->waveAvailability[w] &&
-                                          (tmp_edge->getStatus(w) == EDGE_FREE);
-
-              if (item->waveAvailability[w] == true) addEdge = true;
-            }
-
-            if (addEdge == true) {
-              Q.push(item);
-            } else {
-              delete[] item->path;
-              delete[] item->waveAvailability;
-
-              delete item;
-            }
+            arena->addItem(current, tmp_edge,
+                           network->getFirstEdge(router) + e);
           }
         }
       }
     }
-
-    delete[] current_item->path;
-    delete[] current_item->waveAvailability;
-
-    delete current_item;
   }
 
   k = origK;
 
-  // Populate return structure with data from DP_node
+  // Populate return structure with data from the arena
   kShortestPathReturn* kSP_return = new kShortestPathReturn();
 
   kSP_return->pathcost = new double[k];
   kSP_return->pathlen = new size_t[k];
   kSP_return->pathinfo = new size_t[k * threadZero->getNumberOfRouters() - 1];
 
-  DP_node* final_dp_node = threads[ci]->getRouterAt(dest_index)->dp_node;
+  DPArena::Slot* final_dp_node = arena->getSlots(dest_index);
 
   for (size_t k1 = 0; k1 < k; ++k1) {
-    if (final_dp_node->pathLength[k1] > 0) {
-      kSP_return->pathcost[k1] = final_dp_node->optimalWave[k1];
-      kSP_return->pathlen[k1] = final_dp_node->pathLength[k1] + 1;
+    if (final_dp_node[k1].item != DPArena::NO_ITEM) {
+      size_t pathLength = arena->getPath(final_dp_node[k1].item, path);
+
+      kSP_return->pathcost[k1] = final_dp_node[k1].optimalWave;
+      kSP_return->pathlen[k1] = pathLength + 1;
 
-      for (size_t r = 0; r < kSP_return->pathlen[k1] - 1; ++r) {
+      for (size_t r = 0; r < pathLength; ++r) {
         kSP_return->pathinfo[k1 * (threadZero->getNumberOfRouters() - 1) + r] =
-            final_dp_node
-                ->paths[k1 * (threadZero->getNumberOfRouters() - 1) + r]
-                ->getSourceIndex();
+            path[r]->getSourceIndex();
       }
 
       kSP_return->pathinfo[k1 * (threadZero->getNumberOfRouters() - 1) +
-                           kSP_return->pathlen[k1] - 1] =
-          final_dp_node
-              ->paths[k1 * (threadZero->getNumberOfRouters() - 1) +
-                      kSP_return->pathlen[k1] - 2]
-              ->getDestinationIndex();
+                           pathLength] =
+          path[pathLength - 1]->getDestinationIndex();
     } else {
       kSP_return->pathcost[k1] = std::numeric_limits<double>::infinity();
       kSP_return->pathlen[k1] = std::numeric_limits<int>::infinity();
     }
   }
 
-  for (size_t r1 = 0; r1 < threadZero->getNumberOfRouters(); ++r1) {
-    DP_node* node = threads[ci]->getRouterAt(r1)->dp_node;
-
-    delete[] node->paths;
-    delete[] node->waveAvailability;
-    delete[] node->pathLength;
-    delete[] node->pathSpans;
-    delete[] node->optimalWave;
-    delete[] node->pathQuality;
-    delete[] node->pathWeight;
-
-    delete node;
-  }
-
   return kSP_return;
 }
 
@@ -1448,15 +1697,18 @@ long long int ResourceManager::choose_wavelength(
     retval = most_used(ccpe, ci, wave_available);
     delete[] wave_available;
   } else if (threads[ci]->getCurrentWavelengthAlgorithm() == QUAL_FIRST_FIT) {
-    return quality_first_fit(ccpe, ci, wave_available, numberAvailableWaves);
+    return quality_fit(ccpe, ci, wave_available, numberAvailableWaves,
+                       FIRST_FIT);
   } else if (threads[ci]->getCurrentWavelengthAlgorithm() ==
              QUAL_FIRST_FIT_ORDERED) {
-    return quality_first_fit_with_ordering(ccpe, ci, wave_available,
-                                           numberAvailableWaves);
+    return quality_fit(ccpe, ci, wave_available, numberAvailableWaves,
+                       FIRST_FIT_ORDERED);
   } else if (threads[ci]->getCurrentWavelengthAlgorithm() == QUAL_RANDOM_FIT) {
-    return quality_random_fit(ccpe, ci, wave_available, numberAvailableWaves);
+    return quality_fit(ccpe, ci, wave_available, numberAvailableWaves,
+                       RANDOM_FIT);
   } else if (threads[ci]->getCurrentWavelengthAlgorithm() == QUAL_MOST_USED) {
-    return quality_most_used(ccpe, ci, wave_available, numberAvailableWaves);
+    return quality_fit(ccpe, ci, wave_available, numberAvailableWaves,
+                       MOST_USED);
   } else if (threads[ci]->getCurrentWavelengthAlgorithm() == LEAST_QUALITY) {
     return least_quality_fit(ccpe, ci, wave_available);
   } else if (threads[ci]->getCurrentWavelengthAlgorithm() == MOST_QUALITY) {
@@ -1520,6 +1772,93 @@ double ResourceManager::estimate_Q(long long int lambda, Edge** Path,
   return Q;
 }
 
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	estimate_Q_available
+// Description:		Estimates the Q factor of every available
+//					wavelength on the path of the probe, sharing
+//					the wavelengths out between the workers of the
+//					thread.
+//
+///////////////////////////////////////////////////////////////////
+void ResourceManager::estimate_Q_available(CreateConnectionProbeEvent* ccpe,
+                                           size_t ci, bool* wave_available,
+                                           double* q, double* xpm,
+                                           double* fwm, double* ase) const {
+  QualityTask task;
+
+  task.rm = this;
+  task.ccpe = ccpe;
+  task.wave_available = wave_available;
+  task.ci = ci;
+  task.q = q;
+  task.xpm = xpm;
+  task.fwm = fwm;
+  task.ase = ase;
+
+  threads[ci]->getWorkers()->run(threadZero->getNumberOfWavelengths(),
+                                 estimate_Q_wavelength, &task);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	estimate_Q_wavelength
+// Description:		Estimates the Q factor of a single wavelength,
+//					for use with the WorkerPool.
+//
+///////////////////////////////////////////////////////////////////
+static void estimate_Q_wavelength(size_t w, void* arg) {
+  QualityTask* task = static_cast<QualityTask*>(arg);
+
+  if (task->wave_available[w] == true) {
+    task->q[w] = task->rm->estimate_Q(
+        w, task->ccpe->connectionPath, task->ccpe->connectionLength,
+        &task->xpm[w], &task->fwm[w], &task->ase[w], task->ci);
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	estimate_Q_list
+// Description:		Estimates the Q factor of each wavelength in the
+//					list on the given path, sharing them out
+//					between the workers of the thread.
+//
+///////////////////////////////////////////////////////////////////
+void ResourceManager::estimate_Q_list(Edge** Path, size_t pathLen,
+                                      const size_t* waves, size_t count,
+                                      size_t ci, double* q, double* xpm,
+                                      double* fwm, double* ase) const {
+  WaveListTask task;
+
+  task.rm = this;
+  task.path = Path;
+  task.pathLen = pathLen;
+  task.waves = waves;
+  task.ci = ci;
+  task.q = q;
+  task.xpm = xpm;
+  task.fwm = fwm;
+  task.ase = ase;
+
+  threads[ci]->getWorkers()->run(count, estimate_Q_listed, &task);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	estimate_Q_listed
+// Description:		Estimates the Q factor of a single wavelength of
+//					a list, for use with the WorkerPool.
+//
+///////////////////////////////////////////////////////////////////
+static void estimate_Q_listed(size_t i, void* arg) {
+  WaveListTask* task = static_cast<WaveListTask*>(arg);
+
+  task->q[i] = task->rm->estimate_Q(task->waves[i], task->path, task->pathLen,
+                                    &task->xpm[i], &task->fwm[i],
+                                    &task->ase[i], task->ci);
+}
+
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	path_ase_noise
@@ -1996,80 +2335,62 @@ long long int ResourceManager::random_fit(CreateConnectionProbeEvent* ccpe,
 
 ///////////////////////////////////////////////////////////////////
 //
-// Function Name:	quality_first_fit
-// Description:		Chooses a wavelength based upon the first fit
-//					algorithm using quality
+// Function Name:	quality_fit
+// Description:		Chooses the first wavelength that meets the Q
+//					threshold, trying the wavelengths in the order
+//					of the given algorithm. As many wavelengths as
+//					there are workers are estimated at once, which
+//					leaves the choice the same for any number of
+//					workers.
 //
 ///////////////////////////////////////////////////////////////////
-long long int ResourceManager::quality_first_fit(
-    CreateConnectionProbeEvent* ccpe, size_t ci, bool* wave_available,
-    size_t numberAvailableWaves) {
-  while (numberAvailableWaves > 0) {
-    double xpm = 0.0;
-    double fwm = 0.0;
-    double ase = 0.0;
-    double Q_factor = 0.0;
+long long int ResourceManager::quality_fit(CreateConnectionProbeEvent* ccpe,
+                                           size_t ci, bool* wave_available,
+                                           size_t numberAvailableWaves,
+                                           WavelengthAlgorithm algorithm) {
+  size_t batch = threads[ci]->getWorkers()->getNumberOfWorkers();
 
-    long long int wave = first_fit(ccpe, ci, wave_available);
+  std::vector<size_t> waves;
+  std::vector<double> q(batch);
+  std::vector<double> xpm(batch);
+  std::vector<double> fwm(batch);
+  std::vector<double> ase(batch);
 
-    Q_factor = threadZero->getResourceManager()->estimate_Q(
-        wave, ccpe->connectionPath, ccpe->connectionLength, &xpm, &fwm, &ase,
-        ci);
+  waves.reserve(batch);
 
-    if (threadZero->getQualityParams().TH_Q <= Q_factor) {
-      ccpe->wavelength = wave;
+  while (numberAvailableWaves > 0) {
+    waves.clear();
 
-      print_connection_info(ccpe, Q_factor, ase, fwm, xpm, ci);
+    while (waves.size() < batch && numberAvailableWaves > 0) {
+      long long int wave = NO_PATH_FAILURE;
+
+      if (algorithm == FIRST_FIT)
+        wave = first_fit(ccpe, ci, wave_available);
+      else if (algorithm == FIRST_FIT_ORDERED)
+        wave = first_fit_with_ordering(ccpe, ci, wave_available);
+      else if (algorithm == RANDOM_FIT)
+        wave = random_fit(ccpe, ci, wave_available, numberAvailableWaves);
+      else
+        wave = most_used(ccpe, ci, wave_available);
+
+      waves.push_back(static_cast<size_t>(wave));
 
-      delete[] wave_available;
-      return wave;
-    } else {
       --numberAvailableWaves;
       wave_available[wave] = false;
     }
-  }
 
-  delete[] wave_available;
+    estimate_Q_list(ccpe->connectionPath, ccpe->connectionLength, &waves[0],
+                    waves.size(), ci, &q[0], &xpm[0], &fwm[0], &ase[0]);
 
-  ccpe->wavelength = QUALITY_FAILURE;
+    for (size_t i = 0; i < waves.size(); ++i) {
+      if (threadZero->getQualityParams().TH_Q <= q[i]) {
+        ccpe->wavelength = waves[i];
 
-  print_connection_info(ccpe, 0.0, 0.0, 0.0, 0.0, ci);
-
-  return QUALITY_FAILURE;
-}
-
-///////////////////////////////////////////////////////////////////
-//
-// Function Name:	quality_first_fit_with_ordering
-// Description:		Chooses a wavelength based upon the first fit
-//					algorithm using quality
-//
-///////////////////////////////////////////////////////////////////
-long long int ResourceManager::quality_first_fit_with_ordering(
-    CreateConnectionProbeEvent* ccpe, size_t ci, bool* wave_available,
-    size_t numberAvailableWaves) {
-  while (numberAvailableWaves > 0) {
-    double xpm = 0.0;
-    double fwm = 0.0;
-    double ase = 0.0;
-    double Q_factor = 0.0;
-
-    long long int wave = first_fit_with_ordering(ccpe, ci, wave_available);
+        print_connection_info(ccpe, q[i], ase[i], fwm[i], xpm[i], ci);
 
-    Q_factor = threadZero->getResourceManager()->estimate_Q(
-        wave, ccpe->connectionPath, ccpe->connectionLength, &xpm, &fwm, &ase,
-        ci);
-
-    if (threadZero->getQualityParams().TH_Q <= Q_factor) {
-      ccpe->wavelength = wave;
-
-      print_connection_info(ccpe, Q_factor, ase, fwm, xpm, ci);
-
-      delete[] wave_available;
-      return wave;
-    } else {
-      --numberAvailableWaves;
-      wave_available[wave] = false;
+        delete[] wave_available;
+        return waves[i];
+      }
     }
   }
 
@@ -2098,30 +2419,32 @@ long long int ResourceManager::least_quality_fit(
   double minFWM = 0.0;
   double minASE = 0.0;
 
-  for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
-    if (wave_available[w] == true) {
-      double qfactor = 0.0;
-
-      double xpm = 0.0;
-      double fwm = 0.0;
-      double ase = 0.0;
+  double* qfactor = new double[threadZero->getNumberOfWavelengths()];
+  double* xpm = new double[threadZero->getNumberOfWavelengths()];
+  double* fwm = new double[threadZero->getNumberOfWavelengths()];
+  double* ase = new double[threadZero->getNumberOfWavelengths()];
 
-      qfactor = threadZero->getResourceManager()->estimate_Q(
-          w, ccpe->connectionPath, ccpe->connectionLength, &xpm, &fwm, &ase,
-          ci);
+  estimate_Q_available(ccpe, ci, wave_available, qfactor, xpm, fwm, ase);
 
-      if (qfactor < minQualityQFactor &&
-          qfactor >= threadZero->getQualityParams().TH_Q) {
+  for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
+    if (wave_available[w] == true) {
+      if (qfactor[w] < minQualityQFactor &&
+          qfactor[w] >= threadZero->getQualityParams().TH_Q) {
         minQualityWave = w;
-        minQualityQFactor = qfactor;
+        minQualityQFactor = qfactor[w];
 
-        minXPM = xpm;
-        minFWM = fwm;
-        minASE = ase;
+        minXPM = xpm[w];
+        minFWM = fwm[w];
+        minASE = ase[w];
       }
     }
   }
 
+  delete[] qfactor;
+  delete[] xpm;
+  delete[] fwm;
+  delete[] ase;
+
   delete[] wave_available;
 
   if (minQualityWave == -1) {
@@ -2153,30 +2476,32 @@ long long int ResourceManager::most_quality_fit(
   double maxFWM = 0.0;
   double maxASE = 0.0;
 
-  for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
-    if (wave_available[w] == true) {
-      double qfactor = 0.0;
-
-      double xpm = 0.0;
-      double fwm = 0.0;
-      double ase = 0.0;
+  double* qfactor = new double[threadZero->getNumberOfWavelengths()];
+  double* xpm = new double[threadZero->getNumberOfWavelengths()];
+  double* fwm = new double[threadZero->getNumberOfWavelengths()];
+  double* ase = new double[threadZero->getNumberOfWavelengths()];
 
-      qfactor = threadZero->getResourceManager()->estimate_Q(
-          w, ccpe->connectionPath, ccpe->connectionLength, &xpm, &fwm, &ase,
-          ci);
+  estimate_Q_available(ccpe, ci, wave_available, qfactor, xpm, fwm, ase);
 
-      if (qfactor > maxQualityQFactor &&
-          qfactor >= threadZero->getQualityParams().TH_Q) {
+  for (size_t w = 0; w < threadZero->getNumberOfWavelengths(); ++w) {
+    if (wave_available[w] == true) {
+      if (qfactor[w] > maxQualityQFactor &&
+          qfactor[w] >= threadZero->getQualityParams().TH_Q) {
         maxQualityWave = w;
-        maxQualityQFactor = qfactor;
+        maxQualityQFactor = qfactor[w];
 
-        maxXPM = xpm;
-        maxFWM = fwm;
-        maxASE = ase;
+        maxXPM = xpm[w];
+        maxFWM = fwm[w];
+        maxASE = ase[w];
       }
     }
   }
 
+  delete[] qfactor;
+  delete[] xpm;
+  delete[] fwm;
+  delete[] ase;
+
   delete[] wave_available;
 
   if (maxQualityWave == -1) {
@@ -2192,98 +2517,6 @@ long long int ResourceManager::most_quality_fit(
   return ccpe->wavelength;
 }
 
-///////////////////////////////////////////////////////////////////
-//
-// Function Name:	quality_random_fit
-// Description:		Chooses a wavelength based upon the random
-//					algorithm using quality
-//
-///////////////////////////////////////////////////////////////////
-long long int ResourceManager::quality_random_fit(
-    CreateConnectionProbeEvent* ccpe, size_t ci, bool* wave_available,
-    size_t numberAvailableWaves) {
-  while (numberAvailableWaves > 0) {
-    double xpm = 0.0;
-    double fwm = 0.0;
-    double ase = 0.0;
-    double Q_factor = 0.0;
-
-    long long int wave =
-        random_fit(ccpe, ci, wave_available, numberAvailableWaves);
-
-    Q_factor = threadZero->getResourceManager()->estimate_Q(
-        wave, ccpe->connectionPath, ccpe->connectionLength, &xpm, &fwm, &ase,
-        ci);
-
-    if (threadZero->getQualityParams().TH_Q <=
-        threadZero->getResourceManager()->estimate_Q(wave, ccpe->connectionPath,
-                                                     ccpe->connectionLength,
-                                                     &xpm, &fwm, &ase, ci)) {
-      ccpe->wavelength = wave;
-
-      print_connection_info(ccpe, Q_factor, ase, fwm, xpm, ci);
-
-      delete[] wave_available;
-      return wave;
-    } else {
-      --numberAvailableWaves;
-      wave_available[wave] = false;
-    }
-  }
-
-  delete[] wave_available;
-
-  ccpe->wavelength = QUALITY_FAILURE;
-
-  print_connection_info(ccpe, 0.0, 0.0, 0.0, 0.0, ci);
-
-  return QUALITY_FAILURE;
-}
-
-///////////////////////////////////////////////////////////////////
-//
-// Function Name:	quality_most_used
-// Description:		Chooses a wavelength based upon the random
-//					algorithm using quality
-//
-///////////////////////////////////////////////////////////////////
-long long int ResourceManager::quality_most_used(
-    CreateConnectionProbeEvent* ccpe, size_t ci, bool* wave_available,
-    size_t numberAvailableWaves) {
-  while (numberAvailableWaves > 0) {
-    double xpm = 0.0;
-    double fwm = 0.0;
-    double ase = 0.0;
-    double Q_factor = 0.0;
-
-    long long int wave = most_used(ccpe, ci, wave_available);
-
-    Q_factor = threadZero->getResourceManager()->estimate_Q(
-        wave, ccpe->connectionPath, ccpe->connectionLength, &xpm, &fwm, &ase,
-        ci);
-
-    if (threadZero->getQualityParams().TH_Q <= Q_factor) {
-      ccpe->wavelength = wave;
-
-      print_connection_info(ccpe, Q_factor, ase, fwm, xpm, ci);
-
-      delete[] wave_available;
-      return wave;
-    } else {
-      --numberAvailableWaves;
-      wave_available[wave] = false;
-    }
-  }
-
-  delete[] wave_available;
-
-  ccpe->wavelength = QUALITY_FAILURE;
-
-  print_connection_info(ccpe, 0.0, 0.0, 0.0, 0.0, ci);
-
-  return QUALITY_FAILURE;
-}
-
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	precompute_fwm_fs
@@ -2324,53 +2557,6 @@ void ResourceManager::precompute_fwm_combinations() {
   }
 }
 
-///////////////////////////////////////////////////////////////////
-//
-// Function Name:	initSPMatrix
-// Description:		Initializes the SP matrix so that the paths
-//					can be stored.
-//
-///////////////////////////////////////////////////////////////////
-void ResourceManager::initSPMatrix() {
-  if (SP_paths != 0) return;
-
-  SP_paths = new kShortestPathReturn*[threadZero->getNumberOfRouters() *
-                                      threadZero->getNumberOfRouters()];
-
-  for (size_t p = 0;
-       p < threadZero->getNumberOfRouters() * threadZero->getNumberOfRouters();
-       ++p) {
-    SP_paths[p] = nullptr;
-  }
-}
-
-///////////////////////////////////////////////////////////////////
-//
-// Function Name:	freeSPMatrix
-// Description:		Free the SP matrix so that the memory can be
-//					reused.
-//
-///////////////////////////////////////////////////////////////////
-void ResourceManager::freeSPMatrix() {
-  if (SP_paths == 0) return;
-
-  for (size_t p = 0;
-       p < threadZero->getNumberOfRouters() * threadZero->getNumberOfRouters();
-       ++p) {
-    if (SP_paths[p] != 0) {
-      delete[] SP_paths[p]->pathcost;
-      delete[] SP_paths[p]->pathinfo;
-      delete[] SP_paths[p]->pathlen;
-
-      delete SP_paths[p];
-    }
-  }
-
-  delete[] SP_paths;
-
-  SP_paths = 0;
-}
-
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	build_KSP_EdgeList
@@ -2453,6 +2639,7 @@ void ResourceManager::print_connection_info(CreateConnectionProbeEvent* ccpe,
     threads[ci]->getGlobalStats().aseNoiseTotal += ase;
     threads[ci]->getGlobalStats().fwmNoiseTotal += fwm;
     threads[ci]->getGlobalStats().xpmNoiseTotal += xpm;
+    threads[ci]->getGlobalStats().qFactorTotal += Q_factor;
 
     size_t spans = 0;
 
@@ -2465,12 +2652,26 @@ void ResourceManager::print_connection_info(CreateConnectionProbeEvent* ccpe,
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	calc_min_spans
-// Description:		Prints the information about the connection
+// Description:		Calculates the distance in spans between every
+//					pair of routers, reading the paths from the
+//					span file when it matches the topology. The
+//					shortest paths by hop count of the SP algorithm
+//					are calculated and kept in the file as well.
 //
 ///////////////////////////////////////////////////////////////////
 void ResourceManager::calc_min_spans() {
   threadZero->recordEvent("Starting to calculate router distances", true, 0);
 
+  std::string file = get_span_file();
+
+  if (read_span_file(file) == true) {
+    threadZero->recordEvent("Read the router distances from " + file, true, 0);
+  } else {
+    calc_span_trees(HOP_COUNT);
+    calc_span_trees(SPAN_COUNT);
+    write_span_file(file);
+  }
+
   span_distance = new size_t[threadZero->getNumberOfRouters() *
                              threadZero->getNumberOfRouters()];
 
@@ -2500,6 +2701,315 @@ void ResourceManager::calc_min_spans() {
   threadZero->recordEvent("Completed calculation of router distances", true, 0);
 }
 
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	calc_span_trees
+// Description:		Calculates the shortest paths by span count or
+//					by hop count of every pair of routers, with a
+//					single search for each source router. The
+//					searches are shared out between the workers of
+//					thread zero.
+//
+///////////////////////////////////////////////////////////////////
+void ResourceManager::calc_span_trees(PathCostModel model) {
+  if (kSP_edgeList == nullptr) build_KSP_EdgeList();
+
+  size_t routers = threadZero->getNumberOfRouters();
+
+  kShortestPathParms kSP_params;
+
+  kSP_params.src_node = 0;
+  kSP_params.dest_node = 0;
+  kSP_params.k_paths = 1;
+  kSP_params.total_nodes = routers;
+  kSP_params.total_edges = threadZero->getNumberOfEdges();
+  kSP_params.edge_list = kSP_edgeList;
+
+  std::vector<kShortestPathEdges> hops;
+
+  // Every edge costs the same for the SP algorithm, as in calculate_SP_path.
+  if (model == HOP_COUNT) {
+    hops.assign(kSP_edgeList, kSP_edgeList + kSP_params.total_edges);
+
+    for (size_t e = 0; e < hops.size(); ++e) hops[e].edge_cost = 1;
+
+    kSP_params.edge_list = hops.empty() ? nullptr : &hops[0];
+  }
+
+  kShortestPathReturn* trees = new kShortestPathReturn[routers];
+
+  for (size_t r = 0; r < routers; ++r) {
+    trees[r].pathinfo = new size_t[routers * (routers - 1)];
+    trees[r].pathcost = new double[routers];
+    trees[r].pathlen = new size_t[routers];
+  }
+
+  SpanTreeTask task;
+
+  task.params = &kSP_params;
+  task.trees = trees;
+
+  threadZero->getWorkers()->run(routers, calculate_span_tree, &task);
+
+  for (size_t r1 = 0; r1 < routers; ++r1) {
+    for (size_t r2 = 0; r2 < routers; ++r2) {
+      if (r1 == r2) continue;
+
+      kShortestPathReturn* kSP_return = new kShortestPathReturn();
+
+      kSP_return->pathinfo = new size_t[routers - 1];
+      kSP_return->pathcost = new double[1];
+      kSP_return->pathlen = new size_t[1];
+
+      kSP_return->pathcost[0] = trees[r1].pathcost[r2];
+      kSP_return->pathlen[0] = trees[r1].pathlen[r2];
+
+      for (size_t p = 0; p < kSP_return->pathlen[0]; ++p)
+        kSP_return->pathinfo[p] = trees[r1].pathinfo[r2 * (routers - 1) + p];
+
+      pathCache->insert(r1, r2, 1, model, kSP_return);
+    }
+  }
+
+  for (size_t r = 0; r < routers; ++r) {
+    delete[] trees[r].pathinfo;
+    delete[] trees[r].pathcost;
+    delete[] trees[r].pathlen;
+  }
+
+  delete[] trees;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	calculate_span_tree
+// Description:		Finds the shortest paths from a single router,
+//					for use with the WorkerPool.
+//
+///////////////////////////////////////////////////////////////////
+static void calculate_span_tree(size_t r, void* arg) {
+  SpanTreeTask* task = static_cast<SpanTreeTask*>(arg);
+
+  kShortestPathParms kSP_params = *task->params;
+
+  kSP_params.src_node = r;
+
+  calc_shortest_path_tree(kSP_params, &task->trees[r]);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	get_span_file
+// Description:		Returns the name of the file that keeps the
+//					shortest paths by span count and by hop count
+//					of the topology.
+//
+///////////////////////////////////////////////////////////////////
+std::string ResourceManager::get_span_file() const {
+  return "output/Spans-" + threadZero->getTopology() + ".bin";
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	read_span_file
+// Description:		Adds the shortest paths by hop count and by span
+//					count in the file to the path cache. Returns
+//					false if the file is missing, incomplete or was
+//					written for a different topology file.
+//
+///////////////////////////////////////////////////////////////////
+bool ResourceManager::read_span_file(const std::string& file) {
+  std::ifstream in(file.c_str(), std::ios::in | std::ios::binary);
+
+  if (!in.is_open()) return false;
+
+  size_t routers = threadZero->getNumberOfRouters();
+
+  SpanFileHeader h;
+
+  if (!in.read(reinterpret_cast<char*>(&h), sizeof(h)) ||
+      memcmp(h.magic, SPAN_FILE_MAGIC, sizeof(SPAN_FILE_MAGIC)) != 0 ||
+      h.version != SPAN_FILE_VERSION ||
+      h.topologyHash != threadZero->getNetwork()->getHash() ||
+      h.routers != routers)
+    return false;
+
+  std::vector<kShortestPathReturn*> paths;
+  bool complete = true;
+
+  size_t pairs = routers * (routers - 1);
+
+  for (size_t p = 0; p < NUMBER_OF_PATH_COST_MODELS * pairs && complete == true;
+       ++p) {
+    kShortestPathReturn* kSP_return = new kShortestPathReturn();
+
+    kSP_return->pathinfo = new size_t[routers - 1];
+    kSP_return->pathcost = new double[1];
+    kSP_return->pathlen = new size_t[1];
+
+    paths.push_back(kSP_return);
+
+    unsigned long long length = 0;
+
+    in.read(reinterpret_cast<char*>(kSP_return->pathcost), sizeof(double));
+    in.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+    if (!in || length > routers - 1) {
+      complete = false;
+      break;
+    }
+
+    kSP_return->pathlen[0] = static_cast<size_t>(length);
+
+    for (size_t r = 0; r < length; ++r) {
+      unsigned long long router = 0;
+      in.read(reinterpret_cast<char*>(&router), sizeof(router));
+
+      if (!in || router >= routers) {
+        complete = false;
+        break;
+      }
+
+      kSP_return->pathinfo[r] = static_cast<size_t>(router);
+    }
+  }
+
+  size_t p = 0;
+
+  for (size_t m = 0; m < NUMBER_OF_PATH_COST_MODELS; ++m) {
+    for (size_t r1 = 0; r1 < routers; ++r1) {
+      for (size_t r2 = 0; r2 < routers; ++r2) {
+        if (r1 == r2) continue;
+
+        if (complete == true) {
+          pathCache->insert(r1, r2, 1, static_cast<PathCostModel>(m),
+                            paths[p]);
+        } else if (p < paths.size()) {
+          delete[] paths[p]->pathinfo;
+          delete[] paths[p]->pathcost;
+          delete[] paths[p]->pathlen;
+          delete paths[p];
+        }
+
+        ++p;
+      }
+    }
+  }
+
+  return complete;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	write_span_file
+// Description:		Writes the shortest paths by hop count and by
+//					span count in the path cache to the file. It
+//					is written under a temporary name first, so
+//					that other processes never read a file that is
+//					only partly written.
+//
+///////////////////////////////////////////////////////////////////
+void ResourceManager::write_span_file(const std::string& file) const {
+  size_t routers = threadZero->getNumberOfRouters();
+
+  SpanFileHeader h;
+
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, SPAN_FILE_MAGIC, sizeof(SPAN_FILE_MAGIC));
+  h.version = SPAN_FILE_VERSION;
+  h.topologyHash = threadZero->getNetwork()->getHash();
+  h.routers = routers;
+
+  std::string temp = file + ".tmp";
+
+  std::ofstream out(temp.c_str(),
+                    std::ios::out | std::ios::binary | std::ios::trunc);
+
+  out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+  for (size_t m = 0; m < NUMBER_OF_PATH_COST_MODELS; ++m) {
+    for (size_t r1 = 0; r1 < routers; ++r1) {
+      for (size_t r2 = 0; r2 < routers; ++r2) {
+        if (r1 == r2) continue;
+
+        const kShortestPathReturn* kSP_return =
+            pathCache->find(r1, r2, 1, static_cast<PathCostModel>(m));
+
+        unsigned long long length = kSP_return->pathlen[0];
+
+        out.write(reinterpret_cast<const char*>(kSP_return->pathcost),
+                  sizeof(double));
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+
+        for (size_t r = 0; r < length; ++r) {
+          unsigned long long router = kSP_return->pathinfo[r];
+          out.write(reinterpret_cast<const char*>(&router), sizeof(router));
+        }
+      }
+    }
+  }
+
+  out.close();
+
+  std::remove(file.c_str());
+
+  if (out.fail() == true || std::rename(temp.c_str(), file.c_str()) != 0) {
+    std::remove(temp.c_str());
+
+    threadZero->recordEvent(
+        "Unable to write the router distances to " + file + ".", true, 0);
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	build_candidate_pool
+// Description:		Calculates the candidate paths of every pair of
+//					routers, which are then ranked by the dynamic
+//					cost of each request.
+//
+///////////////////////////////////////////////////////////////////
+void ResourceManager::build_candidate_pool() {
+  size_t m = threadZero->getQualityParams().candidate_paths;
+
+  std::ostringstream start;
+  start << "Starting to calculate " << m << " candidate paths for each pair "
+        << "of routers";
+  threadZero->recordEvent(start.str(), true, 0);
+
+  if (kSP_edgeList == nullptr) build_KSP_EdgeList();
+
+  kShortestPathParms kSP_params;
+
+  kSP_params.k_paths = m;
+  kSP_params.total_nodes = threadZero->getNumberOfRouters();
+  kSP_params.total_edges = threadZero->getNumberOfEdges();
+  kSP_params.edge_list = kSP_edgeList;
+
+  for (size_t r1 = 0; r1 < threadZero->getNumberOfRouters(); ++r1) {
+    for (size_t r2 = 0; r2 < threadZero->getNumberOfRouters(); ++r2) {
+      if (r1 == r2 || pathCache->find(r1, r2, m, SPAN_COUNT) != nullptr)
+        continue;
+
+      kSP_params.src_node = r1;
+      kSP_params.dest_node = r2;
+
+      kShortestPathReturn* kSP_return = new kShortestPathReturn();
+
+      kSP_return->pathinfo = new size_t[m * (kSP_params.total_nodes - 1)];
+      kSP_return->pathcost = new double[m];
+      kSP_return->pathlen = new size_t[m];
+
+      calc_k_shortest_paths(kSP_params, kSP_return);
+
+      pathCache->insert(r1, r2, m, SPAN_COUNT, kSP_return);
+    }
+  }
+
+  threadZero->recordEvent("Completed calculation of the candidate paths", true,
+                          0);
+}
+
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	generateWaveOrdering
@@ -20,6 +20,7 @@
 // ____________________________________________________________________________
 
 #include "Router.h"
+#include "Checkpoint.h"
 #include "ErrorCodes.h"
 
 #ifndef NO_ALLEGRO
@@ -39,7 +40,7 @@ extern Thread *threadZero;
 //
 ///////////////////////////////////////////////////////////////////
 Router::Router()
-    : dp_node(nullptr), qualityFailures(0), routerIndex(0), waveFailures(0), adjacencyList(nullptr), destinationProbs(nullptr), acoProbs(nullptr) {
+    : qualityFailures(0), routerIndex(0), waveFailures(0), adjacencyList(nullptr), ownAdjacency(nullptr), destinationProbs(nullptr), acoProbs(nullptr) {
 
 #ifndef NO_ALLEGRO
   sprintf(name, "(no name)");
@@ -74,25 +75,29 @@ Router::~Router() {
   destroy_bitmap(routerpic);
 #endif
 
-  delete[] adjacencyList;
+  delete[] ownAdjacency;
 }
 
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	addEdge
 // Description:		Adds edge to the edge list and updates the
-//					adjacency list.
+//					adjacency list, unless it is shared with the
+//					topology and already holds the edge.
 //
 ///////////////////////////////////////////////////////////////////
 void Router::addEdge(Edge *e) {
   if (adjacencyList == nullptr) {
-    adjacencyList = new long long int[threadZero->getNumberOfRouters()];
+    ownAdjacency = new long long int[threadZero->getNumberOfRouters()];
 
     for (size_t a = 0; a < threadZero->getNumberOfRouters(); ++a)
-      adjacencyList[a] = -1;
+      ownAdjacency[a] = -1;
+
+    adjacencyList = ownAdjacency;
   }
 
-  adjacencyList[e->getDestinationIndex()] = (long long)edgeList.size();
+  if (ownAdjacency != nullptr)
+    ownAdjacency[e->getDestinationIndex()] = (long long)edgeList.size();
 
   edgeList.push_back(e);
 }
@@ -273,12 +278,6 @@ void Router::generateProbabilities() {
         destinationProbs[r1] = 1.0;
 
       totalProbs += destinationProbs[r1];
-
-      delete[] kPath->pathcost;
-      delete[] kPath->pathinfo;
-      delete[] kPath->pathlen;
-
-      delete kPath;
     } else {
       destinationProbs[r1] = 0.0;
     }
@@ -334,6 +333,35 @@ void Router::resetFailures() {
   waveFailures = 0;
 }
 
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	saveCheckpoint
+// Description:		Writes the state of the router and its edges to
+//					a checkpoint.
+//
+///////////////////////////////////////////////////////////////////
+void Router::saveCheckpoint(CheckpointWriter &out) const {
+  out.write(qualityFailures);
+  out.write(waveFailures);
+
+  for (size_t e = 0; e < edgeList.size(); ++e)
+    edgeList[e]->saveCheckpoint(out);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	loadCheckpoint
+// Description:		Reads the state of the router and its edges from
+//					a checkpoint.
+//
+///////////////////////////////////////////////////////////////////
+void Router::loadCheckpoint(CheckpointReader &in) {
+  in.read(qualityFailures);
+  in.read(waveFailures);
+
+  for (size_t e = 0; e < edgeList.size(); ++e) edgeList[e]->loadCheckpoint(in);
+}
+
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	resetQMDegredation
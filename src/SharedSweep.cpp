@@ -0,0 +1,163 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      SharedSweep.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the SharedSweep.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Sweep shared between processes.
+//
+// ____________________________________________________________________________
+
+#include "SharedSweep.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Thread.h"
+
+extern Thread *threadZero;
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	SharedSweep
+// Description:		Creates the sweep with the files starting with
+//					the given prefix.
+//
+///////////////////////////////////////////////////////////////////
+SharedSweep::SharedSweep(const std::string &p) : prefix(p) {}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getJobFile
+// Description:		Returns the name of a file of the job
+//
+///////////////////////////////////////////////////////////////////
+std::string SharedSweep::getJobFile(size_t job, const char *extension) const {
+  std::ostringstream file;
+  file << prefix << "-Job-" << job << extension;
+
+  return file.str();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	createExclusive
+// Description:		Creates the file, unless it already exists. The
+//					check and the creation are a single step, so
+//					only one process can create the file.
+//
+///////////////////////////////////////////////////////////////////
+bool SharedSweep::createExclusive(const std::string &file,
+                                  const std::string &contents) {
+  FILE *out = fopen(file.c_str(), "wx");
+
+  if (out == nullptr) return false;
+
+  fputs(contents.c_str(), out);
+  fclose(out);
+
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	write
+// Description:		Writes the file under a temporary name first,
+//					so that the other processes never read a file
+//					that is only partly written.
+//
+///////////////////////////////////////////////////////////////////
+bool SharedSweep::write(const std::string &file, const std::string &contents) {
+  std::string temp = file + ".tmp";
+
+  std::ofstream out(temp.c_str(), std::ios::out | std::ios::trunc);
+  out << contents;
+  out.close();
+
+  std::remove(file.c_str());
+
+  return out.fail() == false && std::rename(temp.c_str(), file.c_str()) == 0;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	claim
+// Description:		Takes the job for this process, the claim file
+//					holds the process that took it.
+//
+///////////////////////////////////////////////////////////////////
+bool SharedSweep::claim(size_t job) const {
+  std::ostringstream owner;
+#ifdef _WIN32
+  owner << "PROCESS = " << _getpid() << std::endl;
+#else
+  owner << "PROCESS = " << getpid() << std::endl;
+#endif
+
+  return createExclusive(getJobFile(job, ".claim"), owner.str());
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	save
+// Description:		Saves the results of the job
+//
+///////////////////////////////////////////////////////////////////
+void SharedSweep::save(size_t job, const std::string &results) const {
+  std::string file = getJobFile(job, ".txt");
+
+  if (write(file, results) == false) {
+    std::ostringstream error;
+    error << "Unable to write the results of the job to " << file << ".";
+    threadZero->recordEvent(error.str(), true, 0);
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	merge
+// Description:		Merges the results of all of the jobs, in the
+//					order of the sweep, into the summary.
+//
+///////////////////////////////////////////////////////////////////
+bool SharedSweep::merge(size_t jobs) const {
+  std::ostringstream summary;
+
+  for (size_t j = 0; j < jobs; ++j) {
+    std::ifstream in(getJobFile(j, ".txt").c_str());
+
+    // Another process is still running the job.
+    if (in.is_open() == false) return false;
+
+    if (in.peek() != std::ifstream::traits_type::eof()) summary << in.rdbuf();
+  }
+
+  if (createExclusive(prefix + "-Summary.claim", "") == false) return false;
+
+  std::string file = prefix + "-Summary.txt";
+
+  std::ostringstream buffer;
+
+  if (write(file, summary.str()) == true)
+    buffer << "Merged the results of " << jobs << " jobs into " << file << ".";
+  else
+    buffer << "Unable to write the summary of the sweep to " << file << ".";
+
+  threadZero->recordEvent(buffer.str(), true, 0);
+
+  return true;
+}
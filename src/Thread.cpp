@@ -25,6 +25,9 @@
 
 #include "Thread.h"
 
+#include <climits>
+#include <cstdio>
+#include <map>
 #include <sstream>
 
 #ifndef NO_ALLEGRO
@@ -41,9 +44,8 @@ extern ALLEGRO_BITMAP* popup;
 extern Thread* threadZero;
 extern Thread** threads;
 
-extern size_t threadCount;
 
-extern std::vector<AlgorithmToRun*> algParams;
+extern JobScheduler scheduler;
 
 const double Thread::TEN_HOURS = 10.0 * 60.0 * 60.0;
 const double Thread::SPEED_OF_LIGHT = double(299792458);
@@ -57,30 +59,47 @@ const double Thread::SPEED_OF_LIGHT = double(299792458);
 //
 ///////////////////////////////////////////////////////////////////
 Thread::Thread()
-    : CurrentActiveWorkstations(0),
-      CurrentProbeStyle(ProbeStyle::NUMBER_OF_PROBE_STYLES),
-      CurrentQualityAware(false),
-      CurrentWavelengthAlgorithm(
-          WavelengthAlgorithm::NUMBER_OF_WAVELENGTH_ALGORITHMS),
+    : network(nullptr),
+      edgeStatus(nullptr),
+      edgeSessions(nullptr),
+      edgeDegredation(nullptr),
+      edgeStats(nullptr),
+      queue(nullptr),
+      pool(nullptr),
+      workers(nullptr),
+      usagePaths(nullptr),
+      dpArena(nullptr),
+      currentReplications(nullptr),
+      currentReplication(0),
+      convergence(nullptr),
+      stopTime(TEN_HOURS),
+      warmup(nullptr),
+      transientEvents(0),
+      nextCheckpoint(0.0),
+      trace(nullptr),
       globalTime(0.0),
       logger(nullptr),
-      maxRunCount(0),
-      maxSpans(0),
-      minDuration(0.0),
+      rm(nullptr),
+      stats(),
       numOfWavelengths(0),
-      numberOfConnections(0),
-      numberOfEdges(0),
+      CurrentRoutingAlgorithm(RoutingAlgorithm::NUMBER_OF_ROUTING_ALGORITHMS),
+      CurrentWavelengthAlgorithm(
+          WavelengthAlgorithm::NUMBER_OF_WAVELENGTH_ALGORITHMS),
+      CurrentProbeStyle(ProbeStyle::NUMBER_OF_PROBE_STYLES),
+      CurrentQualityAware(false),
+      CurrentActiveWorkstations(0),
+      qualityParams(),
+      randomSeed(0),
       numberOfRouters(0),
       numberOfWorkstations(0),
+      numberOfEdges(0),
+      numberOfConnections(0),
       order_init(false),
-      qualityParams(),
-      queue(nullptr),
-      randomSeed(0),
-      rm(nullptr),
-      runCount(0),
-      stats(),
       workstationOrder(nullptr),
-      CurrentRoutingAlgorithm(RoutingAlgorithm::NUMBER_OF_ROUTING_ALGORITHMS) {
+      minDuration(0.0),
+      maxSpans(0),
+      runCount(0),
+      maxRunCount(0) {
   threadZero->recordEvent(std::string("Unable to initialize the controller "
                                       "without command line arguments.\n"),
                           true, controllerIndex);
@@ -95,30 +114,47 @@ Thread::Thread()
 //
 ///////////////////////////////////////////////////////////////////
 Thread::Thread(size_t ci, int argc, const char* argv[], bool isLPS)
-    : CurrentActiveWorkstations(0),
-      CurrentProbeStyle(ProbeStyle::NUMBER_OF_PROBE_STYLES),
-      CurrentQualityAware(false),
-      CurrentWavelengthAlgorithm(
-          WavelengthAlgorithm::NUMBER_OF_WAVELENGTH_ALGORITHMS),
+    : network(nullptr),
+      edgeStatus(nullptr),
+      edgeSessions(nullptr),
+      edgeDegredation(nullptr),
+      edgeStats(nullptr),
+      queue(nullptr),
+      pool(nullptr),
+      workers(nullptr),
+      usagePaths(nullptr),
+      dpArena(nullptr),
+      currentReplications(nullptr),
+      currentReplication(0),
+      convergence(nullptr),
+      stopTime(TEN_HOURS),
+      warmup(nullptr),
+      transientEvents(0),
+      nextCheckpoint(0.0),
+      trace(nullptr),
       globalTime(0.0),
       logger(nullptr),
-      maxRunCount(0),
-      maxSpans(0),
-      minDuration(0.0),
+      rm(nullptr),
+      stats(),
       numOfWavelengths(0),
-      numberOfConnections(0),
-      numberOfEdges(0),
+      CurrentRoutingAlgorithm(RoutingAlgorithm::NUMBER_OF_ROUTING_ALGORITHMS),
+      CurrentWavelengthAlgorithm(
+          WavelengthAlgorithm::NUMBER_OF_WAVELENGTH_ALGORITHMS),
+      CurrentProbeStyle(ProbeStyle::NUMBER_OF_PROBE_STYLES),
+      CurrentQualityAware(false),
+      CurrentActiveWorkstations(0),
+      qualityParams(),
+      randomSeed(0),
       numberOfRouters(0),
       numberOfWorkstations(0),
+      numberOfEdges(0),
+      numberOfConnections(0),
       order_init(false),
-      qualityParams(),
-      queue(nullptr),
-      randomSeed(0),
-      rm(nullptr),
-      runCount(0),
-      stats(),
       workstationOrder(nullptr),
-      CurrentRoutingAlgorithm(RoutingAlgorithm::NUMBER_OF_ROUTING_ALGORITHMS) {
+      minDuration(0.0),
+      maxSpans(0),
+      runCount(0),
+      maxRunCount(0) {
   isLoadPrevious = isLPS;
 
   if (!isLoadPrevious) {
@@ -173,12 +209,22 @@ Thread::Thread(size_t ci, int argc, const char* argv[], bool isLPS)
 	logger = nullptr;
   }
 
-  std::string topologyfile = "input/Topology-" + topology + ".txt";
-  setTopologyParameters(topologyfile);
+  if (controllerIndex == 0) {
+    std::string topologyfile = "input/Topology-" + topology + ".txt";
+    std::string workstation =
+        "input/Workstation-" + topology + "-" + wavelengths + ".txt";
 
-  std::string workstation =
-      "input/Workstation-" + topology + "-" + wavelengths + ".txt";
-  setWorkstationParameters(workstation);
+#ifndef NO_ALLEGRO
+    strcpy(topoFile, topologyfile);
+    strcpy(wkstFile, workstation);
+#endif
+
+    network = Topology::load(topologyfile, workstation);
+  } else {
+    network = threadZero->getNetwork();
+  }
+
+  buildNetwork();
 
   if (controllerIndex == 0 && isLoadPrevious == false) {
     qualityParams.max_probes = atoi(argv[6]);
@@ -190,7 +236,23 @@ Thread::Thread(size_t ci, int argc, const char* argv[], bool isLPS)
   }
 
   if (isLoadPrevious == false) {
-    queue = new EventQueue();
+    queue = EventQueue::createEventQueue(
+        threadZero->getQualityParams().event_queue);
+    pool = new EventPool();
+    size_t w = threadZero->getQualityParams().run_workers;
+    workers = new WorkerPool(w, controllerIndex * w);
+    usagePaths = new UsagePathCache(getNumberOfRouters());
+    dpArena = new DPArena(getNumberOfRouters(), getNumberOfEdges(),
+                          threadZero->getNumberOfWavelengths());
+
+    const QualityParameters& qp = threadZero->getQualityParams();
+
+    if (qp.batch_precision > 0.0)
+      convergence = new BatchMeans(qp.batch_size, qp.min_batches,
+                                   qp.batch_precision, qp.batch_abs_precision);
+
+    if (qp.warmup_detection == true)
+      warmup = new WarmupDetector(qp.warmup_interval);
 
     randomSeed = atoi(argv[3]);
 
@@ -211,6 +273,13 @@ Thread::Thread(size_t ci, int argc, const char* argv[], bool isLPS)
 Thread::~Thread() {
   if (isLoadPrevious == false) {
     delete queue;
+    delete pool;
+    delete workers;
+    delete usagePaths;
+    delete dpArena;
+    delete convergence;
+    delete warmup;
+    delete trace;
   }
 
   if (controllerIndex == 0 && isLoadPrevious == false) {
@@ -227,6 +296,11 @@ Thread::~Thread() {
   routers.clear();
   workstations.clear();
 
+  delete[] edgeStatus;
+  delete[] edgeSessions;
+  delete[] edgeDegredation;
+  delete[] edgeStats;
+
   if (isLoadPrevious == false) {
     delete[] workstationOrder;
   }
@@ -240,44 +314,37 @@ Thread::~Thread() {
 //
 ///////////////////////////////////////////////////////////////////
 void Thread::initPriorityQueue() {
-  Event* activate = new Event;
-  activate->e_type = ACTIVATE_WORKSTATIONS;
-  activate->e_time = 0.0;
-  activate->e_data = nullptr;
+  Event activate;
+  activate.e_type = ACTIVATE_WORKSTATIONS;
+  activate.e_time = 0.0;
+  activate.e_data.request = nullptr;
 
-  Event* deactivate = new Event;
-  deactivate->e_type = DEACTIVATE_WORKSTATIONS;
-  deactivate->e_time = std::numeric_limits<double>::infinity();
-  deactivate->e_data = nullptr;
+  Event deactivate;
+  deactivate.e_type = DEACTIVATE_WORKSTATIONS;
+  deactivate.e_time = std::numeric_limits<double>::infinity();
+  deactivate.e_data.request = nullptr;
 
-  queue->addEvent(*deactivate);
-  queue->addEvent(*activate);
-
-  delete deactivate;
-  delete activate;
+  queue->addEvent(deactivate);
+  queue->addEvent(activate);
 
   if (CurrentRoutingAlgorithm == PABR || CurrentRoutingAlgorithm == LORA) {
-    Event* event = new Event();
-
-    event->e_type = UPDATE_USAGE;
-    event->e_time = 0.0;
-    event->e_data = nullptr;
+    Event event;
 
-    queue->addEvent(*event);
+    event.e_type = UPDATE_USAGE;
+    event.e_time = 0.0;
+    event.e_data.request = nullptr;
 
-    delete event;
+    queue->addEvent(event);
   }
 
 #ifndef NO_ALLEGRO
-  Event* event = new Event();
+  Event event;
 
-  event->e_type = UPDATE_GUI;
-  event->e_time = 0.0;
-  event->e_data = nullptr;
+  event.e_type = UPDATE_GUI;
+  event.e_time = 0.0;
+  event.e_data.request = nullptr;
 
-  queue->addEvent(*event);
-
-  delete event;
+  queue->addEvent(event);
 #endif
 }
 
@@ -314,6 +381,34 @@ void Thread::initThread(AlgorithmToRun* alg) {
   CurrentQualityAware = alg->qa;
   CurrentActiveWorkstations = alg->workstations;
 
+  currentReplications = alg->replications;
+  currentReplication = alg->replication;
+
+  // Each replication draws from its own stream, so that its results do not
+  // depend on which thread runs it or what that thread ran before.
+  if (currentReplications != nullptr) {
+    generator = std::default_random_engine(ReplicationSet::getReplicationSeed(
+        randomSeed, currentReplication));
+    order_init = false;
+  }
+
+  if (threadZero->getQualityParams().request_trace == true) {
+    std::string file = getTraceFile();
+
+    // Runs with the same workload keep using the trace that is mapped in.
+    if (trace == nullptr || trace->getFile() != file) {
+      unsigned int seed = static_cast<unsigned int>(randomSeed);
+
+      if (currentReplications != nullptr)
+        seed = ReplicationSet::getReplicationSeed(randomSeed,
+                                                  currentReplication);
+
+      delete trace;
+      trace = RequestTrace::open(file, this, seed, CurrentActiveWorkstations,
+                                 TEN_HOURS);
+    }
+  }
+
 #ifndef NO_ALLEGRO
   rectfill(mainbuf, 0, 50 * controllerIndex + 85 - 1, SCREEN_W,
            50 * (controllerIndex + 1) + 85 - 1, makecol(0, 0, 0));
@@ -329,6 +424,8 @@ void Thread::initThread(AlgorithmToRun* alg) {
                 makecol(0, 255, 0), -1, buffer);
 #endif
 
+  setGlobalTime(0.0);
+
   initPriorityQueue();
 
   delete alg;
@@ -344,12 +441,24 @@ void Thread::initThread(AlgorithmToRun* alg) {
 int Thread::runThread(AlgorithmToRun* alg) {
   initThread(alg);
 
+  const double checkpointInterval =
+      threadZero->getQualityParams().checkpoint_interval;
+
+  if (threadZero->getQualityParams().checkpoint_restore == true)
+    restoreCheckpoint();
+
+  if (checkpointInterval > 0.0)
+    nextCheckpoint =
+        (floor(getGlobalTime() / checkpointInterval) + 1.0) * checkpointInterval;
+  else
+    nextCheckpoint = std::numeric_limits<double>::infinity();
+
 #ifndef NO_ALLEGRO
   rectfill(mainbuf, 49, controllerIndex * 50 + 99, 651,
            controllerIndex * 50 + 99 + 26, makecol(0, 0, 255));
 #endif
 
-  while (queue->getSize() > 0) {
+  while (queue->getSize() > 0 || immediateLane.empty() == false) {
 #ifndef NO_ALLEGRO
     if (terminateProgram == true) {
       threadZero->recordEvent(
@@ -359,7 +468,40 @@ int Thread::runThread(AlgorithmToRun* alg) {
     }
 #endif
 
-    Event event = queue->getNextEvent();
+    if (getGlobalTime() >= nextCheckpoint && isQuiescent() == true) {
+      saveCheckpoint();
+
+      nextCheckpoint = (floor(getGlobalTime() / checkpointInterval) + 1.0) *
+                       checkpointInterval;
+    }
+
+    Event event;
+
+    if (immediateLane.empty() == false &&
+        (queue->getSize() == 0 ||
+         queue->peekNextEvent() < immediateLane.front())) {
+      event = immediateLane.front();
+      immediateLane.pop_front();
+    } else {
+      event = queue->getNextEvent();
+    }
+
+    // Teardown hops batched by the hop fast forward mode are handled in the
+    // same order as if they had been on the event queue.
+    while (teardownLane.empty() == false && event < teardownLane.top()) {
+      Event teardown = teardownLane.top();
+      teardownLane.pop();
+
+      setGlobalTime(teardown.e_time);
+#ifdef PROFILE_EVENTS
+      EventProfiler::Clock::time_point start = EventProfiler::Clock::now();
+#endif
+      destroy_connection_probe(teardown.e_data.destroy);
+#ifdef PROFILE_EVENTS
+      profiler.record(static_cast<EventType>(teardown.e_type), start,
+                      getPendingEvents(), getGlobalTime());
+#endif
+    }
 
     setGlobalTime(event.e_time);
 
@@ -378,6 +520,10 @@ int Thread::runThread(AlgorithmToRun* alg) {
     }
 #endif
 
+#ifdef PROFILE_EVENTS
+    EventProfiler::Clock::time_point start = EventProfiler::Clock::now();
+#endif
+
     switch (event.e_type) {
       case ACTIVATE_WORKSTATIONS:
         activate_workstations();
@@ -394,24 +540,40 @@ int Thread::runThread(AlgorithmToRun* alg) {
         break;
 #endif
       case CONNECTION_REQUEST:
-        connection_request(static_cast<ConnectionRequestEvent*>(event.e_data));
-        delete static_cast<ConnectionRequestEvent*>(event.e_data);
+        connection_request(event.e_data.request);
+        pool->release(event.e_data.request);
+
+        if (warmup != nullptr && warmup->isComplete() == false &&
+            warmup->isSampleDue(stats) == true &&
+            warmup->sample(stats, calculateUtilisation(), getGlobalTime()) ==
+                true) {
+          warmup->removeTransient(stats);
+
+          if (convergence != nullptr) convergence->reset(stats);
+        }
+
+        // No new traffic is generated once the estimates have converged,
+        // the connections in progress are still allowed to complete. The
+        // estimates are only checked once the warm-up has been removed.
+        if (convergence != nullptr && getGlobalTime() < stopTime &&
+            (warmup == nullptr || warmup->isComplete() == true) &&
+            convergence->update(stats) == true)
+          stopTime = getGlobalTime();
         break;
       case COLLISION_NOTIFICATION:
-        collision_notification(
-            static_cast<CollisionNotificationEvent*>(event.e_data));
+        --transientEvents;
+        collision_notification(event.e_data.collision);
         break;
       case CREATE_CONNECTION_PROBE:
-        create_connection_probe(
-            static_cast<CreateConnectionProbeEvent*>(event.e_data));
+        --transientEvents;
+        create_connection_probe(event.e_data.probe);
         break;
       case CREATE_CONNECTION_CONFIRMATION:
-        create_connection_confirmation(
-            static_cast<CreateConnectionConfirmationEvent*>(event.e_data));
+        --transientEvents;
+        create_connection_confirmation(event.e_data.confirmation);
         break;
       case DESTROY_CONNECTION_PROBE:
-        destroy_connection_probe(
-            static_cast<DestroyConnectionProbeEvent*>(event.e_data));
+        destroy_connection_probe(event.e_data.destroy);
         break;
       default:
         threadZero->recordEvent(
@@ -420,6 +582,11 @@ int Thread::runThread(AlgorithmToRun* alg) {
         exit(ERROR_THREAD_EVENT_TYPE);
         break;
     }
+
+#ifdef PROFILE_EVENTS
+    profiler.record(static_cast<EventType>(event.e_type), start,
+                    getPendingEvents(), getGlobalTime());
+#endif
   }
 
   return 0;
@@ -433,14 +600,6 @@ int Thread::runThread(AlgorithmToRun* alg) {
 //
 ///////////////////////////////////////////////////////////////////
 void Thread::activate_workstations() {
-#ifndef NO_ALLEGRO
-  ConnsPerPx =
-      (threadZero->getNumberOfConnections() * getCurrentActiveWorkstations()) /
-      progBarLengthpx;
-  multFactor = 600.0 / double(getCurrentActiveWorkstations() *
-                              threadZero->getNumberOfConnections());
-#endif
-
   stats.ConnectionRequests = 0;
   stats.ConnectionSuccesses = 0;
   stats.CollisionFailures = 0;
@@ -456,34 +615,24 @@ void Thread::activate_workstations() {
   stats.aseNoiseTotal = 0.0;
   stats.fwmNoiseTotal = 0.0;
   stats.xpmNoiseTotal = 0.0;
+  stats.qFactorTotal = 0.0;
   stats.raRunTime = 0.0;
+  stats.candidateSearches = 0;
+  stats.candidateFallbacks = 0;
 
-  // Random generator for destination router
-  generateRandomRouter =
-      std::uniform_int_distribution<size_t>(0, getNumberOfRouters() - 1);
+  pool->resetStats();
 
-  // Random generator for duration time
-  generateRandomDuration = std::exponential_distribution<double>(
-      1.0 / double(threadZero->getQualityParams().duration));
+#ifdef PROFILE_EVENTS
+  profiler.reset(getGlobalTime());
+#endif
 
-  // Random generator for arrival interval
-  generateArrivalInterval = std::exponential_distribution<double>(
-      1.0 / double(threadZero->getQualityParams().arrival_interval));
+  stopTime = TEN_HOURS;
 
-  if (CurrentRoutingAlgorithm == SHORTEST_PATH) {
-    threadZero->getResourceManager()->initSPMatrix();
-  } else {
-    bool SP_active = false;
+  if (convergence != nullptr) convergence->reset(stats);
 
-    for (size_t t = 0; t < threadCount; ++t) {
-      if (threads[t]->getCurrentRoutingAlgorithm() == SHORTEST_PATH) {
-        SP_active = true;
-        break;
-      }
-    }
+  if (warmup != nullptr) warmup->reset(stats, getGlobalTime());
 
-    if (SP_active == false) threadZero->getResourceManager()->freeSPMatrix();
-  }
+  prepareRun();
 
   if (CurrentRoutingAlgorithm == ADAPTIVE_QoS) {
     for (size_t r = 0; r < getNumberOfRouters(); ++r) {
@@ -491,7 +640,13 @@ void Thread::activate_workstations() {
     }
   }
 
-  if (order_init == false) {
+  if (trace != nullptr) {
+    // The trace decides which of the workstations are active.
+    for (size_t w = 0; w < getNumberOfWorkstations(); ++w)
+      workstationOrder[w] = trace->getWorkstationAt(w);
+
+    traceCursor.assign(getNumberOfWorkstations(), 0);
+  } else if (order_init == false) {
     std::uniform_int_distribution<size_t> generateRandomWorkstation =
         std::uniform_int_distribution<size_t>(0, getNumberOfWorkstations() - 1);
 
@@ -539,6 +694,8 @@ void Thread::activate_workstations() {
     for (size_t r = 0; r < getNumberOfRouters(); ++r) {
       getRouterAt(r)->resetUsage();
     }
+
+    usagePaths->invalidate();
   } else if (CurrentRoutingAlgorithm == Q_MEASUREMENT ||
              CurrentRoutingAlgorithm == ADAPTIVE_QoS) {
     for (size_t r = 0; r < getNumberOfRouters(); ++r) {
@@ -551,6 +708,35 @@ void Thread::activate_workstations() {
       generateTrafficEvent(w * threadZero->getNumberOfConnections());
 }
 
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	prepareRun
+// Description:		Sets up the random distributions and the progress
+//					bar used by the current run.
+//
+///////////////////////////////////////////////////////////////////
+void Thread::prepareRun() {
+  // Random generator for destination router
+  generateRandomRouter =
+      std::uniform_int_distribution<size_t>(0, getNumberOfRouters() - 1);
+
+  // Random generator for duration time
+  generateRandomDuration = std::exponential_distribution<double>(
+      1.0 / double(threadZero->getQualityParams().duration));
+
+  // Random generator for arrival interval
+  generateArrivalInterval = std::exponential_distribution<double>(
+      1.0 / double(threadZero->getQualityParams().arrival_interval));
+
+#ifndef NO_ALLEGRO
+  ConnsPerPx =
+      (threadZero->getNumberOfConnections() * getCurrentActiveWorkstations()) /
+      progBarLengthpx;
+  multFactor = 600.0 / double(getCurrentActiveWorkstations() *
+                              threadZero->getNumberOfConnections());
+#endif
+}
+
 ///////////////////////////////////////////////////////////////////
 //
 // Function Name:	deactivateWorkstations
@@ -561,6 +747,9 @@ void Thread::activate_workstations() {
 void Thread::deactivate_workstations() {
   threadZero->getLogger()->LockResultsMutex();
 
+  if (scheduler.isShared() == true)
+    threadZero->getLogger()->startCapture(controllerIndex);
+
   std::ostringstream algorithm;
   algorithm << "**ALGORITHM = "
             << threadZero->getRoutingAlgorithmName(CurrentRoutingAlgorithm)
@@ -570,8 +759,32 @@ void Thread::deactivate_workstations() {
             << ", WORKS = " << getCurrentActiveWorkstations()
             << ", PROBE = " << threadZero->getProbeStyleName(CurrentProbeStyle)
             << ", QA = " << getCurrentQualityAware();
+
+  if (currentReplications != nullptr)
+    algorithm << ", REPLICATION = " << currentReplication;
+
   threadZero->recordEvent(algorithm.str(), true, controllerIndex);
 
+  if (convergence != nullptr) {
+    std::ostringstream length;
+    length << "RUN LENGTH = " << stopTime << " ("
+           << convergence->getNumberOfBatches() << " BATCHES), STOP REASON = "
+           << (stopTime < TEN_HOURS ? "CONVERGED" : "TIME LIMIT");
+    threadZero->recordEvent(length.str(), true, controllerIndex);
+  }
+
+  if (warmup != nullptr) {
+    std::ostringstream transient;
+
+    if (warmup->isComplete() == true)
+      transient << "WARM UP = " << warmup->getWarmupTime() << " ("
+                << warmup->getDeletedRequests() << " REQUESTS DELETED)";
+    else
+      transient << "WARM UP = NOT DETECTED";
+
+    threadZero->recordEvent(transient.str(), true, controllerIndex);
+  }
+
 #ifndef NO_ALLEGRO
   strcpy(routing,
          threadZero->getRoutingAlgorithmName(CurrentRoutingAlgorithm)->c_str());
@@ -679,6 +892,38 @@ void Thread::deactivate_workstations() {
           << ") = " << stats.raRunTime / double(stats.ConnectionRequests);
   threadZero->recordEvent(runtime.str(), true, controllerIndex);
 
+  if (threadZero->getQualityParams().candidate_paths > 0 &&
+      stats.candidateSearches > 0) {
+    std::ostringstream fallbacks;
+    fallbacks << "CANDIDATE PATH FALLBACKS (" << stats.candidateFallbacks
+              << "/" << stats.candidateSearches << ") = "
+              << double(stats.candidateFallbacks) /
+                     double(stats.candidateSearches);
+    threadZero->recordEvent(fallbacks.str(), true, controllerIndex);
+  }
+
+  const EventType payloadTypes[] = {
+      CONNECTION_REQUEST, CREATE_CONNECTION_PROBE,
+      CREATE_CONNECTION_CONFIRMATION, COLLISION_NOTIFICATION,
+      DESTROY_CONNECTION_PROBE};
+  const std::string payloadNames[] = {"REQUEST", "PROBE", "CONFIRMATION",
+                                      "COLLISION", "DESTROY"};
+
+  for (size_t t = 0; t < 5; ++t) {
+    const PayloadPoolStats* ps = pool->getStats(payloadTypes[t]);
+
+    std::ostringstream payloads;
+    payloads << "EVENT POOL " << payloadNames[t]
+             << ": ACQUIRED = " << ps->acquired << ", REUSED = " << ps->reused
+             << ", PEAK = " << ps->peakOutstanding
+             << ", SLABS = " << ps->slabs;
+    threadZero->recordEvent(payloads.str(), true, controllerIndex);
+  }
+
+#ifdef PROFILE_EVENTS
+  profiler.print(controllerIndex);
+#endif
+
   if (threadZero->getQualityParams().q_factor_stats == true) {
     double worstInitQ = std::numeric_limits<double>::infinity();
     double bestInitQ = 0.0;
@@ -768,10 +1013,35 @@ void Thread::deactivate_workstations() {
         << std::endl;
   threadZero->recordEvent(stars.str(), true, controllerIndex);
 
+  AlgorithmToRun* next = nullptr;
+  bool finished = false;
+
+  if (currentReplications != nullptr)
+    next = currentReplications->addReplication(stats, controllerIndex,
+                                               &finished);
+
+  std::string results;
+
+  if (scheduler.isShared() == true)
+    results = threadZero->getLogger()->stopCapture();
+
   threadZero->flushLog(true);
 
   threadZero->getLogger()->UnlockResultsMutex();
 
+  // The scheduler is only called once the results mutex is released, so
+  // that its mutex is never taken while holding the results mutex.
+  if (currentReplications != nullptr) {
+    if (next != nullptr) scheduler.addJob(next, controllerIndex);
+
+    if (finished == true) delete currentReplications;
+
+    currentReplications = nullptr;
+  }
+
+  if (scheduler.isShared() == true)
+    scheduler.recordResults(controllerIndex, results);
+
   for (size_t r1 = 0; r1 < getNumberOfRouters(); ++r1) {
     for (size_t r2 = 0; r2 < getNumberOfRouters(); ++r2) {
       Edge* edge = getRouterAt(r1)->getEdgeByDestination(r2);
@@ -814,19 +1084,34 @@ void Thread::deactivate_workstations() {
 void Thread::generateTrafficEvent(size_t session) {
   size_t workstation = session / threadZero->getNumberOfConnections();
 
-  Event* tr = new Event();
-  ConnectionRequestEvent* tr_data = new ConnectionRequestEvent();
+  const TraceRecord* record = nullptr;
+
+  if (trace != nullptr) {
+    record = trace->getRecord(workstation, traceCursor[workstation]++);
 
-  tr->e_time = getGlobalTime() + generateArrivalInterval(generator);
-  tr->e_type = CONNECTION_REQUEST;
-  tr->e_data = tr_data;
+    // The trace holds every request up to the ten hour mark, so the
+    // workstation has no more requests to make once it runs out.
+    if (record == nullptr) return;
+  }
+
+  Event tr;
+  ConnectionRequestEvent* tr_data = pool->acquireRequest();
 
-  tr_data->connectionDuration = generateRandomDuration(generator);
+  tr.e_type = CONNECTION_REQUEST;
+  tr.e_data.request = tr_data;
+
+  if (record != nullptr) {
+    tr.e_time = record->arrivalTime;
+    tr_data->connectionDuration = record->duration;
+  } else {
+    tr.e_time = getGlobalTime() + generateArrivalInterval(generator);
+    tr_data->connectionDuration = generateRandomDuration(generator);
 
-  if (tr_data->connectionDuration < threadZero->getMinDuration())
-    tr_data->connectionDuration = threadZero->getMinDuration();
+    if (tr_data->connectionDuration < threadZero->getMinDuration())
+      tr_data->connectionDuration = threadZero->getMinDuration();
+  }
 
-  tr_data->requestBeginTime = tr->e_time;
+  tr_data->requestBeginTime = tr.e_time;
   tr_data->sourceRouterIndex =
       getWorkstationAt(workstation)->getParentRouterIndex();
   tr_data->destinationRouterIndex = tr_data->sourceRouterIndex;
@@ -835,6 +1120,9 @@ void Thread::generateTrafficEvent(size_t session) {
   tr_data->max_sequence = 0;
   tr_data->qualityFail = false;
 
+  if (record != nullptr)
+    tr_data->destinationRouterIndex = size_t(record->destination);
+
   while (tr_data->sourceRouterIndex == tr_data->destinationRouterIndex) {
     if (threadZero->getQualityParams().dest_dist == UNIFORM)
       tr_data->destinationRouterIndex = (generateRandomRouter(generator));
@@ -850,9 +1138,7 @@ void Thread::generateTrafficEvent(size_t session) {
   routers[tr_data->destinationRouterIndex]->incConnAttemptsTo();
 #endif
 
-  queue->addEvent(*tr);
-
-  delete tr;
+  queue->addEvent(tr);
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -862,7 +1148,7 @@ void Thread::generateTrafficEvent(size_t session) {
 //
 ///////////////////////////////////////////////////////////////////
 void Thread::connection_request(ConnectionRequestEvent* cre) {
-  if (getGlobalTime() < TEN_HOURS) {
+  if (getGlobalTime() < stopTime) {
     if ((cre->session + 1) % threadZero->getNumberOfConnections() != 0)
       generateTrafficEvent(cre->session + 1);
     else
@@ -913,9 +1199,8 @@ void Thread::create_connection_probe(CreateConnectionProbeEvent* ccpe) {
       double fwm_noise = 0.0;
       double ase_noise = 0.0;
 
-      Event* event = new Event();
-      CreateConnectionConfirmationEvent* ccce =
-          new CreateConnectionConfirmationEvent;
+      Event event;
+      CreateConnectionConfirmationEvent* ccce = pool->acquireConfirmation();
 
       ccce->connectionDuration = ccpe->connectionDuration;
       ccce->requestBeginTime = ccpe->requestBeginTime;
@@ -1017,41 +1302,28 @@ void Thread::create_connection_probe(CreateConnectionProbeEvent* ccpe) {
 
         create_connection_probe(ccpe->probes[sequence]);
 
-        delete ccce;
+        pool->release(ccce);
       } else if ((ccpe->wavelength == QUALITY_FAILURE ||
                   ccpe->wavelength == NO_PATH_FAILURE) &&
                  moreProbes(ccpe) == true) {
         // Don't send rejection, just wait for more probes
-        delete ccce;
+        pool->release(ccce);
       } else {
-        event->e_type = CREATE_CONNECTION_CONFIRMATION;
-        event->e_time =
+        event.e_type = CREATE_CONNECTION_CONFIRMATION;
+        event.e_time =
             getGlobalTime() +
             calculateDelay(ccpe->connectionPath[ccpe->numberOfHops - 1]
                                ->getNumberOfSpans());
-        event->e_data = ccce;
+        event.e_data.confirmation = ccce;
 
-        queue->addEvent(*event);
+        scheduleEvent(event);
       }
 
-      if (CurrentProbeStyle != PARALLEL) delete ccpe;
-
-      delete event;
+      if (CurrentProbeStyle != PARALLEL) pool->release(ccpe);
     }
   } else {
     // We are not at our destination yet, so continue with the probe.
-    Event* event = new Event();
-
-    event->e_type = CREATE_CONNECTION_PROBE;
-    event->e_time =
-        getGlobalTime() +
-        calculateDelay(
-            ccpe->connectionPath[ccpe->numberOfHops]->getNumberOfSpans());
-    event->e_data = ccpe;
-
-    queue->addEvent(*event);
-
-    delete event;
+    forwardProbe(ccpe);
   }
 }
 
@@ -1122,21 +1394,12 @@ void Thread::destroy_connection_probe(DestroyConnectionProbeEvent* dcpe) {
       clearResponses(dcpe->probes[dcpe->sequence]);
 
     delete[] dcpe->connectionPath;
-    delete dcpe;
-  } else {
-    // We are not at our destination yet, so continue with the probe.
-    Event* event = new Event();
-
-    event->e_type = DESTROY_CONNECTION_PROBE;
-    event->e_time =
-        getGlobalTime() +
-        calculateDelay(
-            dcpe->connectionPath[dcpe->numberOfHops]->getNumberOfSpans());
-    event->e_data = dcpe;
-
-    queue->addEvent(*event);
-
-    delete event;
+    pool->release(dcpe);
+  } else if (threadZero->getQualityParams().hop_fast_forward == false ||
+             dcpe->numberOfHops == 1) {
+    // We are not at our destination yet, so continue with the probe. In
+    // fast forward mode the remaining hops were all scheduled by the first.
+    forwardTeardown(dcpe);
   }
 }
 
@@ -1168,12 +1431,12 @@ void Thread::create_connection_confirmation(
            << ", Sequence = " << ccce->sequence;
     threadZero->recordEvent(buffer.str(), false, controllerIndex);
 
-    Event* event = new Event();
-    CollisionNotificationEvent* cne = new CollisionNotificationEvent();
+    Event event;
+    CollisionNotificationEvent* cne = pool->acquireCollision();
 
-    event->e_type = COLLISION_NOTIFICATION;
-    event->e_time = getGlobalTime() + calculateDelay(edge->getNumberOfSpans());
-    event->e_data = cne;
+    event.e_type = COLLISION_NOTIFICATION;
+    event.e_time = getGlobalTime() + calculateDelay(edge->getNumberOfSpans());
+    event.e_data.collision = cne;
 
     cne->sourceRouterIndex = edge->getSourceIndex();
     cne->destinationRouterIndex = ccce->destinationRouterIndex;
@@ -1216,9 +1479,7 @@ void Thread::create_connection_confirmation(
 
     ccce->finalFailure = cne->finalFailure;
 
-    queue->addEvent(*event);
-
-    delete event;
+    scheduleEvent(event);
 
     ccce->wavelength = COLLISION_FAILURE;
   }
@@ -1227,15 +1488,13 @@ void Thread::create_connection_confirmation(
 
   if (ccce->connectionLength > ccce->numberOfHops) {
     // Forward the confirmation downstream.
-    Event* event = new Event();
-
-    event->e_type = CREATE_CONNECTION_CONFIRMATION;
-    event->e_time = getGlobalTime() + calculateDelay(edge->getNumberOfSpans());
-    event->e_data = ccce;
+    Event event;
 
-    queue->addEvent(*event);
+    event.e_type = CREATE_CONNECTION_CONFIRMATION;
+    event.e_time = getGlobalTime() + calculateDelay(edge->getNumberOfSpans());
+    event.e_data.confirmation = ccce;
 
-    delete event;
+    scheduleEvent(event);
   } else if (ccce->connectionLength == ccce->numberOfHops) {
     if (ccce->wavelength >= 0) {
       ++stats.ConnectionSuccesses;
@@ -1263,12 +1522,12 @@ void Thread::create_connection_confirmation(
 
       // Yeah, we have made it back to the destination and everything worked
       // great.
-      Event* event = new Event();
-      DestroyConnectionProbeEvent* dcpe = new DestroyConnectionProbeEvent();
+      Event event;
+      DestroyConnectionProbeEvent* dcpe = pool->acquireDestroy();
 
-      event->e_type = DESTROY_CONNECTION_PROBE;
-      event->e_time = getGlobalTime() + ccce->connectionDuration;
-      event->e_data = dcpe;
+      event.e_type = DESTROY_CONNECTION_PROBE;
+      event.e_time = getGlobalTime() + ccce->connectionDuration;
+      event.e_data.destroy = dcpe;
 
       dcpe->connectionLength = ccce->connectionLength;
       dcpe->connectionPath = ccce->connectionPath;
@@ -1278,9 +1537,7 @@ void Thread::create_connection_confirmation(
       dcpe->sequence = ccce->sequence;
       dcpe->probes = ccce->probes;
 
-      queue->addEvent(*event);
-
-      delete event;
+      queue->addEvent(event);
 
       if (threadZero->getQualityParams().q_factor_stats == true ||
           CurrentRoutingAlgorithm == Q_MEASUREMENT ||
@@ -1327,14 +1584,14 @@ void Thread::create_connection_confirmation(
         delete ccce->kPaths;
       }
 
-      delete ccce;
+      pool->release(ccce);
     } else if (CurrentProbeStyle == SERIAL &&
                ccce->sequence < ccce->max_sequence - 1) {
       long long int probesToSend = 0;
       long long int probeStart = 0;
       long long int probesSkipped = ccce->sequence + 1;
 
-      ConnectionRequestEvent* cre = new ConnectionRequestEvent;
+      ConnectionRequestEvent* cre = pool->acquireRequest();
 
       cre->connectionDuration = ccce->connectionDuration;
       cre->destinationRouterIndex = ccce->destinationRouterIndex;
@@ -1357,9 +1614,9 @@ void Thread::create_connection_confirmation(
                  probesSkipped);
 
       delete[] ccce->connectionPath;
-      delete ccce;
+      pool->release(ccce);
 
-      delete cre;
+      pool->release(cre);
     } else if (ccce->wavelength == COLLISION_FAILURE) {
       if (CurrentProbeStyle == PARALLEL && ccce->finalFailure == true) {
         clearResponses(ccce->probes[ccce->sequence]);
@@ -1379,7 +1636,7 @@ void Thread::create_connection_confirmation(
         delete[] ccce->connectionPath;
       }
 
-      delete ccce;
+      pool->release(ccce);
     } else if (ccce->wavelength == QUALITY_FAILURE) {
       if (CurrentRoutingAlgorithm == ADAPTIVE_QoS) {
         getRouterAt(ccce->sourceRouterIndex)->incrementQualityFailures();
@@ -1401,7 +1658,7 @@ void Thread::create_connection_confirmation(
       }
 
       delete[] ccce->connectionPath;
-      delete ccce;
+      pool->release(ccce);
     } else if (ccce->wavelength == NO_PATH_FAILURE) {
       if (CurrentRoutingAlgorithm == ADAPTIVE_QoS) {
         getRouterAt(ccce->sourceRouterIndex)->incrementWaveFailures();
@@ -1423,7 +1680,7 @@ void Thread::create_connection_confirmation(
       }
 
       delete[] ccce->connectionPath;
-      delete ccce;
+      pool->release(ccce);
     }
   } else {
     threadZero->recordEvent(
@@ -1474,21 +1731,63 @@ void Thread::collision_notification(CollisionNotificationEvent* cne) {
     }
 
     delete[] cne->connectionPath;
-    delete cne;
+    pool->release(cne);
   } else {
-    Event* event = new Event();
+    Event event;
 
-    event->e_type = COLLISION_NOTIFICATION;
-    event->e_time =
+    event.e_type = COLLISION_NOTIFICATION;
+    event.e_time =
         getGlobalTime() +
         calculateDelay(
             cne->connectionPath[cne->numberOfHops]->getNumberOfSpans());
-    event->e_data = cne;
+    event.e_data.collision = cne;
+
+    scheduleEvent(event);
+  }
+}
 
-    queue->addEvent(*event);
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	setQualityOption
+// Description:		Sets an option of the quality file from an integer
+//					value, or to its fallback when the value is outside
+//					of [minimum, maximum], and logs the setting.
+//
+///////////////////////////////////////////////////////////////////
+template <typename T>
+void Thread::setQualityOption(const std::string& name,
+                              const std::string& value, int minimum,
+                              int maximum, T fallback, T& option) {
+  int v = std::stoi(value);
 
-    delete event;
+  if (v >= minimum && v <= maximum)
+    option = static_cast<T>(v);
+  else {
+    std::ostringstream buffer;
+    buffer << "Unexpected value input for " << name << ".";
+    threadZero->recordEvent(buffer.str(), true, 0);
+    option = fallback;
   }
+
+  std::ostringstream buffer;
+  buffer << "\t" << name << " = " << option;
+  threadZero->recordEvent(buffer.str(), true, 0);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	setQualityOption
+// Description:		Sets a real option of the quality file and logs
+//					the setting.
+//
+///////////////////////////////////////////////////////////////////
+void Thread::setQualityOption(const std::string& name,
+                              const std::string& value, double& option) {
+  option = std::stod(value);
+
+  std::ostringstream buffer;
+  buffer << "\t" << name << " = " << option;
+  threadZero->recordEvent(buffer.str(), true, 0);
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -1502,6 +1801,57 @@ void Thread::setQualityParameters(const std::string& f) {
   // Default setting is uniform. Can be modifed using the parameter file.
   qualityParams.dest_dist = UNIFORM;
 
+  // Default setting is the binary heap. Can be modifed using the parameter
+  // file.
+  qualityParams.event_queue = HEAP_QUEUE;
+
+  // Default setting is one event per hop. Can be modifed using the parameter
+  // file.
+  qualityParams.hop_fast_forward = false;
+
+  // Default setting is a single core per run. Can be modifed using the
+  // parameter file.
+  qualityParams.run_workers = 1;
+
+  // Default setting is a single run per configuration. Can be modifed using
+  // the parameter file.
+  qualityParams.max_replications = 1;
+  qualityParams.min_replications = 3;
+  qualityParams.ci_half_width = 0.0;
+
+  // Default setting is to run for the full ten hours. Can be modifed using
+  // the parameter file.
+  qualityParams.batch_precision = 0.0;
+  qualityParams.batch_abs_precision = 0.001;
+  qualityParams.batch_size = 1000;
+  qualityParams.min_batches = 10;
+
+  // Default setting is to count the whole run. Can be modifed using the
+  // parameter file.
+  qualityParams.warmup_detection = false;
+  qualityParams.warmup_interval = 20;
+
+  // Default setting is to not use checkpoints. Can be modifed using the
+  // parameter file.
+  qualityParams.checkpoint_interval = 0.0;
+  qualityParams.checkpoint_restore = false;
+
+  // Default setting is to draw the requests from the generator. Can be
+  // modifed using the parameter file.
+  qualityParams.request_trace = false;
+
+  // Default setting is to let the threads run on any core. Can be modifed
+  // using the parameter file.
+  qualityParams.thread_affinity = false;
+
+  // Default setting is to run the whole sweep in this process. Can be
+  // modifed using the parameter file.
+  qualityParams.shared_sweep = false;
+
+  // Default setting is to search for the paths of each request. Can be
+  // modifed using the parameter file.
+  qualityParams.candidate_paths = 0;
+
   std::string log = "Reading Quality Parameters from " + f + " file.";
   threadZero->recordEvent(log, true, 0);
 
@@ -1690,6 +2040,54 @@ void Thread::setQualityParameters(const std::string& f) {
       std::ostringstream buffer;
       buffer << "\tdest_dist = " << qualityParams.dest_dist;
       threadZero->recordEvent(buffer.str(), true, 0);
+    } else if (param == "event_queue") {
+      setQualityOption(param, value, 1, 3, HEAP_QUEUE,
+                       qualityParams.event_queue);
+    } else if (param == "hop_fast_forward") {
+      setQualityOption(param, value, 0, 1, false,
+                       qualityParams.hop_fast_forward);
+    } else if (param == "run_workers") {
+      setQualityOption(param, value, 1, INT_MAX, size_t(1),
+                       qualityParams.run_workers);
+    } else if (param == "max_replications") {
+      setQualityOption(param, value, 1, INT_MAX, size_t(1),
+                       qualityParams.max_replications);
+    } else if (param == "min_replications") {
+      setQualityOption(param, value, 2, INT_MAX, size_t(3),
+                       qualityParams.min_replications);
+    } else if (param == "ci_half_width") {
+      setQualityOption(param, value, qualityParams.ci_half_width);
+    } else if (param == "batch_precision") {
+      setQualityOption(param, value, qualityParams.batch_precision);
+    } else if (param == "batch_abs_precision") {
+      setQualityOption(param, value, qualityParams.batch_abs_precision);
+    } else if (param == "batch_size") {
+      setQualityOption(param, value, 1, INT_MAX, size_t(1000),
+                       qualityParams.batch_size);
+    } else if (param == "min_batches") {
+      setQualityOption(param, value, 2, INT_MAX, size_t(10),
+                       qualityParams.min_batches);
+    } else if (param == "warmup_detection") {
+      setQualityOption(param, value, 0, 1, false,
+                       qualityParams.warmup_detection);
+    } else if (param == "warmup_interval") {
+      setQualityOption(param, value, 1, INT_MAX, size_t(20),
+                       qualityParams.warmup_interval);
+    } else if (param == "checkpoint_interval") {
+      setQualityOption(param, value, qualityParams.checkpoint_interval);
+    } else if (param == "checkpoint_restore") {
+      setQualityOption(param, value, 0, 1, false,
+                       qualityParams.checkpoint_restore);
+    } else if (param == "request_trace") {
+      setQualityOption(param, value, 0, 1, false, qualityParams.request_trace);
+    } else if (param == "thread_affinity") {
+      setQualityOption(param, value, 0, 1, false,
+                       qualityParams.thread_affinity);
+    } else if (param == "shared_sweep") {
+      setQualityOption(param, value, 0, 1, false, qualityParams.shared_sweep);
+    } else if (param == "candidate_paths") {
+      setQualityOption(param, value, 0, INT_MAX, size_t(0),
+                       qualityParams.candidate_paths);
     } else if (param == "DP_alpha") {
       qualityParams.DP_alpha = std::stod(value);
       std::ostringstream buffer;
@@ -1768,167 +2166,50 @@ void Thread::setQualityParameters(const std::string& f) {
 
 ///////////////////////////////////////////////////////////////////
 //
-// Function Name:	setTopologyParameters
-// Description:		Opens up the Topology Paremeters file that was
-//					specified by the command line arguement
+// Function Name:	buildNetwork
+// Description:		Creates the routers, edges and workstations of
+//					the thread from the shared topology, with the
+//					state of the wavelengths of all of the edges
+//					kept in one block.
 //
 ///////////////////////////////////////////////////////////////////
-void Thread::setTopologyParameters(const std::string& f) {
-  std::ostringstream buffer;
-  buffer << "Reading Topology Parameters from " << f << " file.";
-  threadZero->recordEvent(buffer.str(), false, 0);
-
-#ifndef NO_ALLEGRO
-  strcpy(topoFile, f);
-#endif
-
-  std::ifstream inFile(f);
-
-  if (!inFile.is_open()) {
-    std::cerr << "Error opening toplogy file: " << f << std::endl;
-    exit(ERROR_TOPOLOGY_FILE);
-  }
-
-  std::string line;
-
-  numberOfRouters = 0;
-  numberOfEdges = 0;
+void Thread::buildNetwork() {
+  numberOfRouters = network->getNumberOfRouters();
+  numberOfEdges = network->getNumberOfEdges();
+  numberOfWorkstations = network->getNumberOfWorkstations();
 
-  while (std::getline(inFile, line)) {
-    std::vector<std::string> tokens = split(line, '=');
-
-    if (tokens.size() != 2) {
-      std::string err = "Invalid line in topology file: " + line;
-      threadZero->recordEvent(err, false, 0);
-      inFile.close();
-      exit(ERROR_TOPOLOGY_FILE);
-    }
+  size_t w = threadZero->getNumberOfWavelengths();
 
-    std::string param = tokens[0];
+  edgeStatus = new EdgeStatus[numberOfEdges * w];
+  edgeSessions = new long long int[numberOfEdges * w];
+  edgeDegredation = new double[numberOfEdges * w];
+  edgeStats = new EdgeStats[numberOfEdges];
 
-    if (param == "Router") {
-      Router* r = new Router;
+  for (size_t r = 0; r < numberOfRouters; ++r) {
+    Router* router = new Router;
 
-      r->setIndex(numberOfRouters);
+    router->setIndex(r);
+    router->setAdjacency(network->getAdjacency(r));
 
 #ifndef NO_ALLEGRO
-      std::vector<std::string> coordinates = split(tokens[1], ',');
-
-      if (coordinates.size() != 2) {
-        std::string err = "Invalid router line in topology file: " + line;
-        threadZero->recordEvent(err, false, 0);
-        inFile.close();
-        exit(ERROR_TOPOLOGY_INPUT_ROUTERS)
-      }
-
-      r->setXPercent(std::stoi(coordinates[0]));
-      r->setYPercent(std::stoi(coordinates[1]))
-          :
+    router->setXPercent(network->getXPercent(r));
+    router->setYPercent(network->getYPercent(r));
 #endif
-            addRouter(r);
-
-      ++numberOfRouters;
-    } else if (param == "Edge") {
-      std::vector<std::string> coordinates = split(tokens[1], ',');
-
-      if (coordinates.size() != 3) {
-        std::string err = "Invalid edge line in topology file: " + line;
-        threadZero->recordEvent(err, false, 0);
-        inFile.close();
-        exit(ERROR_TOPOLOGY_INPUT_EDGES);
-      }
-
-      size_t from = std::stoi(coordinates[0]);
-      size_t to = std::stoi(coordinates[1]);
-      size_t spans = std::stoi(coordinates[2]);
-
-      Edge* e1 = new Edge(from, to, spans);
-      Edge* e2 = new Edge(to, from, spans);
 
-      getRouterAt(from)->addEdge(e1);
-      getRouterAt(to)->addEdge(e2);
-
-      numberOfEdges += 2;
-    } else {
-      threadZero->recordEvent("ERROR: Invalid line in the input file!!!", true,
-                              0);
-      inFile.close();
-      exit(ERROR_TOPOLOGY_FILE);
+    for (size_t e = network->getFirstEdge(r); e < network->getFirstEdge(r + 1);
+         ++e) {
+      router->addEdge(new Edge(r, network->getEdgeDestination(e),
+                               network->getEdgeSpans(e), &edgeStatus[e * w],
+                               &edgeSessions[e * w], &edgeDegredation[e * w],
+                               &edgeStats[e]));
     }
-  }
 
-  std::ostringstream routers;
-  routers << "\tCreated " << numberOfRouters << " routers.";
-  threadZero->recordEvent(buffer.str(), false, 0);
+    addRouter(router);
+  }
 
-  std::ostringstream edges;
-  edges << "\tCreated " << numberOfEdges << " edges.";
-  threadZero->recordEvent(buffer.str(), false, 0);
-
-  inFile.close();
-}
-
-///////////////////////////////////////////////////////////////////
-//
-// Function Name:	setWorkstationParameters
-// Description:		Opens up the Workstation Paremeters file that was
-//					specified by the command line arguement
-//
-///////////////////////////////////////////////////////////////////
-void Thread::setWorkstationParameters(const std::string& f) {
-  std::ostringstream reading;
-  reading << "Reading Workstation Parameters from " << f << " file.";
-  threadZero->recordEvent(reading.str(), false, 0);
-
-#ifndef NO_ALLEGRO
-  strcpy(wkstFile, f);
-#endif
-
-  try {
-    std::ifstream inFile(f);
-
-    if (!inFile.is_open()) {
-      std::cerr << "Error opening workstation file: " << f << std::endl;
-      exit(ERROR_WORKSTATION_FILE);
-    }
-
-    std::string line;
-
-    if (!std::getline(inFile, line)) {
-      std::cerr << "Error reading workstation file: " << f << std::endl;
-      exit(ERROR_WORKSTATION_FILE);
-    }
-
-    std::vector<std::string> tokens = split(line, '=');
-
-    if (tokens.size() != 2) {
-      std::cerr << "Invalid algorithm line: " << line;
-      exit(ERROR_WORKSTATION_FILE);
-    }
-
-    if (tokens[0] == "NumberOfWorkstations")
-      numberOfWorkstations = std::stoi(tokens[1]);
-    else {
-      std::cerr << "ERROR: Invalid line in the input file!!!" << std::endl;
-      exit(ERROR_WORKSTATION_INPUT_QUANTITY);
-    }
-
-    // If workstations are not specified, then just uniformly distribute them
-    // amongst the routers.
-    for (size_t n = workstations.size(); n < numberOfWorkstations; ++n) {
-	  addWorkstation(new Workstation(n % getNumberOfRouters()));
-    }
-
-    inFile.close();
-  } catch (...) {
-    std::cerr << "Error reading/opening workstation file: " << f << std::endl;
-    exit(ERROR_WORKSTATION_FILE);
-  }
-
-  std::ostringstream created;
-  created << "\tCreated " << numberOfWorkstations << " workstations.";
-  threadZero->recordEvent(created.str(), false, 0);
-}
+  for (size_t n = 0; n < numberOfWorkstations; ++n)
+    addWorkstation(new Workstation(network->getParentRouter(n)));
+}
 
 ///////////////////////////////////////////////////////////////////
 //
@@ -2042,8 +2323,26 @@ void Thread::setAlgorithmParameters(const std::string& f, size_t iterationCount)
           ap->ps = CurrentProbeStyle;
           ap->qa = CurrentQualityAware;
           ap->workstations = (i + 1) * iterationWorkstationDelta;
-
-          algParams.push_back(ap);
+          ap->replication = 0;
+          ap->replications = nullptr;
+
+          if (qualityParams.max_replications > 1) {
+            // The first replications are started together, the rest are
+            // added one at a time until the blocking has converged.
+            ReplicationSet* set = new ReplicationSet(
+                *ap, qualityParams.min_replications,
+                qualityParams.max_replications, qualityParams.ci_half_width);
+
+            delete ap;
+
+            for (size_t r = 0;
+                 r < std::min(qualityParams.min_replications,
+                              qualityParams.max_replications);
+                 ++r)
+              scheduler.addJob(set->createReplication(), 0);
+          } else {
+            scheduler.addJob(ap, 0);
+          }
         }
       }
     }
@@ -2065,7 +2364,7 @@ void Thread::update_link_usage() {
 
   time(&start);
 
-  if (getGlobalTime() >= TEN_HOURS) {
+  if (getGlobalTime() >= stopTime) {
     return;
   }
 
@@ -2073,16 +2372,16 @@ void Thread::update_link_usage() {
     getRouterAt(r)->updateUsage();
   }
 
-  Event* event = new Event();
+  usagePaths->invalidate();
 
-  event->e_type = UPDATE_USAGE;
-  event->e_time =
-      getGlobalTime() + threadZero->getQualityParams().usage_update_interval;
-  event->e_data = nullptr;
+  Event event;
 
-  queue->addEvent(*event);
+  event.e_type = UPDATE_USAGE;
+  event.e_time =
+      getGlobalTime() + threadZero->getQualityParams().usage_update_interval;
+  event.e_data.request = nullptr;
 
-  delete event;
+  queue->addEvent(event);
 
   time(&end);
   stats.raRunTime += difftime(end, start);
@@ -2322,7 +2621,7 @@ void Thread::sendProbes(ConnectionRequestEvent* cre, kShortestPathReturn* kPath,
         }
       }
 
-      CreateConnectionProbeEvent* probe = new CreateConnectionProbeEvent();
+      CreateConnectionProbeEvent* probe = pool->acquireProbe();
 
       probe->sourceRouterIndex = cre->sourceRouterIndex;
       probe->destinationRouterIndex = cre->destinationRouterIndex;
@@ -2401,17 +2700,7 @@ void Thread::sendProbes(ConnectionRequestEvent* cre, kShortestPathReturn* kPath,
         kPath->pathlen[p] = std::numeric_limits<int>::infinity();
       }
 
-      Event* event = new Event();
-
-      event->e_type = CREATE_CONNECTION_PROBE;
-      event->e_time =
-          getGlobalTime() +
-          calculateDelay(probe->connectionPath[0]->getNumberOfSpans());
-      event->e_data = probe;
-
-      queue->addEvent(*event);
-
-      delete event;
+      forwardProbe(probe);
 
       if (CurrentRoutingAlgorithm != IMPAIRMENT_AWARE &&
           CurrentRoutingAlgorithm != DYNAMIC_PROGRAMMING) {
@@ -2420,9 +2709,10 @@ void Thread::sendProbes(ConnectionRequestEvent* cre, kShortestPathReturn* kPath,
     }
   }
 
-  if ((CurrentProbeStyle != SERIAL &&
-       CurrentRoutingAlgorithm != SHORTEST_PATH) ||
-      probesToSend == 0) {
+  // The shortest paths belong to the PathCache of the sweep, which is shared
+  // by all of the threads, so they are never freed here.
+  if (CurrentRoutingAlgorithm != SHORTEST_PATH &&
+      (CurrentProbeStyle != SERIAL || probesToSend == 0)) {
     delete[] kPath->pathcost;
     delete[] kPath->pathinfo;
     delete[] kPath->pathlen;
@@ -2431,6 +2721,602 @@ void Thread::sendProbes(ConnectionRequestEvent* cre, kShortestPathReturn* kPath,
   }
 }
 
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	forwardProbe
+// Description:		Schedules the arrival of the probe at the next
+//					router on its path. The intermediate routers make
+//					no decision on the probe, so in fast forward mode
+//					it is scheduled straight at the last router
+//					instead, at the same time it would have arrived.
+//
+///////////////////////////////////////////////////////////////////
+void Thread::forwardProbe(CreateConnectionProbeEvent* ccpe) {
+  Event event;
+
+  event.e_type = CREATE_CONNECTION_PROBE;
+  event.e_time =
+      getGlobalTime() +
+      calculateDelay(
+          ccpe->connectionPath[ccpe->numberOfHops]->getNumberOfSpans());
+  event.e_data.probe = ccpe;
+
+  if (threadZero->getQualityParams().hop_fast_forward == true) {
+    while (ccpe->numberOfHops < ccpe->connectionLength - 1) {
+      ++ccpe->numberOfHops;
+
+      event.e_time += calculateDelay(
+          ccpe->connectionPath[ccpe->numberOfHops]->getNumberOfSpans());
+    }
+  }
+
+  scheduleEvent(event);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	forwardTeardown
+// Description:		Schedules the release of the next link on the
+//					path of the connection. In fast forward mode the
+//					release times of all of the remaining links are
+//					computed at once and put on the teardown lane.
+//
+///////////////////////////////////////////////////////////////////
+void Thread::forwardTeardown(DestroyConnectionProbeEvent* dcpe) {
+  Event event;
+
+  event.e_type = DESTROY_CONNECTION_PROBE;
+  event.e_time =
+      getGlobalTime() +
+      calculateDelay(
+          dcpe->connectionPath[dcpe->numberOfHops]->getNumberOfSpans());
+  event.e_data.destroy = dcpe;
+
+  if (threadZero->getQualityParams().hop_fast_forward == true) {
+    EventQueue::setOrderKey(event);
+
+    for (size_t h = dcpe->numberOfHops; h < dcpe->connectionLength; ++h) {
+      if (h > dcpe->numberOfHops)
+        event.e_time +=
+            calculateDelay(dcpe->connectionPath[h]->getNumberOfSpans());
+
+      teardownLane.push(event);
+    }
+  } else {
+    scheduleEvent(event);
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	scheduleEvent
+// Description:		Adds the event to the immediate lane if it is
+//					for the current time, otherwise adds it to the
+//					event queue. The lane is kept in the order of
+//					the event queue, almost every event goes at the
+//					back of it.
+//
+///////////////////////////////////////////////////////////////////
+void Thread::scheduleEvent(const Event& e) {
+  if (e.e_type == CREATE_CONNECTION_PROBE ||
+      e.e_type == CREATE_CONNECTION_CONFIRMATION ||
+      e.e_type == COLLISION_NOTIFICATION)
+    ++transientEvents;
+
+  if (e.e_time == getGlobalTime()) {
+    Event event = e;
+
+    EventQueue::setOrderKey(event);
+
+    std::deque<Event>::iterator pos = immediateLane.end();
+
+    while (pos != immediateLane.begin() && *(pos - 1) < event) --pos;
+
+    immediateLane.insert(pos, event);
+  } else {
+    queue->addEvent(e);
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	calculateUtilisation
+// Description:		Returns the fraction of the wavelengths on all of
+//					the links that are currently in use.
+//
+///////////////////////////////////////////////////////////////////
+double Thread::calculateUtilisation() const {
+  size_t used = 0;
+  size_t total = 0;
+
+  for (size_t r = 0; r < getNumberOfRouters(); ++r) {
+    Router* router = getRouterAt(r);
+
+    for (size_t e = 0; e < router->getNumberOfEdges(); ++e) {
+      Edge* edge = router->getEdgeByIndex(e);
+
+      for (size_t k = 0; k < threadZero->getNumberOfWavelengths(); ++k) {
+        if (edge->getStatus(k) != EDGE_FREE) ++used;
+      }
+
+      total += threadZero->getNumberOfWavelengths();
+    }
+  }
+
+  return double(used) / double(total);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getCheckpointFile
+// Description:		Returns the name of the checkpoint file of the
+//					current run.
+//
+///////////////////////////////////////////////////////////////////
+std::string Thread::getCheckpointFile() const {
+  std::ostringstream buffer;
+  buffer << "output/Checkpoint-" << getTopology() << "-"
+         << getNumberOfWavelengths() << "-" << randomSeed << "-"
+         << threadZero->getRoutingAlgorithmName(CurrentRoutingAlgorithm) << "-"
+         << threadZero->getWavelengthAlgorithmName(CurrentWavelengthAlgorithm)
+         << "-" << threadZero->getProbeStyleName(CurrentProbeStyle) << "-"
+         << CurrentQualityAware << "-" << CurrentActiveWorkstations;
+
+  if (currentReplications != nullptr) buffer << "-" << currentReplication;
+
+  buffer << ".bin";
+
+  return buffer.str();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getTraceFile
+// Description:		Returns the name of the request trace file of the
+//					current run.
+//
+///////////////////////////////////////////////////////////////////
+std::string Thread::getTraceFile() const {
+  std::ostringstream buffer;
+  buffer << "output/Trace-" << getTopology() << "-" << CurrentActiveWorkstations
+         << "-" << randomSeed;
+
+  if (currentReplications != nullptr) buffer << "-" << currentReplication;
+
+  buffer << ".bin";
+
+  return buffer.str();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	getCheckpointConfig
+// Description:		Returns the settings that a checkpoint must have
+//					been taken with for it to be restored.
+//
+///////////////////////////////////////////////////////////////////
+std::vector<size_t> Thread::getCheckpointConfig() const {
+  std::vector<size_t> config;
+
+  config.push_back(getNumberOfRouters());
+  config.push_back(getNumberOfWavelengths());
+  config.push_back(getNumberOfWorkstations());
+  config.push_back(randomSeed);
+  config.push_back(CurrentRoutingAlgorithm);
+  config.push_back(CurrentWavelengthAlgorithm);
+  config.push_back(CurrentProbeStyle);
+  config.push_back(CurrentQualityAware);
+  config.push_back(CurrentActiveWorkstations);
+  config.push_back(currentReplication);
+  config.push_back(threadZero->getQualityParams().max_probes);
+  config.push_back(convergence != nullptr);
+  config.push_back(warmup != nullptr);
+  config.push_back(trace != nullptr);
+
+  return config;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	saveCheckpoint
+// Description:		Writes the complete state of the run to its
+//					checkpoint file. The file is written under a
+//					temporary name first, so that a crash while it
+//					is written leaves the previous one intact.
+//
+///////////////////////////////////////////////////////////////////
+void Thread::saveCheckpoint() {
+  std::vector<Event> events;
+
+  while (queue->getSize() > 0) events.push_back(queue->getNextEvent());
+
+  std::string file = getCheckpointFile();
+  std::string temp = file + ".tmp";
+
+  CheckpointWriter out(temp);
+
+  std::vector<size_t> config = getCheckpointConfig();
+
+  out.writeString(getTopology());
+  out.write(config.size());
+  out.writeArray(&config[0], config.size());
+
+  out.write(globalTime);
+  out.write(stopTime);
+  out.write(stats);
+
+  std::ostringstream engine;
+  engine << generator;
+  out.writeString(engine.str());
+
+  out.write(order_init);
+  out.writeArray(workstationOrder, getNumberOfWorkstations());
+
+  if (trace != nullptr) out.writeArray(&traceCursor[0], traceCursor.size());
+
+  for (size_t w = 0; w < getNumberOfWorkstations(); ++w)
+    out.write(getWorkstationAt(w)->getActive());
+
+  for (size_t r = 0; r < getNumberOfRouters(); ++r)
+    getRouterAt(r)->saveCheckpoint(out);
+
+  if (convergence != nullptr) convergence->saveCheckpoint(out);
+  if (warmup != nullptr) warmup->saveCheckpoint(out);
+
+  // The connection paths are shared by a teardown and its established
+  // connection, so the connections refer to their teardown by index.
+  std::map<Edge**, size_t> teardowns;
+
+  out.write(events.size());
+
+  for (size_t i = 0; i < events.size(); ++i) {
+    const Event& event = events[i];
+
+    out.write(static_cast<EventType>(event.e_type));
+    out.write(event.e_time);
+
+    if (event.e_type == CONNECTION_REQUEST) {
+      out.write(*event.e_data.request);
+    } else if (event.e_type == DESTROY_CONNECTION_PROBE) {
+      DestroyConnectionProbeEvent* dcpe = event.e_data.destroy;
+
+      out.write(dcpe->connectionLength);
+      out.write(dcpe->numberOfHops);
+      out.write(dcpe->session);
+      out.write(dcpe->sequence);
+      out.write(dcpe->wavelength);
+
+      for (size_t p = 0; p < dcpe->connectionLength; ++p) {
+        out.write(dcpe->connectionPath[p]->getSourceIndex());
+        out.write(dcpe->connectionPath[p]->getDestinationIndex());
+      }
+
+      // Only the number of parallel probes is needed, the probes themselves
+      // are only released once the teardown has completed.
+      long long int probes = 0;
+
+      if (CurrentProbeStyle == PARALLEL)
+        probes = dcpe->probes[dcpe->sequence]->max_sequence;
+
+      out.write(probes);
+
+      teardowns[dcpe->connectionPath] = i;
+    }
+  }
+
+  std::map<const void*, size_t> connectionIndex;
+  std::vector<const EstablishedConnection*> connections;
+
+  for (size_t r = 0; r < getNumberOfRouters(); ++r) {
+    for (size_t e = 0; e < getRouterAt(r)->getNumberOfEdges(); ++e) {
+      const std::list<void*>& ecs =
+          getRouterAt(r)->getEdgeByIndex(e)->getEstablishedConnections();
+
+      for (std::list<void*>::const_iterator iter = ecs.begin();
+           iter != ecs.end(); ++iter) {
+        if (connectionIndex.find(*iter) == connectionIndex.end()) {
+          connectionIndex[*iter] = connections.size();
+          connections.push_back(
+              static_cast<const EstablishedConnection*>(*iter));
+        }
+      }
+    }
+  }
+
+  out.write(connections.size());
+
+  for (size_t c = 0; c < connections.size(); ++c) {
+    const EstablishedConnection* ec = connections[c];
+
+    std::map<Edge**, size_t>::const_iterator teardown =
+        teardowns.find(ec->connectionPath);
+
+    if (teardown == teardowns.end()) {
+      threadZero->recordEvent(
+          "ERROR: Established connection without a teardown event.", true,
+          controllerIndex);
+      exit(ERROR_CHECKPOINT);
+    }
+
+    out.write(teardown->second);
+    out.write(ec->wavelength);
+    out.write(ec->connectionStartTime);
+    out.write(ec->connectionEndTime);
+    out.write(ec->initQFactor);
+    out.write(ec->belowQFactor);
+    out.write(ec->averageQFactor);
+
+    bool history = (ec->QFactors != nullptr);
+    out.write(history);
+
+    if (history == true) {
+      out.writeVector(*ec->QFactors);
+      out.writeVector(*ec->QTimes);
+    }
+  }
+
+  for (size_t r = 0; r < getNumberOfRouters(); ++r) {
+    for (size_t e = 0; e < getRouterAt(r)->getNumberOfEdges(); ++e) {
+      const std::list<void*>& ecs =
+          getRouterAt(r)->getEdgeByIndex(e)->getEstablishedConnections();
+
+      out.write(ecs.size());
+
+      for (std::list<void*>::const_iterator iter = ecs.begin();
+           iter != ecs.end(); ++iter)
+        out.write(connectionIndex[*iter]);
+    }
+  }
+
+  bool written = out.isGood();
+  out.close();
+
+  for (size_t i = 0; i < events.size(); ++i) queue->addEvent(events[i]);
+
+  std::ostringstream buffer;
+
+  // A failed checkpoint does not stop the run, it only means that it can not
+  // be resumed from this point.
+  if (written == false || std::rename(temp.c_str(), file.c_str()) != 0) {
+    buffer << "Unable to write the checkpoint file " << file << ".";
+    threadZero->recordEvent(buffer.str(), true, controllerIndex);
+  } else {
+    buffer << "Saved checkpoint at time " << getGlobalTime() << " to " << file;
+    threadZero->recordEvent(buffer.str(), false, controllerIndex);
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	restoreCheckpoint
+// Description:		Replaces the state of the run with the one in its
+//					checkpoint file. Returns false, leaving the run
+//					untouched, if there is no usable checkpoint.
+//
+///////////////////////////////////////////////////////////////////
+bool Thread::restoreCheckpoint() {
+  std::string file = getCheckpointFile();
+
+  CheckpointReader in(file);
+
+  if (in.isGood() == false) return false;
+
+  std::vector<size_t> config = getCheckpointConfig();
+  std::vector<size_t> saved;
+
+  bool valid = in.checkHeader();
+
+  if (valid == true) valid = (in.readString() == getTopology());
+
+  if (valid == true) {
+    size_t count = 0;
+    in.read(count);
+
+    if (in.isGood() == true && count == config.size()) {
+      saved.resize(count);
+      in.readArray(&saved[0], count);
+    }
+
+    valid = (in.isGood() == true && saved == config);
+  }
+
+  if (valid == false) {
+    std::ostringstream buffer;
+    buffer << "The checkpoint file " << file
+           << " does not match this run, starting from the beginning.";
+    threadZero->recordEvent(buffer.str(), true, controllerIndex);
+    return false;
+  }
+
+  // The queue only holds the events of initPriorityQueue at this point,
+  // none of which have a payload.
+  while (queue->getSize() > 0) queue->getNextEvent();
+
+  in.read(globalTime);
+  in.read(stopTime);
+  in.read(stats);
+
+  std::istringstream engine(in.readString());
+  engine >> generator;
+
+  in.read(order_init);
+  in.readArray(workstationOrder, getNumberOfWorkstations());
+
+  if (trace != nullptr) {
+    traceCursor.assign(getNumberOfWorkstations(), 0);
+    in.readArray(&traceCursor[0], traceCursor.size());
+  }
+
+  for (size_t w = 0; w < getNumberOfWorkstations(); ++w) {
+    bool active = false;
+    in.read(active);
+    getWorkstationAt(w)->setActive(active);
+#ifndef NO_ALLEGRO
+    if (active == true)
+      getRouterAt(getWorkstationAt(w)->getParentRouterIndex())
+          ->incNumWorkstations();
+#endif
+  }
+
+  for (size_t r = 0; r < getNumberOfRouters(); ++r)
+    getRouterAt(r)->loadCheckpoint(in);
+
+  // The restore takes the place of activate_workstations, so the paths that
+  // the previous run of this thread cached for its usage are dropped too.
+  usagePaths->invalidate();
+
+  if (convergence != nullptr) convergence->loadCheckpoint(in);
+  if (warmup != nullptr) warmup->loadCheckpoint(in);
+
+  size_t eventCount = 0;
+  in.read(eventCount);
+
+  if (in.isGood() == false) eventCount = 0;
+
+  std::vector<Event> events(eventCount);
+  std::vector<DestroyConnectionProbeEvent*> teardowns(eventCount, nullptr);
+
+  for (size_t i = 0; i < eventCount && in.isGood() == true; ++i) {
+    Event& event = events[i];
+
+    EventType type = NUMBER_OF_EVENTS;
+
+    in.read(type);
+    in.read(event.e_time);
+
+    event.e_type = type;
+    event.e_data.request = nullptr;
+
+    if (event.e_type == CONNECTION_REQUEST) {
+      event.e_data.request = pool->acquireRequest();
+      in.read(*event.e_data.request);
+    } else if (event.e_type == DESTROY_CONNECTION_PROBE) {
+      DestroyConnectionProbeEvent* dcpe = pool->acquireDestroy();
+      event.e_data.destroy = dcpe;
+      teardowns[i] = dcpe;
+
+      in.read(dcpe->connectionLength);
+      in.read(dcpe->numberOfHops);
+      in.read(dcpe->session);
+      in.read(dcpe->sequence);
+      in.read(dcpe->wavelength);
+
+      dcpe->connectionPath = new Edge*[dcpe->connectionLength];
+
+      for (size_t p = 0; p < dcpe->connectionLength; ++p) {
+        size_t src = 0;
+        size_t dest = 0;
+
+        in.read(src);
+        in.read(dest);
+
+        dcpe->connectionPath[p] = getRouterAt(src)->getEdgeByDestination(dest);
+      }
+
+      long long int probes = 0;
+      in.read(probes);
+
+      dcpe->probes = nullptr;
+
+      if (probes > 0) {
+        dcpe->probes = new CreateConnectionProbeEvent*[probes];
+
+        for (long long int p = 0; p < probes; ++p) {
+          CreateConnectionProbeEvent* probe = pool->acquireProbe();
+
+          probe->connectionPath = nullptr;
+          probe->max_sequence = probes;
+          probe->sequence = p;
+          probe->probes = dcpe->probes;
+
+          dcpe->probes[p] = probe;
+        }
+      }
+    }
+  }
+
+  size_t connectionCount = 0;
+  in.read(connectionCount);
+
+  if (in.isGood() == false) connectionCount = 0;
+
+  std::vector<EstablishedConnection*> connections(connectionCount, nullptr);
+
+  for (size_t c = 0; c < connectionCount && in.isGood() == true; ++c) {
+    size_t teardown = 0;
+    in.read(teardown);
+
+    if (teardown >= eventCount || teardowns[teardown] == nullptr) break;
+
+    EstablishedConnection* ec = new EstablishedConnection();
+
+    ec->connectionPath = teardowns[teardown]->connectionPath;
+    ec->connectionLength = teardowns[teardown]->connectionLength;
+
+    in.read(ec->wavelength);
+    in.read(ec->connectionStartTime);
+    in.read(ec->connectionEndTime);
+    in.read(ec->initQFactor);
+    in.read(ec->belowQFactor);
+    in.read(ec->averageQFactor);
+
+    bool history = false;
+    in.read(history);
+
+    if (history == true) {
+      ec->QFactors = new std::vector<double>;
+      ec->QTimes = new std::vector<double>;
+
+      in.readVector(*ec->QFactors);
+      in.readVector(*ec->QTimes);
+    }
+
+    connections[c] = ec;
+  }
+
+  for (size_t r = 0; r < getNumberOfRouters() && in.isGood() == true; ++r) {
+    for (size_t e = 0; e < getRouterAt(r)->getNumberOfEdges(); ++e) {
+      size_t count = 0;
+      in.read(count);
+
+      for (size_t k = 0; k < count && in.isGood() == true; ++k) {
+        size_t c = 0;
+        in.read(c);
+
+        if (c >= connectionCount || connections[c] == nullptr) break;
+
+        getRouterAt(r)->getEdgeByIndex(e)->insertEstablishedConnection(
+            connections[c]);
+      }
+    }
+  }
+
+  // Part of the state has already been replaced, so there is no going back
+  // to the start of the run at this point.
+  if (in.isGood() == false) {
+    std::ostringstream buffer;
+    buffer << "ERROR: The checkpoint file " << file << " is truncated.";
+    threadZero->recordEvent(buffer.str(), true, controllerIndex);
+    exit(ERROR_CHECKPOINT);
+  }
+
+  for (size_t i = 0; i < eventCount; ++i) queue->addEvent(events[i]);
+
+  pool->resetStats();
+
+#ifdef PROFILE_EVENTS
+  profiler.reset(getGlobalTime());
+#endif
+
+  prepareRun();
+
+  std::ostringstream buffer;
+  buffer << "RESTORED CHECKPOINT AT TIME = " << getGlobalTime();
+  threadZero->recordEvent(buffer.str(), true, controllerIndex);
+
+  return true;
+}
+
 #ifndef NO_ALLEGRO
 ///////////////////////////////////////////////////////////////////
 //
@@ -2439,7 +3325,7 @@ void Thread::sendProbes(ConnectionRequestEvent* cre, kShortestPathReturn* kPath,
 //
 ///////////////////////////////////////////////////////////////////
 void Thread::update_gui() {
-  if (getGlobalTime() >= TEN_HOURS) {
+  if (getGlobalTime() >= stopTime) {
     return;
   }
 
@@ -2447,16 +3333,14 @@ void Thread::update_gui() {
     getRouterAt(r)->updateGUI();
   }
 
-  Event* event = new Event();
+  Event event;
 
-  event->e_type = UPDATE_GUI;
-  event->e_time =
+  event.e_type = UPDATE_GUI;
+  event.e_time =
       getGlobalTime() + threadZero->getQualityParams().gui_update_interval;
-  event->e_data = nullptr;
-
-  queue->addEvent(*event);
+  event.e_data.request = nullptr;
 
-  delete event;
+  queue->addEvent(event);
 }
 #endif
 
@@ -2511,12 +3395,12 @@ void Thread::clearResponses(CreateConnectionProbeEvent* probe) {
   for (long long int p = 0; p < probe->max_sequence; ++p) {
     if (p != probe->sequence) {
       delete[] probe->probes[p]->connectionPath;
-      delete probe->probes[p];
+      pool->release(probe->probes[p]);
     }
   }
 
   delete[] probe->probes;
-  delete probe;
+  pool->release(probe);
 }
 
 ///////////////////////////////////////////////////////////////////
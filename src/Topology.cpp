@@ -0,0 +1,256 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      Topology.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the Topology.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Static topology shared between the threads.
+//
+// ____________________________________________________________________________
+
+#include "Topology.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "ErrorCodes.h"
+#include "Thread.h"
+
+extern Thread *threadZero;
+
+static std::vector<Topology *> TopologyCache;
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	Topology
+// Description:		Reads in the topology and the workstation files
+//
+///////////////////////////////////////////////////////////////////
+Topology::Topology(const std::string &t, const std::string &w)
+    : topologyFile(t), workstationFile(w), numberOfRouters(0), hash(0) {
+  readTopology(topologyFile);
+  readWorkstations(workstationFile);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	load
+// Description:		Returns the topology of the files, reading them
+//					in if they have not been read before.
+//
+///////////////////////////////////////////////////////////////////
+const Topology *Topology::load(const std::string &t, const std::string &w) {
+  for (size_t c = 0; c < TopologyCache.size(); ++c) {
+    if (TopologyCache[c]->topologyFile == t &&
+        TopologyCache[c]->workstationFile == w)
+      return TopologyCache[c];
+  }
+
+  TopologyCache.push_back(new Topology(t, w));
+
+  return TopologyCache.back();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	clearCache
+// Description:		Deletes all of the topologies
+//
+///////////////////////////////////////////////////////////////////
+void Topology::clearCache() {
+  for (size_t c = 0; c < TopologyCache.size(); ++c) delete TopologyCache[c];
+
+  TopologyCache.clear();
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	readTopology
+// Description:		Reads the routers and edges of the network. Each
+//					edge in the file is added in both directions.
+//
+///////////////////////////////////////////////////////////////////
+void Topology::readTopology(const std::string &f) {
+  std::ostringstream buffer;
+  buffer << "Reading Topology Parameters from " << f << " file.";
+  threadZero->recordEvent(buffer.str(), false, 0);
+
+  std::ifstream inFile(f);
+
+  if (!inFile.is_open()) {
+    std::cerr << "Error opening toplogy file: " << f << std::endl;
+    exit(ERROR_TOPOLOGY_FILE);
+  }
+
+  // The edges of each router, in the order they are listed in the file.
+  std::vector<std::vector<size_t> > destinations;
+  std::vector<std::vector<size_t> > spans;
+
+  std::string line;
+
+  // FNV-1a over the lines of the file.
+  hash = 14695981039346656037ULL;
+
+  while (std::getline(inFile, line)) {
+    for (size_t c = 0; c <= line.size(); ++c) {
+      hash ^= static_cast<unsigned char>(c < line.size() ? line[c] : '\n');
+      hash *= 1099511628211ULL;
+    }
+
+    std::vector<std::string> tokens = Thread::split(line, '=');
+
+    if (tokens.size() != 2) {
+      std::string err = "Invalid line in topology file: " + line;
+      threadZero->recordEvent(err, false, 0);
+      inFile.close();
+      exit(ERROR_TOPOLOGY_FILE);
+    }
+
+    std::string param = tokens[0];
+
+    if (param == "Router") {
+#ifndef NO_ALLEGRO
+      std::vector<std::string> coordinates = Thread::split(tokens[1], ',');
+
+      if (coordinates.size() != 2) {
+        std::string err = "Invalid router line in topology file: " + line;
+        threadZero->recordEvent(err, false, 0);
+        inFile.close();
+        exit(ERROR_TOPOLOGY_INPUT_ROUTERS);
+      }
+
+      xPercent.push_back(std::stoi(coordinates[0]));
+      yPercent.push_back(std::stoi(coordinates[1]));
+#endif
+
+      destinations.push_back(std::vector<size_t>());
+      spans.push_back(std::vector<size_t>());
+
+      ++numberOfRouters;
+    } else if (param == "Edge") {
+      std::vector<std::string> coordinates = Thread::split(tokens[1], ',');
+
+      if (coordinates.size() != 3) {
+        std::string err = "Invalid edge line in topology file: " + line;
+        threadZero->recordEvent(err, false, 0);
+        inFile.close();
+        exit(ERROR_TOPOLOGY_INPUT_EDGES);
+      }
+
+      size_t from = std::stoi(coordinates[0]);
+      size_t to = std::stoi(coordinates[1]);
+      size_t s = std::stoi(coordinates[2]);
+
+      if (from >= numberOfRouters || to >= numberOfRouters) {
+        std::string err = "Invalid edge line in topology file: " + line;
+        threadZero->recordEvent(err, false, 0);
+        inFile.close();
+        exit(ERROR_TOPOLOGY_INPUT_EDGES);
+      }
+
+      destinations[from].push_back(to);
+      spans[from].push_back(s);
+
+      destinations[to].push_back(from);
+      spans[to].push_back(s);
+    } else {
+      threadZero->recordEvent("ERROR: Invalid line in the input file!!!", true,
+                              0);
+      inFile.close();
+      exit(ERROR_TOPOLOGY_FILE);
+    }
+  }
+
+  inFile.close();
+
+  firstEdge.resize(numberOfRouters + 1);
+  adjacency.assign(numberOfRouters * numberOfRouters, -1);
+
+  firstEdge[0] = 0;
+
+  for (size_t r = 0; r < numberOfRouters; ++r) {
+    for (size_t e = 0; e < destinations[r].size(); ++e) {
+      adjacency[r * numberOfRouters + destinations[r][e]] = (long long int)e;
+
+      edgeDestination.push_back(destinations[r][e]);
+      edgeSpans.push_back(spans[r][e]);
+    }
+
+    firstEdge[r + 1] = edgeDestination.size();
+  }
+
+  std::ostringstream routers;
+  routers << "\tCreated " << numberOfRouters << " routers.";
+  threadZero->recordEvent(routers.str(), false, 0);
+
+  std::ostringstream edges;
+  edges << "\tCreated " << getNumberOfEdges() << " edges.";
+  threadZero->recordEvent(edges.str(), false, 0);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	readWorkstations
+// Description:		Reads the number of workstations, which are
+//					spread evenly amongst the routers.
+//
+///////////////////////////////////////////////////////////////////
+void Topology::readWorkstations(const std::string &f) {
+  std::ostringstream reading;
+  reading << "Reading Workstation Parameters from " << f << " file.";
+  threadZero->recordEvent(reading.str(), false, 0);
+
+  size_t numberOfWorkstations = 0;
+
+  try {
+    std::ifstream inFile(f);
+
+    if (!inFile.is_open()) {
+      std::cerr << "Error opening workstation file: " << f << std::endl;
+      exit(ERROR_WORKSTATION_FILE);
+    }
+
+    std::string line;
+
+    if (!std::getline(inFile, line)) {
+      std::cerr << "Error reading workstation file: " << f << std::endl;
+      exit(ERROR_WORKSTATION_FILE);
+    }
+
+    std::vector<std::string> tokens = Thread::split(line, '=');
+
+    if (tokens.size() != 2) {
+      std::cerr << "Invalid algorithm line: " << line;
+      exit(ERROR_WORKSTATION_FILE);
+    }
+
+    if (tokens[0] == "NumberOfWorkstations")
+      numberOfWorkstations = std::stoi(tokens[1]);
+    else {
+      std::cerr << "ERROR: Invalid line in the input file!!!" << std::endl;
+      exit(ERROR_WORKSTATION_INPUT_QUANTITY);
+    }
+
+    inFile.close();
+  } catch (...) {
+    std::cerr << "Error reading/opening workstation file: " << f << std::endl;
+    exit(ERROR_WORKSTATION_FILE);
+  }
+
+  // If workstations are not specified, then just uniformly distribute them
+  // amongst the routers.
+  for (size_t n = 0; n < numberOfWorkstations; ++n)
+    parentRouter.push_back(n % numberOfRouters);
+
+  std::ostringstream created;
+  created << "\tCreated " << numberOfWorkstations << " workstations.";
+  threadZero->recordEvent(created.str(), false, 0);
+}
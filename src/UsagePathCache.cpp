@@ -0,0 +1,204 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      UsagePathCache.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the
+//					UsagePathCache.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    LORA and PABR paths cached between usage updates.
+//  10/18/2026  v2.1    Searches kept to be continued for a larger k.
+//
+// ____________________________________________________________________________
+
+#include "UsagePathCache.h"
+
+#include <limits>
+
+extern "C" void delete_k_shortest_paths(KShortestPaths* search);
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	UsagePathCache
+// Description:		Creates an empty cache for the given number of
+//					routers.
+//
+///////////////////////////////////////////////////////////////////
+UsagePathCache::UsagePathCache(size_t r)
+    : routers(r), epoch(1), pairs(r * r) {
+  for (size_t p = 0; p < pairs.size(); ++p) {
+    pairs[p].epoch = 0;
+    pairs[p].search = nullptr;
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	~UsagePathCache
+// Description:		Deletes all of the cached paths and searches
+//
+///////////////////////////////////////////////////////////////////
+UsagePathCache::~UsagePathCache() {
+  for (size_t p = 0; p < pairs.size(); ++p) {
+    for (size_t e = 0; e < pairs[p].entries.size(); ++e)
+      deletePaths(pairs[p].entries[e].paths);
+
+    if (pairs[p].search != nullptr) delete_k_shortest_paths(pairs[p].search);
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	find
+// Description:		Returns a copy of the cached paths, if there are
+//					any for the current epoch. The paths of a larger
+//					k are used as well, as the k shortest paths are
+//					the first k paths of any larger search. They are
+//					only used when that search found all of its
+//					paths, otherwise a path that was dropped for
+//					being too long may have been replaced by one
+//					that a search for k paths would not have found.
+//
+///////////////////////////////////////////////////////////////////
+kShortestPathReturn *UsagePathCache::find(size_t src, size_t dest,
+                                          size_t k) const {
+  const Pair &pair = pairs[src * routers + dest];
+
+  if (pair.epoch != epoch) return nullptr;
+
+  for (size_t e = 0; e < pair.entries.size(); ++e) {
+    const Entry &entry = pair.entries[e];
+
+    if (entry.k == k || (entry.k > k && entry.found == entry.k))
+      return copyPaths(entry.paths, k);
+  }
+
+  return nullptr;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	insert
+// Description:		Keeps a copy of the paths, the paths of an
+//					earlier epoch are deleted first.
+//
+///////////////////////////////////////////////////////////////////
+void UsagePathCache::insert(size_t src, size_t dest, size_t k,
+                            const kShortestPathReturn *paths) {
+  Pair &pair = pairs[src * routers + dest];
+
+  renew(pair);
+
+  Entry entry;
+  entry.k = k;
+  entry.found = 0;
+  entry.paths = copyPaths(paths, k);
+
+  while (entry.found < k && paths->pathcost[entry.found] !=
+                                std::numeric_limits<double>::infinity())
+    ++entry.found;
+
+  pair.entries.push_back(entry);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	findSearch
+// Description:		Returns the search of the pair, if it was
+//					started in the current epoch.
+//
+///////////////////////////////////////////////////////////////////
+KShortestPaths *UsagePathCache::findSearch(size_t src, size_t dest) const {
+  const Pair &pair = pairs[src * routers + dest];
+
+  if (pair.epoch != epoch) return nullptr;
+
+  return pair.search;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	insertSearch
+// Description:		Keeps the search of the pair, replacing the
+//					one of an earlier epoch.
+//
+///////////////////////////////////////////////////////////////////
+void UsagePathCache::insertSearch(size_t src, size_t dest,
+                                  KShortestPaths *search) {
+  Pair &pair = pairs[src * routers + dest];
+
+  renew(pair);
+
+  if (pair.search != nullptr) delete_k_shortest_paths(pair.search);
+
+  pair.search = search;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	renew
+// Description:		Deletes the paths and the search of a pair
+//					that were found in an earlier epoch.
+//
+///////////////////////////////////////////////////////////////////
+void UsagePathCache::renew(Pair &pair) {
+  if (pair.epoch == epoch) return;
+
+  for (size_t e = 0; e < pair.entries.size(); ++e)
+    deletePaths(pair.entries[e].paths);
+
+  pair.entries.clear();
+
+  if (pair.search != nullptr) {
+    delete_k_shortest_paths(pair.search);
+    pair.search = nullptr;
+  }
+
+  pair.epoch = epoch;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	copyPaths
+// Description:		Copies the first k of the paths
+//
+///////////////////////////////////////////////////////////////////
+kShortestPathReturn *UsagePathCache::copyPaths(
+    const kShortestPathReturn *paths, size_t k) const {
+  kShortestPathReturn *copy = new kShortestPathReturn();
+
+  copy->pathinfo = new size_t[k * (routers - 1)];
+  copy->pathcost = new double[k];
+  copy->pathlen = new size_t[k];
+
+  for (size_t p = 0; p < k; ++p) {
+    copy->pathcost[p] = paths->pathcost[p];
+    copy->pathlen[p] = paths->pathlen[p];
+
+    for (size_t r = 0; r < paths->pathlen[p]; ++r)
+      copy->pathinfo[p * (routers - 1) + r] =
+          paths->pathinfo[p * (routers - 1) + r];
+  }
+
+  return copy;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	deletePaths
+// Description:		Frees the memory of a set of paths
+//
+///////////////////////////////////////////////////////////////////
+void UsagePathCache::deletePaths(kShortestPathReturn *paths) {
+  delete[] paths->pathcost;
+  delete[] paths->pathinfo;
+  delete[] paths->pathlen;
+
+  delete paths;
+}
@@ -0,0 +1,214 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      WarmupDetector.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the
+//					WarmupDetector.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    MSER-5 detection of the warm-up of a run.
+//
+// ____________________________________________________________________________
+
+#include "WarmupDetector.h"
+
+#include <limits>
+
+const size_t WarmupDetector::BATCH = 5;
+const size_t WarmupDetector::MIN_BATCHES = 10;
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	WarmupDetector
+// Description:		Creates a detector that samples the run every
+//					sampleInterval connection requests.
+//
+///////////////////////////////////////////////////////////////////
+WarmupDetector::WarmupDetector(size_t s)
+    : sampleInterval(s), complete(false), truncation(0) {}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	reset
+// Description:		Clears all of the samples for the start of a
+//					new run.
+//
+///////////////////////////////////////////////////////////////////
+void WarmupDetector::reset(const GlobalStats &stats, double time) {
+  complete = false;
+  truncation = 0;
+
+  snapshots.clear();
+  times.clear();
+  blocking.clear();
+  utilisation.clear();
+
+  snapshots.push_back(stats);
+  times.push_back(time);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	sample
+// Description:		Adds a sample and checks whether the truncation
+//					point has settled in the first half of the
+//					samples, in which case the warm-up is over.
+//
+///////////////////////////////////////////////////////////////////
+bool WarmupDetector::sample(const GlobalStats &stats, double u, double time) {
+  const GlobalStats &last = snapshots.back();
+
+  size_t failures =
+      stats.CollisionFailures + stats.QualityFailures + stats.NoPathFailures;
+  size_t lastFailures =
+      last.CollisionFailures + last.QualityFailures + last.NoPathFailures;
+
+  blocking.push_back(double(failures - lastFailures) /
+                     double(stats.ConnectionRequests - last.ConnectionRequests));
+  utilisation.push_back(u);
+
+  snapshots.push_back(stats);
+  times.push_back(time);
+
+  size_t batches = blocking.size() / BATCH;
+
+  if (blocking.size() % BATCH != 0 || batches < MIN_BATCHES) return false;
+
+  size_t d = truncationPoint(blocking);
+  size_t du = truncationPoint(utilisation);
+
+  if (du > d) d = du;
+
+  // A truncation point in the second half means that the run has not been
+  // long enough to tell the transient from the steady state.
+  if (d > batches / 2) return false;
+
+  complete = true;
+  truncation = d * BATCH;
+
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	removeTransient
+// Description:		Subtracts the totals at the truncation point,
+//					so that only the steady state is counted.
+//
+///////////////////////////////////////////////////////////////////
+void WarmupDetector::removeTransient(GlobalStats &stats) const {
+  const GlobalStats &t = snapshots[truncation];
+
+  // The requests that were still being set up at the truncation point are
+  // kept, as their outcome is counted after it.
+  stats.ConnectionRequests -= getDeletedRequests();
+  stats.ConnectionSuccesses -= t.ConnectionSuccesses;
+  stats.CollisionFailures -= t.CollisionFailures;
+  stats.QualityFailures -= t.QualityFailures;
+  stats.NoPathFailures -= t.NoPathFailures;
+  stats.DroppedFailures -= t.DroppedFailures;
+  stats.ProbeSentCount -= t.ProbeSentCount;
+  stats.totalHopCount -= t.totalHopCount;
+  stats.totalSpanCount -= t.totalSpanCount;
+  stats.aseNoiseTotal -= t.aseNoiseTotal;
+  stats.xpmNoiseTotal -= t.xpmNoiseTotal;
+  stats.fwmNoiseTotal -= t.fwmNoiseTotal;
+  stats.qFactorTotal -= t.qFactorTotal;
+  stats.totalSetupDelay -= t.totalSetupDelay;
+  stats.raRunTime -= t.raRunTime;
+  stats.candidateSearches -= t.candidateSearches;
+  stats.candidateFallbacks -= t.candidateFallbacks;
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	saveCheckpoint
+// Description:		Writes the samples and snapshots to a checkpoint
+//
+///////////////////////////////////////////////////////////////////
+void WarmupDetector::saveCheckpoint(CheckpointWriter &out) const {
+  out.write(complete);
+  out.write(truncation);
+
+  out.write(snapshots.size());
+  out.writeArray(&snapshots[0], snapshots.size());
+
+  out.writeVector(times);
+  out.writeVector(blocking);
+  out.writeVector(utilisation);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	loadCheckpoint
+// Description:		Reads the samples and snapshots from a checkpoint
+//
+///////////////////////////////////////////////////////////////////
+void WarmupDetector::loadCheckpoint(CheckpointReader &in) {
+  size_t count = 0;
+
+  in.read(complete);
+  in.read(truncation);
+
+  in.read(count);
+  snapshots.resize(count);
+  in.readArray(&snapshots[0], count);
+
+  in.readVector(times);
+  in.readVector(blocking);
+  in.readVector(utilisation);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	truncationPoint
+// Description:		Returns the number of batches of five samples
+//					that minimises the MSER statistic when deleted.
+//
+///////////////////////////////////////////////////////////////////
+size_t WarmupDetector::truncationPoint(const std::vector<double> &samples) {
+  size_t batches = samples.size() / BATCH;
+
+  std::vector<double> means(batches, 0.0);
+
+  for (size_t b = 0; b < batches; ++b) {
+    for (size_t s = 0; s < BATCH; ++s) means[b] += samples[b * BATCH + s];
+
+    means[b] /= double(BATCH);
+  }
+
+  // The sums are built from the back, so that the statistic for every
+  // truncation point is found in a single pass.
+  double sum = 0.0;
+  double squares = 0.0;
+
+  double best = std::numeric_limits<double>::infinity();
+  size_t bestPoint = 0;
+
+  for (size_t d = batches; d-- > 0;) {
+    sum += means[d];
+    squares += means[d] * means[d];
+
+    size_t n = batches - d;
+
+    if (n < 2) continue;
+
+    double deviations = squares - sum * sum / double(n);
+    double mser = deviations / (double(n) * double(n));
+
+    // Ties are resolved towards the earlier point, so that no more of the
+    // run is deleted than is needed.
+    if (mser <= best) {
+      best = mser;
+      bestPoint = d;
+    }
+  }
+
+  return bestPoint;
+}
@@ -0,0 +1,175 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      WorkerPool.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The file contains the implementation of the WorkerPool.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Workers sharing the work of a single run.
+//
+// ____________________________________________________________________________
+
+#include "WorkerPool.h"
+
+#include <sstream>
+
+#include "CpuAffinity.h"
+#include "ErrorCodes.h"
+#include "Thread.h"
+
+extern Thread *threadZero;
+extern CpuAffinity affinity;
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	WorkerPool
+// Description:		Starts the requested number of workers, less one
+//					as the calling thread also does its share of
+//					the work.
+//
+///////////////////////////////////////////////////////////////////
+WorkerPool::WorkerPool(size_t w, size_t s)
+    : firstSlot(s),
+      task(nullptr),
+      arg(nullptr),
+      count(0),
+      generation(0),
+      pending(0),
+      shutdown(false) {
+  pthread_mutex_init(&mutex, nullptr);
+  pthread_cond_init(&start, nullptr);
+  pthread_cond_init(&done, nullptr);
+
+  if (w > 1) {
+    workers.resize(w - 1);
+    workerArgs.resize(w - 1);
+  }
+
+  for (size_t t = 0; t < workers.size(); ++t) {
+    workerArgs[t].pool = this;
+    workerArgs[t].id = t + 1;
+
+    int ret_code =
+        pthread_create(&workers[t], nullptr, workerMain, &workerArgs[t]);
+
+    if (ret_code != 0) {
+      std::ostringstream buffer;
+      buffer << "ERROR: Worker creation failed with code: " << ret_code;
+      threadZero->recordEvent(buffer.str(), true, 0);
+      exit(ERROR_THREAD_CREATION);
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	~WorkerPool
+// Description:		Stops and joins all of the workers
+//
+///////////////////////////////////////////////////////////////////
+WorkerPool::~WorkerPool() {
+  pthread_mutex_lock(&mutex);
+  shutdown = true;
+  pthread_cond_broadcast(&start);
+  pthread_mutex_unlock(&mutex);
+
+  for (size_t t = 0; t < workers.size(); ++t) pthread_join(workers[t], nullptr);
+
+  pthread_cond_destroy(&done);
+  pthread_cond_destroy(&start);
+  pthread_mutex_destroy(&mutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	run
+// Description:		Calls the task for every index from 0 to count
+//					and returns once all of them have completed.
+//
+///////////////////////////////////////////////////////////////////
+void WorkerPool::run(size_t c, Task t, void *a) {
+  if (workers.empty() == true || c < 2) {
+    for (size_t i = 0; i < c; ++i) t(i, a);
+
+    return;
+  }
+
+  pthread_mutex_lock(&mutex);
+  task = t;
+  arg = a;
+  count = c;
+  pending = workers.size();
+  ++generation;
+  pthread_cond_broadcast(&start);
+  pthread_mutex_unlock(&mutex);
+
+  runShare(0);
+
+  pthread_mutex_lock(&mutex);
+  while (pending > 0) pthread_cond_wait(&done, &mutex);
+  pthread_mutex_unlock(&mutex);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	runShare
+// Description:		Calls the task for the indices that belong to
+//					the given worker. The indices are interleaved
+//					so that the expensive iterations, which tend
+//					to be next to each other, are spread out.
+//
+///////////////////////////////////////////////////////////////////
+void WorkerPool::runShare(size_t id) {
+  size_t stride = getNumberOfWorkers();
+
+  for (size_t i = id; i < count; i += stride) task(i, arg);
+}
+
+///////////////////////////////////////////////////////////////////
+//
+// Function Name:	workerMain
+// Description:		Waits for work to be handed out and does its
+//					share of it until the pool is shut down.
+//
+///////////////////////////////////////////////////////////////////
+void *WorkerPool::workerMain(void *p) {
+  WorkerArgs *args = static_cast<WorkerArgs *>(p);
+  WorkerPool *pool = args->pool;
+
+  size_t seen = 0;
+
+  while (true) {
+    pthread_mutex_lock(&pool->mutex);
+
+    while (pool->generation == seen && pool->shutdown == false)
+      pthread_cond_wait(&pool->start, &pool->mutex);
+
+    if (pool->shutdown == true) {
+      pthread_mutex_unlock(&pool->mutex);
+      break;
+    }
+
+    bool first = (seen == 0);
+
+    seen = pool->generation;
+    pthread_mutex_unlock(&pool->mutex);
+
+    // The pool of thread zero is started before the affinity is enabled, so
+    // the workers are pinned the first time they are handed work.
+    if (first == true) affinity.pin(pool->firstSlot + args->id);
+
+    pool->runShare(args->id);
+
+    pthread_mutex_lock(&pool->mutex);
+    if (--pool->pending == 0) pthread_cond_signal(&pool->done);
+    pthread_mutex_unlock(&pool->mutex);
+  }
+
+  return nullptr;
+}
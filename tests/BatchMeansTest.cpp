@@ -0,0 +1,109 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      BatchMeansTest.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    Checks when the BatchMeans decides that a run has
+//					converged, including a blocking with a mean of zero.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Convergence tests of the batch means.
+//
+// ____________________________________________________________________________
+
+#include "BatchMeans.h"
+#include "CpuAffinity.h"
+#include "JobScheduler.h"
+#include "Thread.h"
+
+#include <cstddef>
+#include <iostream>
+
+// The simulator keeps these in Main.cpp.
+Thread *threadZero = nullptr;
+Thread **threads = nullptr;
+
+JobScheduler scheduler;
+
+CpuAffinity affinity;
+
+namespace {
+
+const size_t BATCH_SIZE = 1000;
+const size_t MIN_BATCHES = 10;
+const double PRECISION = 0.05;
+
+int failures = 0;
+
+void check(bool condition, const char *message) {
+  if (condition == false) {
+    std::cerr << "FAILED: " << message << std::endl;
+    ++failures;
+  }
+}
+
+// Adds one batch of requests with the given number of blocked requests and
+// average Q-factor, and returns what the monitor decided.
+bool addBatch(BatchMeans &monitor, GlobalStats &stats, size_t blocked,
+              double q) {
+  stats.ConnectionRequests += BATCH_SIZE;
+  stats.ConnectionSuccesses += BATCH_SIZE - blocked;
+  stats.NoPathFailures += blocked;
+  stats.qFactorTotal += q * double(BATCH_SIZE - blocked);
+
+  return monitor.update(stats);
+}
+
+// Returns the batch at which the monitor converged, or zero if it did not
+// converge within the given number of batches. Every period-th batch has a
+// single blocked request, the others have the given number.
+size_t runUntilConverged(double absolutePrecision, size_t batches,
+                         size_t blocked, size_t period) {
+  BatchMeans monitor(BATCH_SIZE, MIN_BATCHES, PRECISION, absolutePrecision);
+
+  GlobalStats stats = GlobalStats();
+  monitor.reset(stats);
+
+  for (size_t b = 1; b <= batches; ++b) {
+    size_t n = (period > 0 && b % period == 0) ? 1 : blocked;
+    double q = (b % 2 == 0) ? 7.9 : 8.1;
+
+    if (addBatch(monitor, stats, n, q) == true) return b;
+  }
+
+  return 0;
+}
+
+}  // namespace
+
+int main() {
+  // No blocking at all: the blocking has a mean and a half width of zero and
+  // converges as soon as the minimum number of batches is reached.
+  check(runUntilConverged(0.001, 100, 0, 0) == MIN_BATCHES,
+        "a blocking of zero converges after the minimum batches");
+
+  // A blocking that is almost zero needs the absolute floor, its relative
+  // precision is out of reach in any run of a sensible length.
+  check(runUntilConverged(0.001, 100, 0, 3) != 0,
+        "a blocking near zero converges with the absolute floor");
+  check(runUntilConverged(0.0, 100, 0, 3) == 0,
+        "a blocking near zero does not converge on relative precision");
+
+  // The floor does not stop a noisy blocking well away from zero from being
+  // checked against its relative precision.
+  check(runUntilConverged(0.001, MIN_BATCHES, 200, 2) == 0,
+        "a noisy blocking does not converge early");
+
+  // A steady blocking away from zero converges on its relative precision.
+  check(runUntilConverged(0.0, 100, 100, 0) == MIN_BATCHES,
+        "a steady blocking converges on relative precision");
+
+  if (failures == 0) std::cout << "All BatchMeans tests passed." << std::endl;
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#!/bin/bash
+# ____________________________________________________________________________
+#
+#  General Information:
+#
+#  File Name:      CheckpointTest.sh
+#  Author:         raptor contributors
+#  Project:        raptor
+#
+#  Description:    Runs two LORA configurations on one thread while saving
+#					checkpoints, runs them again from their checkpoints
+#					and checks that the restored runs end with the
+#					results of the uninterrupted ones.
+#
+#  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#  Revision History:
+#
+#  10/18/2026  v2.1    Restored LORA runs against the uninterrupted ones.
+#
+# ____________________________________________________________________________
+#
+# Usage: CheckpointTest.sh <raptor> <source directory> <work directory>
+
+RAPTOR=$1
+SOURCE=$2
+WORK=$3
+
+CONFIGURATIONS=2
+
+rm -rf "$WORK"
+mkdir -p "$WORK/output"
+cp -r "$SOURCE/input" "$WORK/input"
+cd "$WORK" || exit 1
+
+# Both runs use the same thread, so the second one is restored after the
+# first has cached its LORA paths.
+cat > input/Algorithm.txt <<EOF
+RA=LORA,WA=FF,PS=SINGLE,QA=1,RUN=1
+RA=LORA,WA=FF,PS=PARALLEL,QA=1,RUN=1
+EOF
+
+# The usage is updated rarely, so that a restored run routes many requests
+# before its first update.
+quality() {
+  echo "checkpoint_interval=20000 checkpoint every 20000 seconds"
+  echo "checkpoint_restore=$1 restore from the checkpoints"
+  sed -e 's/^arrival_interval=[0-9]*/arrival_interval=2500/' \
+    -e 's/^usage_update_interval=[0-9]*/usage_update_interval=5000/' \
+    "$SOURCE/input/Quality-NSF-21.txt"
+}
+
+# The results of each run, without the run times and the event pool counts,
+# which start again from zero when a checkpoint is restored.
+results() {
+  awk '/\*\*ALGORITHM/,/\*\*\*\*\*\*\*\*\*\*/' "$1" | cut -c10- |
+    grep -vE "RA RUN TIME|EVENT POOL"
+}
+
+FAILED=0
+
+fail() {
+  echo "FAILED: $1"
+  FAILED=1
+}
+
+quality 0 > input/Quality-NSF-21.txt
+"$RAPTOR" NSF 21 12345 1 1 2 > uninterrupted.txt 2>&1 ||
+  fail "the uninterrupted runs exited with $?"
+
+quality 1 > input/Quality-NSF-21.txt
+"$RAPTOR" NSF 21 12345 1 1 2 > restored.txt 2>&1 ||
+  fail "the restored runs exited with $?"
+
+RESTORED=$(grep -c "RESTORED CHECKPOINT" restored.txt)
+[ "$RESTORED" -eq $CONFIGURATIONS ] ||
+  fail "$RESTORED runs were restored, expected $CONFIGURATIONS"
+
+RUNS=$(results uninterrupted.txt | grep -c "\*\*ALGORITHM")
+[ "$RUNS" -eq $CONFIGURATIONS ] ||
+  fail "$RUNS runs have results, expected $CONFIGURATIONS"
+
+if ! diff <(results uninterrupted.txt) <(results restored.txt); then
+  fail "the restored runs differ from the uninterrupted ones"
+fi
+
+if [ $FAILED -ne 0 ]; then
+  tail -n 20 uninterrupted.txt restored.txt
+  exit 1
+fi
+
+echo "The $CONFIGURATIONS restored runs match the uninterrupted ones."
+exit 0
@@ -0,0 +1,158 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      CpuAffinityTest.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    Checks the parsing of the cpulists of sysfs and the
+//					order in which the slots are given the cores of
+//					the NUMA nodes, and that a pinned thread can be
+//					given all of the cores of the process back.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Tests of the NUMA node grouping.
+//  10/18/2026  v2.1    Cores of the process given back to the main thread.
+//
+// ____________________________________________________________________________
+
+#include "CpuAffinity.h"
+#include "JobScheduler.h"
+#include "Thread.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#define HAVE_STRUCT_TIMESPEC
+#include "pthread.h"
+
+// The simulator keeps these in Main.cpp.
+Thread *threadZero = nullptr;
+Thread **threads = nullptr;
+
+JobScheduler scheduler;
+
+CpuAffinity affinity;
+
+namespace {
+
+int failures = 0;
+
+std::string toString(const std::vector<int> &cpus) {
+  std::string s;
+
+  for (size_t c = 0; c < cpus.size(); ++c)
+    s += (c == 0 ? "" : " ") + std::to_string(cpus[c]);
+
+  return s;
+}
+
+void checkCpus(const std::vector<int> &actual, const std::string &expected,
+               const char *message) {
+  if (toString(actual) != expected) {
+    std::cerr << "FAILED: " << message << ": expected [" << expected
+              << "], got [" << toString(actual) << "]" << std::endl;
+    ++failures;
+  }
+}
+
+std::vector<int> range(int first, int last) {
+  std::vector<int> cpus;
+
+  for (int c = first; c <= last; ++c) cpus.push_back(c);
+
+  return cpus;
+}
+
+#ifdef __linux__
+std::vector<int> currentCpus() {
+  std::vector<int> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int c = 0; c < CPU_SETSIZE; ++c)
+      if (CPU_ISSET(c, &set)) cpus.push_back(c);
+  }
+
+  return cpus;
+}
+#endif
+
+}  // namespace
+
+int main() {
+  checkCpus(CpuAffinity::parseCpuList("0"), "0", "a single core");
+  checkCpus(CpuAffinity::parseCpuList("0-3,8-11\n"), "0 1 2 3 8 9 10 11",
+            "ranges of cores");
+  checkCpus(CpuAffinity::parseCpuList("1,3,5-6"), "1 3 5 6",
+            "cores and ranges");
+  checkCpus(CpuAffinity::parseCpuList(""), "", "a node without cores");
+
+  // Two nodes whose cores are interleaved in blocks of four, as on hosts
+  // with hyper-threading where the siblings are numbered after the cores.
+  std::vector<std::vector<int> > nodes;
+  nodes.push_back(CpuAffinity::parseCpuList("0-3,8-11"));
+  nodes.push_back(CpuAffinity::parseCpuList("4-7,12-15"));
+
+  checkCpus(CpuAffinity::orderCpus(range(0, 15), nodes, 0),
+            "0 1 2 3 8 9 10 11 4 5 6 7 12 13 14 15",
+            "the first node is filled before the second");
+  checkCpus(CpuAffinity::orderCpus(range(0, 15), nodes, 5),
+            "5 6 7 12 13 14 15 4 0 1 2 3 8 9 10 11",
+            "the node of the current core comes first");
+
+  // Only the allowed cores are used, and the ones that sysfs does not list
+  // on any node come last.
+  std::vector<int> allowed = CpuAffinity::parseCpuList("2-5,9,16");
+
+  checkCpus(CpuAffinity::orderCpus(allowed, nodes, 9), "9 2 3 4 5 16",
+            "only the allowed cores are used");
+
+  // Without the nodes of sysfs the cores are used in order from the current
+  // one, as they were before the nodes were read.
+  checkCpus(CpuAffinity::orderCpus(range(0, 7),
+                                   std::vector<std::vector<int> >(), 3),
+            "3 4 5 6 7 0 1 2", "no nodes");
+
+#ifdef __linux__
+  // The main thread is pinned as thread zero of each scenario of a sweep, and
+  // must be given all of the cores of the process back before the next one.
+  std::vector<int> process = currentCpus();
+
+  if (process.empty() == false) {
+    cpu_set_t single;
+    CPU_ZERO(&single);
+    CPU_SET(process.back(), &single);
+    pthread_setaffinity_np(pthread_self(), sizeof(single), &single);
+
+    checkCpus(currentCpus(), std::to_string(process.back()),
+              "the main thread is pinned");
+
+    affinity.unpin();
+
+    checkCpus(currentCpus(), toString(process),
+              "the main thread runs on the cores of the process again");
+  }
+#endif
+
+  affinity.disable();
+
+  if (affinity.isEnabled() == true) {
+    std::cerr << "FAILED: the threads are still pinned once disabled"
+              << std::endl;
+    ++failures;
+  }
+
+  if (failures == 0) std::cout << "All CpuAffinity tests passed." << std::endl;
+
+  return failures == 0 ? 0 : 1;
+}
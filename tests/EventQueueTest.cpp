@@ -0,0 +1,242 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      EventQueueTest.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    Runs the calendar queue and the heap side by side and
+//					checks that they hand back the events in the same
+//					order, for ties, events at infinity, resizes of
+//					the calendar and peeks followed by pops.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Calendar queue order against the heap.
+//
+// ____________________________________________________________________________
+
+#include "CalendarQueue.h"
+#include "CpuAffinity.h"
+#include "EventQueue.h"
+#include "JobScheduler.h"
+#include "Thread.h"
+
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <limits>
+
+// The simulator keeps these in Main.cpp.
+Thread *threadZero = nullptr;
+Thread **threads = nullptr;
+
+JobScheduler scheduler;
+
+CpuAffinity affinity;
+
+namespace {
+
+int failures = 0;
+
+void fail(const char *test, size_t step, const char *message) {
+  // Only the first few are shown, one wrong event shifts all of the others.
+  if (failures++ < 10)
+    std::cerr << "FAILED: " << test << ", step " << step << ": " << message
+              << std::endl;
+}
+
+bool sameEvent(const Event &e1, const Event &e2) {
+  return e1.e_time == e2.e_time && e1.e_type == e2.e_type &&
+         e1.e_key == e2.e_key && e1.e_data.request == e2.e_data.request;
+}
+
+// Both queues are given the same events, whose payloads are kept here so that
+// every event of a type with a payload has a key of its own.
+class SideBySide {
+ public:
+  explicit SideBySide(const char *t) : test(t), steps(0), sessions(0) {}
+
+  void add(double time, EventType type) {
+    Event e;
+    e.e_time = time;
+    e.e_type = type;
+    e.e_data.request = nullptr;
+
+    switch (type) {
+      case CONNECTION_REQUEST:
+        requests.push_back(ConnectionRequestEvent());
+        requests.back().session = sessions++;
+        e.e_data.request = &requests.back();
+        break;
+      case CREATE_CONNECTION_PROBE:
+        probes.push_back(CreateConnectionProbeEvent());
+        // A few probes of each session, told apart by their sequence.
+        probes.back().session = sessions / 4;
+        probes.back().sequence = static_cast<long long int>(sessions++ % 4);
+        e.e_data.probe = &probes.back();
+        break;
+      case DESTROY_CONNECTION_PROBE:
+        destroys.push_back(DestroyConnectionProbeEvent());
+        destroys.back().session = sessions++;
+        e.e_data.destroy = &destroys.back();
+        break;
+      default:
+        break;
+    }
+
+    heap.addEvent(e);
+    calendar.addEvent(e);
+  }
+
+  void addRandom(double time) {
+    static const EventType types[] = {
+        UPDATE_USAGE, CONNECTION_REQUEST, CREATE_CONNECTION_PROBE,
+        DESTROY_CONNECTION_PROBE};
+
+    add(time, types[rand() % 4]);
+  }
+
+  void peek() {
+    ++steps;
+
+    if (checkSize() == false) return;
+
+    if (sameEvent(heap.peekNextEvent(), calendar.peekNextEvent()) == false)
+      fail(test, steps, "the peeked events differ");
+  }
+
+  Event pop() {
+    ++steps;
+
+    if (checkSize() == false) return Event();
+
+    Event h = heap.getNextEvent();
+    Event c = calendar.getNextEvent();
+
+    if (sameEvent(h, c) == false) fail(test, steps, "the events differ");
+
+    return h;
+  }
+
+  void drain() {
+    while (heap.getSize() > 0) pop();
+
+    if (calendar.getSize() != 0) fail(test, steps, "the calendar has events");
+  }
+
+  size_t size() const { return heap.getSize(); }
+
+ private:
+  bool checkSize() {
+    if (heap.getSize() != calendar.getSize()) {
+      fail(test, steps, "the sizes differ");
+      return false;
+    }
+
+    return heap.getSize() > 0;
+  }
+
+  const char *test;
+  size_t steps;
+  size_t sessions;
+
+  HeapEventQueue heap;
+  CalendarEventQueue calendar;
+
+  std::deque<ConnectionRequestEvent> requests;
+  std::deque<CreateConnectionProbeEvent> probes;
+  std::deque<DestroyConnectionProbeEvent> destroys;
+};
+
+// Many events on a few times, so that the order is decided by the type and
+// the key of the events.
+void testTies() {
+  SideBySide queues("ties");
+
+  for (size_t e = 0; e < 2000; ++e) queues.addRandom(0.25 * (rand() % 4));
+
+  queues.drain();
+}
+
+// The deactivate event and any other event at infinity are kept out of the
+// calendar, and must still come last and in order.
+void testInfinity() {
+  SideBySide queues("infinity");
+  double infinity = std::numeric_limits<double>::infinity();
+
+  queues.add(infinity, DEACTIVATE_WORKSTATIONS);
+
+  for (size_t e = 0; e < 200; ++e) {
+    queues.addRandom(e % 3 == 0 ? infinity : double(rand() % 50));
+
+    if (e % 7 == 0) queues.pop();
+  }
+
+  queues.drain();
+}
+
+// The calendar doubles while the queue fills up and halves while it empties,
+// with the events held around the time of the last one removed.
+void testResize() {
+  SideBySide queues("resize");
+  double now = 0.0;
+
+  for (size_t round = 0; round < 3; ++round) {
+    while (queues.size() < 5000) {
+      queues.addRandom(now + 0.01 * (rand() % 1000));
+
+      if (rand() % 4 == 0) now = queues.pop().e_time;
+    }
+
+    while (queues.size() > 10) {
+      now = queues.pop().e_time;
+
+      if (rand() % 4 == 0) queues.addRandom(now + 0.01 * (rand() % 1000));
+    }
+  }
+
+  queues.drain();
+}
+
+// The calendar keeps the bucket of the next event between a peek and the pop
+// that follows it, so the events added in between may come before it.
+void testPeek() {
+  SideBySide queues("peek");
+  double now = 0.0;
+
+  for (size_t e = 0; e < 100; ++e) queues.addRandom(0.1 * (rand() % 100));
+
+  for (size_t step = 0; step < 20000; ++step) {
+    queues.peek();
+
+    // Earlier than, equal to or later than the peeked event.
+    if (rand() % 2 == 0) queues.addRandom(now + 0.1 * (rand() % 100));
+
+    if (queues.size() > 0 && rand() % 3 != 0) {
+      queues.peek();
+      now = queues.pop().e_time;
+    } else {
+      queues.addRandom(now);
+    }
+  }
+
+  queues.drain();
+}
+
+}  // namespace
+
+int main() {
+  srand(2468);
+
+  testTies();
+  testInfinity();
+  testResize();
+  testPeek();
+
+  if (failures == 0) std::cout << "All EventQueue tests passed." << std::endl;
+
+  return failures == 0 ? 0 : 1;
+}
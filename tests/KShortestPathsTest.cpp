@@ -0,0 +1,152 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      KShortestPathsTest.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    Compares the k shortest paths found with the masks of
+//					removed edges with the ones found on copies of
+//					the graph, on random graphs, and checks what
+//					is returned for a target that cannot be reached.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Random graphs against the graph copies of Yen.
+//
+// ____________________________________________________________________________
+
+#include "DirectedGraph.h"
+#include "KShortestPaths.h"
+#include "ReferencePaths.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+extern "C" void calc_k_shortest_paths(const kShortestPathParms &params,
+                                      kShortestPathReturn *retVal);
+
+namespace {
+
+const size_t GRAPHS = 3000;
+const size_t MAX_K = 12;
+
+int failures = 0;
+
+void fail(size_t graph, const char *message) {
+  // Only the first few are shown, one broken tie shows up on many graphs.
+  if (failures++ < 10)
+    std::cerr << "FAILED: graph " << graph << ": " << message << std::endl;
+}
+
+bool samePaths(const std::vector<DirectedPath *> &actual,
+               const std::vector<DirectedPath *> &expected) {
+  if (actual.size() != expected.size()) return false;
+
+  for (size_t p = 0; p < actual.size(); ++p) {
+    if (actual[p]->GetCost() != expected[p]->GetCost() ||
+        actual[p]->GetVertexList() != expected[p]->GetVertexList())
+      return false;
+  }
+
+  return true;
+}
+
+// A target that cannot be reached has no paths, for a new search and for
+// one that is continued, and the library returns every path as missing.
+void checkUnreachable(std::vector<kShortestPathEdges> &edges, size_t vertices,
+                      size_t source, size_t target, size_t k, size_t graph) {
+  kShortestPathParms params =
+      reference::makeParms(edges, vertices, source, target, k);
+
+  KShortestPaths search(params);
+
+  if (search.GetTopKShortestPaths().empty() == false)
+    fail(graph, "a path to a target that cannot be reached");
+
+  if (search.GetTopKShortestPaths(k + 1).empty() == false)
+    fail(graph, "a continued path to a target that cannot be reached");
+
+  kShortestPathReturn paths;
+  std::vector<size_t> pathinfo(k * (vertices - 1));
+  std::vector<double> pathcost(k);
+  std::vector<size_t> pathlen(k);
+
+  paths.pathinfo = pathinfo.empty() ? nullptr : &pathinfo[0];
+  paths.pathcost = &pathcost[0];
+  paths.pathlen = &pathlen[0];
+
+  calc_k_shortest_paths(params, &paths);
+
+  // The lengths are set to the infinity of size_t, which is zero.
+  for (size_t p = 0; p < k; ++p) {
+    if (pathcost[p] != std::numeric_limits<double>::infinity() ||
+        pathlen[p] != 0)
+      fail(graph, "a returned path to a target that cannot be reached");
+  }
+}
+
+}  // namespace
+
+int main() {
+  size_t compared = 0;
+  size_t unreachable = 0;
+
+  srand(54321);
+
+  for (size_t g = 0; g < GRAPHS; ++g) {
+    size_t vertices = 2 + rand() % 11;
+    std::vector<kShortestPathEdges> edges =
+        reference::randomEdges(vertices, vertices + rand() % (3 * vertices));
+
+    size_t source = rand() % vertices;
+    size_t target = (source + 1 + rand() % (vertices - 1)) % vertices;
+    size_t k = 2 + rand() % (MAX_K - 1);
+
+    kShortestPathParms params =
+        reference::makeParms(edges, vertices, source, target, k);
+    DirectedGraph graph(params);
+
+    reference::ShortestPathTree tree(graph, source);
+
+    if (tree.distance[target] == DirectedGraph::DISCONNECT) {
+      checkUnreachable(edges, vertices, source, target, k, g);
+      ++unreachable;
+      continue;
+    }
+
+    reference::KShortestPaths expected(graph, source, target, k);
+
+    KShortestPaths search(params);
+
+    if (samePaths(search.GetTopKShortestPaths(),
+                  expected.GetTopKShortestPaths()) == false)
+      fail(g, "the paths differ from the ones on copies of the graph");
+
+    // A search that is continued from a smaller k finds the same paths.
+    KShortestPaths continued(params);
+
+    continued.GetTopKShortestPaths(1 + rand() % (k - 1));
+
+    if (samePaths(continued.GetTopKShortestPaths(k),
+                  expected.GetTopKShortestPaths()) == false)
+      fail(g, "the paths of a continued search differ");
+
+    ++compared;
+  }
+
+  // The pairs of a network without edges cannot be reached.
+  std::vector<kShortestPathEdges> none;
+  checkUnreachable(none, 4, 0, 3, 3, GRAPHS);
+
+  if (failures == 0)
+    std::cout << "All KShortestPaths tests passed on " << compared
+              << " graphs, with " << unreachable << " unreachable targets."
+              << std::endl;
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,376 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      ReferencePaths.h
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    The shortest path searches of the kshortestpath library
+//					as they were before the graph was kept in
+//					compressed sparse rows and the removed edges
+//					were kept in a mask, for the tests to compare
+//					the library with. They need Boost.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Dijkstra of the Boost Graph Library.
+//  10/18/2026  v2.1    Yen on copies of the graph.
+//
+// ____________________________________________________________________________
+
+#ifndef REFERENCE_PATHS_H
+#define REFERENCE_PATHS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+
+#include "DirectedGraph.h"
+#include "DirectedPath.h"
+#include "KShortestPathStructs.h"
+
+namespace reference {
+
+typedef boost::adjacency_list<boost::listS, boost::vecS, boost::directedS,
+                              boost::no_property,
+                              boost::property<boost::edge_weight_t, double> >
+    BoostGraph;
+typedef boost::graph_traits<BoostGraph>::edge_descriptor BoostEdge;
+typedef boost::graph_traits<BoostGraph>::vertex_descriptor BoostVertex;
+
+// The shortest path tree of a DirectedGraph, found the way ShortestPath found
+// it with Boost: the edges are added in order of their source and target and
+// searched with dijkstra_shortest_paths.
+class ShortestPathTree {
+ public:
+  ShortestPathTree(const DirectedGraph& graph, size_t source)
+      : distance(graph.GetNumberOfVertices()),
+        predecessor(graph.GetNumberOfVertices()) {
+    size_t vertices = graph.GetNumberOfVertices();
+
+    BoostGraph g(vertices);
+    boost::property_map<BoostGraph, boost::edge_weight_t>::type weightmap =
+        get(boost::edge_weight, g);
+
+    for (size_t i = 0; i < vertices; ++i) {
+      for (size_t j = 0; j < vertices; ++j) {
+        if (graph.GetWeight(i, j) != DirectedGraph::DISCONNECT) {
+          BoostEdge e;
+          bool inserted;
+          boost::tie(e, inserted) = add_edge(i, j, g);
+          weightmap[e] = graph.GetWeight(i, j);
+        }
+      }
+    }
+
+    std::vector<BoostVertex> vertexResults(vertices);
+
+    boost::property_map<BoostGraph, boost::vertex_index_t>::type indexmap =
+        get(boost::vertex_index, g);
+    dijkstra_shortest_paths(g, vertex(source, g), &vertexResults[0],
+                            &distance[0], weightmap, indexmap,
+                            std::less<double>(), boost::closed_plus<double>(),
+                            DirectedGraph::DISCONNECT, 0,
+                            boost::default_dijkstra_visitor());
+
+    for (size_t v = 0; v < vertices; ++v) predecessor[v] = vertexResults[v];
+  }
+
+  std::vector<double> distance;
+  std::vector<size_t> predecessor;
+};
+
+// The k shortest paths the way KShortestPaths found them before the edges
+// were masked: each deviation removes the edges from a copy of the graph,
+// reverses the copy and searches it again. There are no paths when the
+// target cannot be reached, the original went on with an empty path.
+class KShortestPaths {
+ public:
+  KShortestPaths(const DirectedGraph& graph, size_t source, size_t target,
+                 size_t k)
+      : m_rGraph(graph),
+        m_nSourceNodeId(source),
+        m_nTargetNodeId(target),
+        m_nTopK(k),
+        m_pIntermediateGraph(nullptr),
+        m_pTree(nullptr) {
+    _Search();
+  }
+
+  ~KShortestPaths() {
+    for (size_t p = 0; p < m_vTopKShortestPaths.size(); ++p)
+      delete m_vTopKShortestPaths[p];
+
+    for (std::set<DirectedPath*, DirectedPath::Comparator>::iterator pos =
+             m_candidatePathsSet.begin();
+         pos != m_candidatePathsSet.end(); ++pos)
+      delete *pos;
+
+    delete m_pTree;
+  }
+
+  const std::vector<DirectedPath*>& GetTopKShortestPaths() const {
+    return m_vTopKShortestPaths;
+  }
+
+ private:
+  void _Search() {
+    m_pTree = new ShortestPathTree(m_rGraph, m_nSourceNodeId);
+
+    if (m_pTree->distance[m_nTargetNodeId] == DirectedGraph::DISCONNECT)
+      return;
+
+    std::list<size_t> tmp_list;
+    tmp_list.push_front(m_nTargetNodeId);
+
+    for (size_t cur_vertex = m_nTargetNodeId;;) {
+      if (m_pTree->predecessor[cur_vertex] == m_nSourceNodeId) {
+        if (cur_vertex != m_nSourceNodeId) tmp_list.push_front(m_nSourceNodeId);
+        break;
+      }
+
+      cur_vertex = m_pTree->predecessor[cur_vertex];
+      tmp_list.push_front(cur_vertex);
+    }
+
+    m_candidatePathsSet.insert(new DirectedPath(
+        0, m_pTree->distance[m_nTargetNodeId],
+        std::vector<size_t>(tmp_list.begin(), tmp_list.end())));
+    m_pathDeviatedNodeMap[0] = m_nSourceNodeId;
+
+    while (m_candidatePathsSet.empty() == false &&
+           m_vTopKShortestPaths.size() < m_nTopK) {
+      DirectedPath* cur_path = *m_candidatePathsSet.begin();
+      m_candidatePathsSet.erase(m_candidatePathsSet.begin());
+
+      m_vTopKShortestPaths.push_back(cur_path);
+
+      if (m_vTopKShortestPaths.size() == m_nTopK) break;
+
+      size_t deviated_node_id = m_pathDeviatedNodeMap[cur_path->GetId()];
+      std::vector<size_t> node_list_in_path = cur_path->GetVertexList();
+
+      m_pIntermediateGraph = new DirectedGraph(m_rGraph);
+
+      _DetermineCost2Target(node_list_in_path);
+
+      size_t i = node_list_in_path.size() - 2;
+
+      for (; node_list_in_path[i] != deviated_node_id; --i)
+        _RestoreEdges(node_list_in_path, node_list_in_path[i],
+                      node_list_in_path[i + 1], false);
+
+      _RestoreEdges(node_list_in_path, deviated_node_id,
+                    node_list_in_path[i + 1], true);
+
+      delete m_pIntermediateGraph;
+    }
+  }
+
+  void _DetermineCost2Target(const std::vector<size_t>& vertices_list) {
+    size_t vertices = m_pIntermediateGraph->GetNumberOfVertices();
+
+    for (size_t i = 0; i + 1 < vertices_list.size(); ++i)
+      for (size_t j = 0; j < vertices; ++j)
+        if (m_pIntermediateGraph->GetWeight(vertices_list[i], j) <
+            DirectedGraph::DISCONNECT)
+          m_pIntermediateGraph->SetWeight(vertices_list[i], j,
+                                          DirectedGraph::DISCONNECT);
+
+    _ReverseEdgesInGraph(*m_pIntermediateGraph);
+
+    delete m_pTree;
+    m_pTree = new ShortestPathTree(*m_pIntermediateGraph, m_nTargetNodeId);
+
+    _ReverseEdgesInGraph(*m_pIntermediateGraph);
+  }
+
+  void _RestoreEdges(const std::vector<size_t>& vertices_list,
+                     size_t start_node_id, size_t end_node_id,
+                     bool is_deviated_node) {
+    std::vector<double>& distance = m_pTree->distance;
+    std::vector<size_t>& next = m_pTree->predecessor;
+
+    bool is_updated = false;
+
+    for (size_t i = 0; i < m_rGraph.GetNumberOfVertices(); ++i) {
+      if (i == end_node_id || i == start_node_id) continue;
+
+      double edge_weight = m_rGraph.GetWeight(start_node_id, i);
+
+      if (edge_weight < DirectedGraph::DISCONNECT) {
+        if (is_deviated_node && _EdgeHasBeenUsed(start_node_id, i)) continue;
+
+        m_pIntermediateGraph->SetWeight(start_node_id, i, edge_weight);
+
+        if (distance[i] < DirectedGraph::DISCONNECT &&
+            edge_weight + distance[i] < distance[start_node_id]) {
+          distance[start_node_id] = edge_weight + distance[i];
+          next[start_node_id] = i;
+          is_updated = true;
+        }
+      }
+    }
+
+    double cost_of_start_node = distance[start_node_id];
+
+    if (cost_of_start_node < DirectedGraph::DISCONNECT) {
+      if (is_updated) _UpdateWeight4CostUntilNode(start_node_id);
+
+      std::vector<size_t> new_path;
+      size_t i;
+
+      for (i = 0; vertices_list[i] != start_node_id; ++i)
+        new_path.push_back(vertices_list[i]);
+
+      size_t next_node_id = start_node_id;
+
+      do {
+        new_path.push_back(next_node_id);
+        next_node_id = next[next_node_id];
+      } while (next_node_id != m_nTargetNodeId);
+
+      new_path.push_back(m_nTargetNodeId);
+
+      double cost_new_path = 0;
+
+      for (i = 0; i + 1 < new_path.size(); ++i)
+        cost_new_path += m_rGraph.GetWeight(new_path[i], new_path[i + 1]);
+
+      size_t new_node_id =
+          m_candidatePathsSet.size() + m_vTopKShortestPaths.size();
+      m_candidatePathsSet.insert(
+          new DirectedPath(new_node_id, cost_new_path, new_path));
+      m_pathDeviatedNodeMap[new_node_id] = start_node_id;
+    }
+
+    double edge_weight = m_rGraph.GetWeight(start_node_id, end_node_id);
+    double cost_of_end_node = distance[end_node_id];
+
+    m_pIntermediateGraph->SetWeight(start_node_id, end_node_id, edge_weight);
+
+    if (cost_of_start_node > edge_weight + cost_of_end_node) {
+      distance[start_node_id] = edge_weight + cost_of_end_node;
+      next[start_node_id] = end_node_id;
+
+      _UpdateWeight4CostUntilNode(start_node_id);
+    }
+  }
+
+  void _UpdateWeight4CostUntilNode(size_t node_id) {
+    std::vector<double>& distance = m_pTree->distance;
+    std::vector<size_t>& next = m_pTree->predecessor;
+
+    std::vector<size_t> candidate_node_list(1, node_id);
+    size_t cur_pos = 0;
+
+    do {
+      size_t cur_node_id = candidate_node_list[cur_pos++];
+
+      for (size_t i = 0; i < m_rGraph.GetNumberOfVertices(); ++i) {
+        double edge_weight = m_pIntermediateGraph->GetWeight(i, cur_node_id);
+
+        if (edge_weight < DirectedGraph::DISCONNECT &&
+            distance[i] > distance[cur_node_id] + edge_weight) {
+          distance[i] = distance[cur_node_id] + edge_weight;
+          next[i] = cur_node_id;
+
+          if (std::find(candidate_node_list.begin(), candidate_node_list.end(),
+                        i) == candidate_node_list.end())
+            candidate_node_list.push_back(i);
+        }
+      }
+    } while (cur_pos < candidate_node_list.size());
+  }
+
+  static void _ReverseEdgesInGraph(DirectedGraph& g) {
+    for (size_t i = 0; i < g.GetNumberOfVertices(); ++i) {
+      for (size_t j = 0; j < i; ++j) {
+        if (g.GetWeight(i, j) < DirectedGraph::DISCONNECT ||
+            g.GetWeight(j, i) < DirectedGraph::DISCONNECT) {
+          double dTmp = g.GetWeight(i, j);
+          g.SetWeight(i, j, g.GetWeight(j, i));
+          g.SetWeight(j, i, dTmp);
+        }
+      }
+    }
+  }
+
+  bool _EdgeHasBeenUsed(size_t start_node_id, size_t end_node_id) const {
+    for (size_t p = 0; p < m_vTopKShortestPaths.size(); ++p) {
+      std::vector<size_t> path = m_vTopKShortestPaths[p]->GetVertexList();
+      std::vector<size_t>::iterator loc =
+          std::find(path.begin(), path.end(), start_node_id);
+
+      if (loc != path.end() && ++loc != path.end() && *loc == end_node_id)
+        return true;
+    }
+
+    return false;
+  }
+
+  const DirectedGraph& m_rGraph;
+  size_t m_nSourceNodeId;
+  size_t m_nTargetNodeId;
+  size_t m_nTopK;
+
+  DirectedGraph* m_pIntermediateGraph;
+  ShortestPathTree* m_pTree;
+
+  std::vector<DirectedPath*> m_vTopKShortestPaths;
+  std::set<DirectedPath*, DirectedPath::Comparator> m_candidatePathsSet;
+  std::map<size_t, size_t> m_pathDeviatedNodeMap;
+};
+
+// Random graphs with the kinds of edges that break ties: edges of zero
+// weight, edges that are listed twice with different weights (the first one
+// is used) and loops. Some of the vertices cannot be reached.
+inline std::vector<kShortestPathEdges> randomEdges(size_t vertices,
+                                                   size_t edges) {
+  std::vector<kShortestPathEdges> list;
+
+  for (size_t e = 0; e < edges; ++e) {
+    kShortestPathEdges edge;
+
+    if (list.empty() == false && rand() % 8 == 0) {
+      edge = list[rand() % list.size()];
+    } else {
+      edge.src_node = rand() % vertices;
+      edge.dest_node = rand() % vertices;
+    }
+
+    edge.edge_cost = double(rand() % 4);
+
+    list.push_back(edge);
+  }
+
+  return list;
+}
+
+inline kShortestPathParms makeParms(std::vector<kShortestPathEdges>& edges,
+                                    size_t vertices, size_t source,
+                                    size_t target, size_t k) {
+  kShortestPathParms params;
+
+  params.src_node = source;
+  params.dest_node = target;
+  params.k_paths = k;
+  params.total_nodes = vertices;
+  params.total_edges = edges.size();
+  params.edge_list = edges.empty() ? nullptr : &edges[0];
+
+  return params;
+}
+
+}  // namespace reference
+
+#endif
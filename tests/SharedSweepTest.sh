@@ -0,0 +1,102 @@
+#!/bin/bash
+# ____________________________________________________________________________
+#
+#  General Information:
+#
+#  File Name:      SharedSweepTest.sh
+#  Author:         raptor contributors
+#  Project:        raptor
+#
+#  Description:    Runs two processes on one shared sweep with replications
+#					and checks that every configuration is run by one of
+#					them, with all of its replications and one summary.
+#
+#  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#  Revision History:
+#
+#  10/18/2026  v2.1    Two processes sharing a sweep with replications.
+#
+# ____________________________________________________________________________
+#
+# Usage: SharedSweepTest.sh <raptor> <source directory> <work directory>
+
+RAPTOR=$1
+SOURCE=$2
+WORK=$3
+
+CONFIGURATIONS=3
+REPLICATIONS=3
+
+rm -rf "$WORK"
+mkdir -p "$WORK/output"
+cp -r "$SOURCE/input" "$WORK/input"
+cd "$WORK" || exit 1
+
+cat > input/Algorithm.txt <<EOF
+RA=SP,WA=FF,PS=SINGLE,QA=1,RUN=1
+RA=SP,WA=FF,PS=PARALLEL,QA=1,RUN=1
+RA=SP,WA=FF,PS=SERIAL,QA=1,RUN=1
+EOF
+
+# A half width of zero is never reached, so every configuration runs all of
+# its replications. The requests are made rare to keep the runs short.
+{
+  echo "shared_sweep=1 share the sweep between the processes"
+  echo "min_replications=2 replications started together"
+  echo "max_replications=$REPLICATIONS replications at most"
+  echo "ci_half_width=0 never converge"
+  sed 's/^arrival_interval=[0-9]*/arrival_interval=25000/' \
+    "$SOURCE/input/Quality-NSF-21.txt"
+} > input/Quality-NSF-21.txt
+
+"$RAPTOR" NSF 21 12345 1 1 2 > first.txt 2>&1 &
+FIRST=$!
+"$RAPTOR" NSF 21 12345 1 1 2 > second.txt 2>&1 &
+SECOND=$!
+
+wait $FIRST
+FIRST_RC=$?
+wait $SECOND
+SECOND_RC=$?
+
+FAILED=0
+
+fail() {
+  echo "FAILED: $1"
+  FAILED=1
+}
+
+[ $FIRST_RC -eq 0 ] || fail "the first process exited with $FIRST_RC"
+[ $SECOND_RC -eq 0 ] || fail "the second process exited with $SECOND_RC"
+
+PREFIX=output/Sweep-NSF-21-12345-1-2
+
+CLAIMS=$(ls $PREFIX-Job*.claim 2>/dev/null | wc -l)
+[ "$CLAIMS" -eq $CONFIGURATIONS ] ||
+  fail "$CLAIMS jobs were claimed, expected one for each configuration"
+
+SUMMARY=$PREFIX-Summary.txt
+
+if [ -f $SUMMARY ]; then
+  SETS=$(grep -c "REPLICATIONS SUMMARY" $SUMMARY)
+  [ "$SETS" -eq $CONFIGURATIONS ] ||
+    fail "$SETS replication summaries were merged, expected $CONFIGURATIONS"
+
+  COMPLETE=$(grep -c "REPLICATIONS = $REPLICATIONS," $SUMMARY)
+  [ "$COMPLETE" -eq $CONFIGURATIONS ] ||
+    fail "$COMPLETE sets ran all of their $REPLICATIONS replications"
+
+  RUNS=$(grep -c "\*\*ALGORITHM" $SUMMARY)
+  [ "$RUNS" -eq $((CONFIGURATIONS * REPLICATIONS)) ] ||
+    fail "$RUNS runs were merged, expected $((CONFIGURATIONS * REPLICATIONS))"
+else
+  fail "the results of the sweep were not merged"
+fi
+
+if [ $FAILED -ne 0 ]; then
+  tail -n 20 first.txt second.txt
+  exit 1
+fi
+
+echo "The shared sweep ran $CONFIGURATIONS sets of $REPLICATIONS replications."
+exit 0
@@ -0,0 +1,118 @@
+// ____________________________________________________________________________
+//
+//  General Information:
+//
+//  File Name:      ShortestPathTest.cpp
+//  Author:         raptor contributors
+//  Project:        raptor
+//
+//  Description:    Compares the Dijkstra of the compressed sparse row graph
+//					with the one of the Boost Graph Library that it
+//					replaced, on random graphs.
+//
+//  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Revision History:
+//
+//  10/18/2026  v2.1    Random graphs against the Boost Dijkstra.
+//
+// ____________________________________________________________________________
+
+#include "DirectedGraph.h"
+#include "ReferencePaths.h"
+#include "ShortestPath.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const size_t GRAPHS = 3000;
+
+int failures = 0;
+
+void fail(size_t graph, size_t source, size_t vertex, const char *message) {
+  // Only the first few are shown, one broken tie shows up on many graphs.
+  if (failures++ < 10)
+    std::cerr << "FAILED: graph " << graph << ", source " << source
+              << ", vertex " << vertex << ": " << message << std::endl;
+}
+
+// The tree of the source must have the same distances as the reference, and
+// the same predecessors wherever the ties could have been broken another
+// way. The paths that are copied out follow the predecessors.
+void compare(const ShortestPath &sp, const reference::ShortestPathTree &tree,
+             size_t graph, size_t source) {
+  size_t vertices = tree.distance.size();
+  std::vector<size_t> path(vertices);
+
+  for (size_t v = 0; v < vertices; ++v) {
+    if (sp.GetDistance(v) != tree.distance[v]) {
+      fail(graph, source, v, "the distances differ");
+      continue;
+    }
+
+    size_t length = sp.CopyShortestPath(v, &path[0], vertices);
+
+    if (tree.distance[v] == DirectedGraph::DISCONNECT) {
+      if (length != 0) fail(graph, source, v, "a path to an unreached vertex");
+      continue;
+    }
+
+    if (v != source && sp.GetNextNodeId(v) != tree.predecessor[v])
+      fail(graph, source, v, "the predecessors differ");
+
+    size_t expected = v;
+
+    for (size_t i = length; i-- > 0;) {
+      if (path[i] != expected) {
+        fail(graph, source, v, "the path does not follow the predecessors");
+        break;
+      }
+
+      expected = tree.predecessor[expected];
+    }
+
+    if (length == 0 || path[0] != source)
+      fail(graph, source, v, "the path does not start at the source");
+  }
+}
+
+}  // namespace
+
+int main() {
+  ShortestPath fromEdges;
+
+  srand(12345);
+
+  for (size_t g = 0; g < GRAPHS; ++g) {
+    size_t vertices = 2 + rand() % 14;
+    std::vector<kShortestPathEdges> edges =
+        reference::randomEdges(vertices, rand() % (3 * vertices + 1));
+
+    kShortestPathParms params =
+        reference::makeParms(edges, vertices, 0, vertices - 1, 1);
+    DirectedGraph graph(params);
+
+    // The searcher of the edge list is built again for each graph, as the
+    // simulator does, and the one of the DirectedGraph is new.
+    fromEdges.Build(params);
+    ShortestPath fromGraph(graph);
+
+    for (size_t s = 0; s < vertices; ++s) {
+      reference::ShortestPathTree tree(graph, s);
+
+      fromEdges.ConstructPathTree(s);
+      compare(fromEdges, tree, g, s);
+
+      fromGraph.ConstructPathTree(s);
+      compare(fromGraph, tree, g, s);
+    }
+  }
+
+  if (failures == 0)
+    std::cout << "All ShortestPath tests passed on " << GRAPHS << " graphs."
+              << std::endl;
+
+  return failures == 0 ? 0 : 1;
+}